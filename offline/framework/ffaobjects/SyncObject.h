@@ -59,6 +59,7 @@ protected:
  private:  // prevent doc++ from showing ClassDefOverride
   friend class SyncObjectv1;
   friend class Fun4AllDstInputManager;
+  friend class Fun4AllDstOutputManager;
   friend class Fun4AllDstPileupInputManager;
   friend class DumpSyncObject;
   friend class SegmentSelect;
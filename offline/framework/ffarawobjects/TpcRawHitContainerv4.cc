@@ -0,0 +1,174 @@
+#include "TpcRawHitContainerv4.h"
+
+#include "TpcRawHitv3.h"
+
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <memory>
+
+void TpcRawHitContainerv4::Reset()
+{
+  // keep the capacity, the next event is about the same size
+  m_bco.clear();
+  m_packetid.clear();
+  m_fee.clear();
+  m_channel.clear();
+  m_type.clear();
+  m_errors.clear();
+  m_hit_waveform_end.clear();
+  m_waveform_start_time.clear();
+  m_waveform_adc_end.clear();
+  m_adc.clear();
+}
+
+void TpcRawHitContainerv4::identify(std::ostream &os) const
+{
+  os << "TpcRawHitContainerv4" << std::endl;
+  os << "containing " << m_bco.size() << " Tpc hits, "
+     << m_waveform_start_time.size() << " waveforms, "
+     << m_adc.size() << " adc samples" << std::endl;
+  if (!m_bco.empty())
+  {
+    os << "for beam clock: " << std::hex << m_bco.front() << std::dec << std::endl;
+  }
+}
+
+int TpcRawHitContainerv4::isValid() const
+{
+  return !m_bco.empty();
+}
+
+unsigned int TpcRawHitContainerv4::append_header(TpcRawHit *tpchit)
+{
+  const unsigned int ihit = m_bco.size();
+  m_bco.push_back(tpchit ? tpchit->get_bco() : std::numeric_limits<uint64_t>::max());
+  m_packetid.push_back(tpchit ? tpchit->get_packetid() : std::numeric_limits<int32_t>::max());
+  m_fee.push_back(tpchit ? tpchit->get_fee() : std::numeric_limits<uint16_t>::max());
+  m_channel.push_back(tpchit ? tpchit->get_channel() : std::numeric_limits<uint16_t>::max());
+  m_type.push_back(tpchit ? tpchit->get_type() : std::numeric_limits<uint16_t>::max());
+  m_errors.push_back(0);
+  set_checksumerror(ihit, tpchit ? tpchit->get_checksumerror() : true);
+  set_parityerror(ihit, tpchit ? tpchit->get_parityerror() : true);
+  m_hit_waveform_end.push_back(m_waveform_start_time.size());
+  return ihit;
+}
+
+TpcRawHit *TpcRawHitContainerv4::AddHit()
+{
+  append_header(nullptr);
+  return get_hit(m_bco.size() - 1);
+}
+
+TpcRawHit *TpcRawHitContainerv4::AddHit(TpcRawHit *tpchit)
+{
+  if (!tpchit)
+  {
+    std::cout << __PRETTY_FUNCTION__ << "\t- Error : Invalid hit, doing nothing" << std::endl;
+    assert(tpchit);
+    return nullptr;
+  }
+
+  const unsigned int ihit = append_header(tpchit);
+
+  if (tpchit->IsA() == TpcRawHitv3::Class())
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    for (const auto &[start_time, adc] : static_cast<TpcRawHitv3 *>(tpchit)->get_adc_waveforms())
+    {
+      add_waveform(start_time, adc.data(), adc.size());
+    }
+  }
+  else if (auto *view = dynamic_cast<TpcRawHitView *>(tpchit); view && view->container())
+  {
+    const TpcRawHitContainerv4 *source = view->container();
+    for (size_t iwf = source->waveform_begin(view->index()); iwf < source->waveform_end(view->index()); ++iwf)
+    {
+      const size_t begin = source->adc_begin(iwf);
+      add_waveform(source->get_waveform_start_time(iwf), &source->m_adc[begin], source->adc_end(iwf) - begin);
+    }
+  }
+  else
+  {
+    // generic: split into waveforms at gaps in the time bins
+    for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
+         !adc_iterator->IsDone();
+         adc_iterator->Next())
+    {
+      add_adc(ihit, adc_iterator->CurrentTimeBin(), adc_iterator->CurrentAdc());
+    }
+  }
+
+  return get_hit(ihit);
+}
+
+TpcRawHit *TpcRawHitContainerv4::get_hit(unsigned int index)
+{
+  if (index >= m_bco.size())
+  {
+    return nullptr;
+  }
+  while (m_views.size() <= index)
+  {
+    m_views.emplace_back(this, m_views.size());
+  }
+  TpcRawHitView &view = m_views[index];
+  if (view.container() != this)
+  {
+    // this container was copied, views still point to the original
+    view = TpcRawHitView(this, index);
+  }
+  return &view;
+}
+
+void TpcRawHitContainerv4::CopyFrom(TpcRawHitContainer *source)
+{
+  Reset();
+  const unsigned int nhits = source->get_nhits();
+  m_bco.reserve(nhits);
+  m_packetid.reserve(nhits);
+  m_fee.reserve(nhits);
+  m_channel.reserve(nhits);
+  m_type.reserve(nhits);
+  m_errors.reserve(nhits);
+  m_hit_waveform_end.reserve(nhits);
+  for (unsigned int i = 0; i < nhits; ++i)
+  {
+    AddHit(source->get_hit(i));
+  }
+  setBco(source->getBco());
+  setStatus(source->getStatus());
+}
+
+void TpcRawHitContainerv4::add_waveform(const uint16_t start_time, const uint16_t *adc, const size_t nsamples)
+{
+  m_waveform_start_time.push_back(start_time);
+  m_adc.insert(m_adc.end(), adc, adc + nsamples);
+  m_waveform_adc_end.push_back(m_adc.size());
+  m_hit_waveform_end.back() = m_waveform_start_time.size();
+}
+
+bool TpcRawHitContainerv4::add_adc(const unsigned int ihit, const uint16_t sample, const uint16_t adc)
+{
+  if (ihit + 1 != m_bco.size())
+  {
+    return false;
+  }
+  if (waveform_end(ihit) > waveform_begin(ihit))
+  {
+    const size_t iwf = waveform_end(ihit) - 1;
+    const size_t next_sample = m_waveform_start_time[iwf] + (adc_end(iwf) - adc_begin(iwf));
+    if (sample < next_sample)
+    {
+      return false;
+    }
+    if (sample == next_sample)
+    {
+      m_adc.push_back(adc);
+      ++m_waveform_adc_end.back();
+      return true;
+    }
+  }
+  add_waveform(sample, &adc, 1);
+  return true;
+}
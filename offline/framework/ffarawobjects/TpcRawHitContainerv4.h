@@ -0,0 +1,131 @@
+#ifndef FUN4ALLRAW_TPCHITRAWCONTAINERv4_H
+#define FUN4ALLRAW_TPCHITRAWCONTAINERv4_H
+
+#include "TpcRawHitContainer.h"
+#include "TpcRawHitView.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class TpcRawHit;
+
+//! columnar storage of TPC raw hits
+/**
+ * hit headers are stored in parallel columns, one entry per hit, and the
+ * ADC samples of all waveforms in one concatenated buffer indexed by
+ * cumulative offsets. There is no per hit object to stream.
+ * get_hit() returns a TpcRawHitView pointing back into the columns
+ */
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+class TpcRawHitContainerv4 : public TpcRawHitContainer
+{
+ public:
+  TpcRawHitContainerv4() = default;
+  ~TpcRawHitContainerv4() override = default;
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override;
+
+  //! append an empty hit, the returned view is used to fill it
+  TpcRawHit *AddHit() override;
+  //! append a copy of tpchit, fast for TpcRawHitv3 and TpcRawHitView
+  TpcRawHit *AddHit(TpcRawHit *tpchit) override;
+  unsigned int get_nhits() override { return m_bco.size(); }
+  TpcRawHit *get_hit(unsigned int index) override;
+  void setStatus(const unsigned int i) override { status = i; }
+  unsigned int getStatus() const override { return status; }
+  void setBco(const uint64_t i) override { bco = i; }
+  uint64_t getBco() const override { return bco; }
+
+  //! convert from any other container version, e.g. TpcRawHitContainerv3
+  using PHObject::CopyFrom;
+  virtual void CopyFrom(TpcRawHitContainer *source);
+
+  //!@name column access
+  //@{
+  uint64_t get_bco(const unsigned int ihit) const { return m_bco[ihit]; }
+  int32_t get_packetid(const unsigned int ihit) const { return m_packetid[ihit]; }
+  uint16_t get_fee(const unsigned int ihit) const { return m_fee[ihit]; }
+  uint16_t get_channel(const unsigned int ihit) const { return m_channel[ihit]; }
+  uint16_t get_type(const unsigned int ihit) const { return m_type[ihit]; }
+  bool get_checksumerror(const unsigned int ihit) const { return m_errors[ihit] & kChecksumError; }
+  bool get_parityerror(const unsigned int ihit) const { return m_errors[ihit] & kParityError; }
+
+  //! waveforms of hit ihit are [waveform_begin(ihit), waveform_end(ihit))
+  size_t waveform_begin(const unsigned int ihit) const { return ihit == 0 ? 0 : m_hit_waveform_end[ihit - 1]; }
+  size_t waveform_end(const unsigned int ihit) const { return m_hit_waveform_end[ihit]; }
+
+  uint16_t get_waveform_start_time(const size_t iwf) const { return m_waveform_start_time[iwf]; }
+  //! ADC samples of waveform iwf are [adc_begin(iwf), adc_end(iwf))
+  size_t adc_begin(const size_t iwf) const { return iwf == 0 ? 0 : m_waveform_adc_end[iwf - 1]; }
+  size_t adc_end(const size_t iwf) const { return m_waveform_adc_end[iwf]; }
+  uint16_t get_adc(const size_t iadc) const { return m_adc[iadc]; }
+  //@}
+
+  //!@name column modification, used by TpcRawHitView
+  //@{
+  void set_bco(const unsigned int ihit, const uint64_t val) { m_bco[ihit] = val; }
+  void set_packetid(const unsigned int ihit, const int32_t val) { m_packetid[ihit] = val; }
+  void set_fee(const unsigned int ihit, const uint16_t val) { m_fee[ihit] = val; }
+  void set_channel(const unsigned int ihit, const uint16_t val) { m_channel[ihit] = val; }
+  void set_type(const unsigned int ihit, const uint16_t val) { m_type[ihit] = val; }
+  void set_checksumerror(const unsigned int ihit, const bool b) { set_error(ihit, kChecksumError, b); }
+  void set_parityerror(const unsigned int ihit, const bool b) { set_error(ihit, kParityError, b); }
+
+  //! append a waveform to the last hit
+  void add_waveform(const uint16_t start_time, const uint16_t *adc, const size_t nsamples);
+
+  //! append one ADC sample to the last hit, extending its last waveform if contiguous
+  bool add_adc(const unsigned int ihit, const uint16_t sample, const uint16_t adc);
+  //@}
+
+ private:
+  static constexpr uint8_t kChecksumError = 1U << 0U;
+  static constexpr uint8_t kParityError = 1U << 1U;
+
+  void set_error(const unsigned int ihit, const uint8_t bit, const bool b)
+  {
+    m_errors[ihit] = b ? (m_errors[ihit] | bit) : (m_errors[ihit] & ~bit);
+  }
+
+  unsigned int append_header(TpcRawHit *tpchit);
+
+  //! hit headers
+  std::vector<uint64_t> m_bco;
+  std::vector<int32_t> m_packetid;
+  std::vector<uint16_t> m_fee;
+  std::vector<uint16_t> m_channel;
+  std::vector<uint16_t> m_type;
+  std::vector<uint8_t> m_errors;
+
+  //! cumulative number of waveforms, one entry per hit
+  std::vector<uint32_t> m_hit_waveform_end;
+
+  //! waveforms
+  std::vector<uint16_t> m_waveform_start_time;
+  //! cumulative number of ADC samples, one entry per waveform
+  std::vector<uint32_t> m_waveform_adc_end;
+
+  //! ADC samples of all waveforms
+  std::vector<uint16_t> m_adc;
+
+  uint64_t bco{0};
+  unsigned int status{0};
+
+  //! views handed out by get_hit(), stable addresses
+  std::deque<TpcRawHitView> m_views;  //!
+
+  ClassDefOverride(TpcRawHitContainerv4, 1)
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "TpcRawHitView.h"
+
+#include "TpcRawHitContainerv4.h"
+
+#include <iostream>
+
+void TpcRawHitView::identify(std::ostream &os) const
+{
+  os << "TpcRawHitView of hit " << m_index << std::endl;
+  os << "BCO: 0x" << std::hex << get_bco() << std::dec << std::endl;
+  os << " packet id: " << get_packetid() << std::endl;
+  os << " fee: " << get_fee() << " channel: " << get_channel() << std::endl;
+
+  for (size_t iwf = m_container->waveform_begin(m_index); iwf < m_container->waveform_end(m_index); ++iwf)
+  {
+    os << " start time: " << m_container->get_waveform_start_time(iwf) << " | ADCs: ";
+    for (size_t iadc = m_container->adc_begin(iwf); iadc < m_container->adc_end(iwf); ++iadc)
+    {
+      os << m_container->get_adc(iadc) << " ";
+    }
+    os << std::endl;
+  }
+}
+
+uint64_t TpcRawHitView::get_bco() const
+{
+  return m_container->get_bco(m_index);
+}
+
+void TpcRawHitView::set_bco(const uint64_t val)
+{
+  m_container->set_bco(m_index, val);
+}
+
+int32_t TpcRawHitView::get_packetid() const
+{
+  return m_container->get_packetid(m_index);
+}
+
+void TpcRawHitView::set_packetid(const int32_t val)
+{
+  m_container->set_packetid(m_index, val);
+}
+
+uint16_t TpcRawHitView::get_fee() const
+{
+  return m_container->get_fee(m_index);
+}
+
+void TpcRawHitView::set_fee(const uint16_t val)
+{
+  m_container->set_fee(m_index, val);
+}
+
+uint16_t TpcRawHitView::get_channel() const
+{
+  return m_container->get_channel(m_index);
+}
+
+void TpcRawHitView::set_channel(const uint16_t val)
+{
+  m_container->set_channel(m_index, val);
+}
+
+uint16_t TpcRawHitView::get_adc(const uint16_t sample) const
+{
+  for (size_t iwf = m_container->waveform_begin(m_index); iwf < m_container->waveform_end(m_index); ++iwf)
+  {
+    const uint16_t start_time = m_container->get_waveform_start_time(iwf);
+    const size_t nsamples = m_container->adc_end(iwf) - m_container->adc_begin(iwf);
+    if (sample >= start_time && sample < start_time + nsamples)
+    {
+      return m_container->get_adc(m_container->adc_begin(iwf) + (sample - start_time));
+    }
+  }
+  return 0;
+}
+
+void TpcRawHitView::set_adc(const uint16_t sample, const uint16_t val)
+{
+  if (!m_container->add_adc(m_index, sample, val))
+  {
+    std::cout << __PRETTY_FUNCTION__
+              << " Error: samples can only be added in increasing order to the last hit, ignoring sample "
+              << sample << std::endl;
+  }
+}
+
+uint16_t TpcRawHitView::get_type() const
+{
+  return m_container->get_type(m_index);
+}
+
+void TpcRawHitView::set_type(const uint16_t i)
+{
+  m_container->set_type(m_index, i);
+}
+
+bool TpcRawHitView::get_checksumerror() const
+{
+  return m_container->get_checksumerror(m_index);
+}
+
+void TpcRawHitView::set_checksumerror(const bool b)
+{
+  m_container->set_checksumerror(m_index, b);
+}
+
+bool TpcRawHitView::get_parityerror() const
+{
+  return m_container->get_parityerror(m_index);
+}
+
+void TpcRawHitView::set_parityerror(const bool b)
+{
+  m_container->set_parityerror(m_index, b);
+}
+
+TpcRawHit::AdcIterator *TpcRawHitView::CreateAdcIterator() const
+{
+  return new AdcIteratorView(m_container, m_index);
+}
+
+TpcRawHitView::AdcIteratorView::AdcIteratorView(const TpcRawHitContainerv4 *container, const unsigned int index)
+  : m_container(container)
+  , m_waveform_begin(container->waveform_begin(index))
+  , m_waveform_end(container->waveform_end(index))
+{
+  First();
+}
+
+void TpcRawHitView::AdcIteratorView::First()
+{
+  m_waveform = m_waveform_begin;
+  m_adc = m_waveform < m_waveform_end ? m_container->adc_begin(m_waveform) : 0;
+  skip_empty();
+}
+
+void TpcRawHitView::AdcIteratorView::Next()
+{
+  if (IsDone())
+  {
+    return;
+  }
+  ++m_adc;
+  skip_empty();
+}
+
+void TpcRawHitView::AdcIteratorView::skip_empty()
+{
+  while (m_waveform < m_waveform_end && m_adc >= m_container->adc_end(m_waveform))
+  {
+    ++m_waveform;
+    if (m_waveform < m_waveform_end)
+    {
+      m_adc = m_container->adc_begin(m_waveform);
+    }
+  }
+}
+
+uint16_t TpcRawHitView::AdcIteratorView::CurrentTimeBin() const
+{
+  if (IsDone())
+  {
+    return std::numeric_limits<uint16_t>::max();
+  }
+  return m_container->get_waveform_start_time(m_waveform) + (m_adc - m_container->adc_begin(m_waveform));
+}
+
+uint16_t TpcRawHitView::AdcIteratorView::CurrentAdc() const
+{
+  if (IsDone())
+  {
+    return std::numeric_limits<uint16_t>::max();
+  }
+  return m_container->get_adc(m_adc);
+}
@@ -0,0 +1,98 @@
+#ifndef FUN4ALLRAW_TPCRAWHITVIEW_H
+#define FUN4ALLRAW_TPCRAWHITVIEW_H
+
+#include "TpcRawHit.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+class TpcRawHitContainerv4;
+
+//! TpcRawHit interface to one hit stored in a TpcRawHitContainerv4
+/**
+ * does not own any data, all accessors read and write the container columns
+ */
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+class TpcRawHitView : public TpcRawHit
+{
+ public:
+  TpcRawHitView() = default;
+  TpcRawHitView(TpcRawHitContainerv4 *container, const unsigned int index)
+    : m_container(container)
+    , m_index(index)
+  {
+  }
+  ~TpcRawHitView() override = default;
+
+  void identify(std::ostream &os = std::cout) const override;
+
+  TpcRawHitContainerv4 *container() const { return m_container; }
+  unsigned int index() const { return m_index; }
+
+  uint64_t get_bco() const override;
+  void set_bco(const uint64_t val) override;
+
+  int32_t get_packetid() const override;
+  void set_packetid(const int32_t val) override;
+
+  uint16_t get_fee() const override;
+  void set_fee(const uint16_t val) override;
+
+  uint16_t get_channel() const override;
+  void set_channel(const uint16_t val) override;
+
+  uint16_t get_sampaaddress() const override
+  {
+    return static_cast<uint16_t>(get_channel() >> 5U) & 0xfU;
+  }
+  uint16_t get_sampachannel() const override { return get_channel() & 0x1fU; }
+
+  uint16_t get_samples() const override { return 1024U; }
+
+  //! linear search over the waveforms, prefer the iterator
+  uint16_t get_adc(const uint16_t sample) const override;
+  //! samples have to be added in increasing order, and to the last hit only
+  void set_adc(const uint16_t sample, const uint16_t val) override;
+
+  uint16_t get_type() const override;
+  void set_type(const uint16_t i) override;
+
+  bool get_checksumerror() const override;
+  void set_checksumerror(const bool b) override;
+
+  bool get_parityerror() const override;
+  void set_parityerror(const bool b) override;
+
+  class AdcIteratorView : public AdcIterator
+  {
+   public:
+    AdcIteratorView(const TpcRawHitContainerv4 *container, const unsigned int index);
+
+    void First() override;
+    void Next() override;
+    bool IsDone() const override { return m_waveform >= m_waveform_end; }
+    uint16_t CurrentTimeBin() const override;
+    uint16_t CurrentAdc() const override;
+
+   private:
+    //! skip empty waveforms
+    void skip_empty();
+
+    const TpcRawHitContainerv4 *m_container = nullptr;
+    size_t m_waveform_begin = 0;
+    size_t m_waveform_end = 0;
+    size_t m_waveform = 0;
+    size_t m_adc = 0;
+  };
+
+  AdcIterator *CreateAdcIterator() const override;
+
+ private:
+  TpcRawHitContainerv4 *m_container = nullptr;  //!
+  unsigned int m_index = std::numeric_limits<unsigned int>::max();
+
+  ClassDefOverride(TpcRawHitView, 0)
+};
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <memory>
 
 TpcRawHitv3::TpcRawHitv3(TpcRawHit *tpchit)
 {
@@ -29,13 +30,28 @@ TpcRawHitv3::TpcRawHitv3(TpcRawHit *tpchit)
   TpcRawHitv3::set_parityerror(tpchit->get_parityerror());
   TpcRawHitv3::set_samples(tpchit->get_samples());
 
-  for (size_t i = 0; i < tpchit->get_samples(); ++i)
+  // copy the waveforms, split at gaps in the time bins
+  std::vector<uint16_t> adc;
+  uint16_t start_time = 0;
+  for (std::unique_ptr<AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
+       !adc_iterator->IsDone();
+       adc_iterator->Next())
   {
-    uint16_t adcval = tpchit->get_adc(i);
-    if (adcval > 0)
+    const uint16_t tbin = adc_iterator->CurrentTimeBin();
+    if (!adc.empty() && tbin != start_time + adc.size())
     {
-      TpcRawHitv3::set_adc(i, tpchit->get_adc(i));
+      move_adc_waveform(start_time, std::move(adc));
+      adc.clear();
     }
+    if (adc.empty())
+    {
+      start_time = tbin;
+    }
+    adc.push_back(adc_iterator->CurrentAdc());
+  }
+  if (!adc.empty())
+  {
+    move_adc_waveform(start_time, std::move(adc));
   }
 }
 
@@ -104,18 +120,13 @@ void TpcRawHitv3::Clear(Option_t * /*unused*/)
   checksumerror = true;
   parityerror = true;
 
-  for (auto &waveform : m_adcData)
-  {
-    waveform.second.clear();
-    waveform.second.shrink_to_fit();
-  }
+  // keep the capacity, hits are reused by the TpcTimeFrameBuilder raw hit pool
   m_adcData.clear();
-  m_adcData.shrink_to_fit();
 
   // std::cout << __PRETTY_FUNCTION__ << " - m_adcData.capacity = "<<m_adcData.capacity() << std::endl;
 }
 
 void TpcRawHitv3::move_adc_waveform(const uint16_t start_time, std::vector<uint16_t> &&adc)
 {
-  m_adcData.emplace_back(start_time, adc);
+  m_adcData.emplace_back(start_time, std::move(adc));
 }
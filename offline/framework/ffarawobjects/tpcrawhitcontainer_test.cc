@@ -0,0 +1,214 @@
+// Round trip tests between TpcRawHitContainerv3 and the columnar TpcRawHitContainerv4:
+// hit headers, ADC samples, write/read through the streamer and Reset.
+//
+// usage: tpcrawhitcontainer_test, returns the number of failed checks
+
+#include "TpcRawHitContainerv3.h"
+#include "TpcRawHitContainerv4.h"
+#include "TpcRawHitv3.h"
+
+#include <TBufferFile.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  int nfailed = 0;
+
+  void check(bool condition, const char* what)
+  {
+    if (!condition)
+    {
+      std::cout << "tpcrawhitcontainer_test - FAILED: " << what << std::endl;
+      ++nfailed;
+    }
+  }
+
+  using sample_list = std::vector<std::pair<uint16_t, uint16_t>>;
+
+  // (time bin, adc) of all samples of a hit, read through its iterator
+  sample_list samples(const TpcRawHit* hit)
+  {
+    sample_list list;
+    for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(hit->CreateAdcIterator());
+         !adc_iterator->IsDone();
+         adc_iterator->Next())
+    {
+      list.emplace_back(adc_iterator->CurrentTimeBin(), adc_iterator->CurrentAdc());
+    }
+    return list;
+  }
+
+  bool same_header(const TpcRawHit* first, const TpcRawHit* second)
+  {
+    return first->get_bco() == second->get_bco() &&
+           first->get_packetid() == second->get_packetid() &&
+           first->get_fee() == second->get_fee() &&
+           first->get_channel() == second->get_channel() &&
+           first->get_type() == second->get_type() &&
+           first->get_checksumerror() == second->get_checksumerror() &&
+           first->get_parityerror() == second->get_parityerror();
+  }
+
+  // compare all hits of two containers
+  bool same_hits(TpcRawHitContainer& first, TpcRawHitContainer& second)
+  {
+    if (first.get_nhits() != second.get_nhits())
+    {
+      return false;
+    }
+    for (unsigned int i = 0; i < first.get_nhits(); ++i)
+    {
+      if (!same_header(first.get_hit(i), second.get_hit(i)) ||
+          samples(first.get_hit(i)) != samples(second.get_hit(i)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // the waveforms of hit i, as the unpacker fills them
+  std::vector<std::pair<uint16_t, std::vector<uint16_t>>> waveforms(unsigned int i)
+  {
+    switch (i % 4)
+    {
+    case 0:
+      return {{10, {100, 101, 102}}, {50, {200, 201}}};
+    case 1:
+      return {};
+    case 2:
+      return {{0, {7}}};
+    default:
+      return {{300, {1, 2, 3, 4, 5}}, {305, {6}}, {900, {}}, {1000, {8, 9}}};
+    }
+  }
+
+  void fill(TpcRawHitContainerv3& container, unsigned int nhits)
+  {
+    container.setBco(0x123456789aULL);
+    container.setStatus(3);
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      TpcRawHitv3 hit;
+      hit.set_bco(1000 + i);
+      hit.set_packetid(4000 + i % 3);
+      hit.set_fee(i % 26);
+      hit.set_channel(i % 256);
+      hit.set_type(i % 2);
+      hit.set_checksumerror(i % 5 == 0);
+      hit.set_parityerror(i % 7 == 0);
+      for (auto& [start_time, adc] : waveforms(i))
+      {
+        hit.move_adc_waveform(start_time, std::move(adc));
+      }
+      container.AddHit(&hit);
+    }
+  }
+
+  void test_v3_to_v4()
+  {
+    TpcRawHitContainerv3 v3;
+    fill(v3, 12);
+
+    TpcRawHitContainerv4 v4;
+    v4.CopyFrom(&v3);
+    check(v4.get_nhits() == 12, "number of hits copied to v4");
+    check(v4.getBco() == v3.getBco() && v4.getStatus() == v3.getStatus(), "bco and status copied to v4");
+    check(same_hits(v3, v4), "hits copied to v4");
+    check(v4.get_hit(12) == nullptr, "get_hit past the last hit");
+
+    // random access to the samples, including the gaps between waveforms
+    TpcRawHit* hit = v4.get_hit(3);
+    check(hit->get_adc(300) == 1 && hit->get_adc(305) == 6 && hit->get_adc(1001) == 9, "get_adc inside waveforms");
+    check(hit->get_adc(299) == 0 && hit->get_adc(306) == 0 && hit->get_adc(900) == 0, "get_adc between waveforms");
+    check(samples(v4.get_hit(1)).empty(), "hit without waveform");
+
+    // write and read back
+    TBufferFile buffer(TBuffer::kWrite);
+    v4.Streamer(buffer);
+    buffer.SetReadMode();
+    buffer.SetBufferOffset(0);
+    TpcRawHitContainerv4 copy;
+    copy.Streamer(buffer);
+    check(same_hits(v3, copy), "hits written and read back from v4");
+
+    // back to v3, through the views
+    TpcRawHitContainerv3 v3copy;
+    for (unsigned int i = 0; i < copy.get_nhits(); ++i)
+    {
+      v3copy.AddHit(copy.get_hit(i));
+    }
+    check(same_hits(v3, v3copy), "hits copied back to v3");
+  }
+
+  void test_reset()
+  {
+    TpcRawHitContainerv3 v3;
+    fill(v3, 8);
+    TpcRawHitContainerv4 v4;
+    v4.CopyFrom(&v3);
+    TpcRawHit* first = v4.get_hit(0);
+
+    v4.Reset();
+    check(v4.get_nhits() == 0 && v4.get_hit(0) == nullptr && !v4.isValid(), "Reset v4");
+
+    // next event, fewer hits, views are reused
+    TpcRawHitContainerv3 next;
+    fill(next, 3);
+    for (unsigned int i = 0; i < next.get_nhits(); ++i)
+    {
+      v4.AddHit(next.get_hit(i));
+    }
+    check(same_hits(next, v4), "hits added after Reset");
+    check(v4.get_hit(0) == first, "views are kept after Reset");
+
+    v3.Reset();
+    check(v3.get_nhits() == 0 && v3.get_hit(0) == nullptr, "Reset v3");
+  }
+
+  // unpacker pattern: empty hit filled through its view, one sample at a time
+  void test_fill_view()
+  {
+    TpcRawHitContainerv4 v4;
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      TpcRawHit* hit = v4.AddHit();
+      hit->set_bco(77 + i);
+      hit->set_packetid(4001);
+      hit->set_fee(5);
+      hit->set_channel(40 + i);
+      hit->set_type(1);
+      hit->set_checksumerror(false);
+      hit->set_parityerror(false);
+      hit->set_adc(20, 200 + i);
+      hit->set_adc(21, 210 + i);
+      hit->set_adc(40, 400 + i);
+    }
+    // samples can only be added to the last hit
+    v4.get_hit(0)->set_adc(60, 1);
+    check(samples(v4.get_hit(0)) == sample_list({{20, 200}, {21, 210}, {40, 400}}), "samples of the first hit");
+    check(samples(v4.get_hit(1)) == sample_list({{20, 201}, {21, 211}, {40, 401}}), "samples of the last hit");
+    check(v4.get_hit(1)->get_channel() == 41 && v4.get_hit(1)->get_bco() == 78, "header set through the view");
+
+    TpcRawHitContainerv3 v3;
+    for (unsigned int i = 0; i < v4.get_nhits(); ++i)
+    {
+      v3.AddHit(v4.get_hit(i));
+    }
+    check(same_hits(v4, v3), "filled hits copied to v3");
+  }
+}  // namespace
+
+int main()
+{
+  test_v3_to_v4();
+  test_reset();
+  test_fill_view();
+  std::cout << "tpcrawhitcontainer_test - " << (nfailed ? "failed" : "passed") << std::endl;
+  return nfailed;
+}
@@ -0,0 +1,214 @@
+#include "DstEventIndex.h"
+
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <tuple>
+
+namespace
+{
+  // version 02 added the identity of the DST
+  const char indexmagic[8] = {'F', '4', 'A', 'I', 'D', 'X', '0', '2'};
+  const char indexmagic_v1[8] = {'F', '4', 'A', 'I', 'D', 'X', '0', '1'};
+
+  std::tuple<int32_t, int32_t, int32_t> key(const DstEventIndex::Entry &e)
+  {
+    return {e.run, e.segment, e.event};
+  }
+
+  template <typename T>
+  void write_value(std::ofstream &out, const T val)
+  {
+    out.write(reinterpret_cast<const char *>(&val), sizeof(T));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+
+  template <typename T>
+  void read_value(std::ifstream &in, T &val)
+  {
+    in.read(reinterpret_cast<char *>(&val), sizeof(T));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+}  // namespace
+
+void DstEventIndex::Add(const int run, const int segment, const int event, const int64_t bco, const uint64_t entry)
+{
+  Entry newentry;
+  newentry.run = run;
+  newentry.segment = segment;
+  newentry.event = event;
+  newentry.bco = bco;
+  newentry.entry = entry;
+  if (!m_Entries.empty() && key(newentry) < key(m_Entries.back()))
+  {
+    m_Ordered = false;
+  }
+  m_Entries.push_back(newentry);
+  m_Sorted = false;
+}
+
+void DstEventIndex::Clear()
+{
+  m_Entries.clear();
+  m_SourceUUID.clear();
+  m_SourceEntries = 0;
+  m_ByEvent.clear();
+  m_ByBco.clear();
+  m_Sorted = true;
+  m_Ordered = true;
+}
+
+void DstEventIndex::Sort() const
+{
+  if (m_Sorted)
+  {
+    return;
+  }
+  m_ByEvent.resize(m_Entries.size());
+  m_ByBco.clear();
+  for (uint32_t i = 0; i < m_Entries.size(); ++i)
+  {
+    m_ByEvent[i] = i;
+    if (m_Entries[i].bco >= 0)
+    {
+      m_ByBco.push_back(i);
+    }
+  }
+  std::stable_sort(m_ByEvent.begin(), m_ByEvent.end(), [this](const uint32_t a, const uint32_t b)
+                   { return key(m_Entries[a]) < key(m_Entries[b]); });
+  std::stable_sort(m_ByBco.begin(), m_ByBco.end(), [this](const uint32_t a, const uint32_t b)
+                   { return m_Entries[a].bco < m_Entries[b].bco; });
+  m_Sorted = true;
+}
+
+int64_t DstEventIndex::FindEvent(const int run, const int segment, const int event) const
+{
+  Sort();
+  const std::tuple<int32_t, int32_t, int32_t> wanted{run, segment, event};
+  auto iter = std::lower_bound(m_ByEvent.begin(), m_ByEvent.end(), wanted, [this](const uint32_t a, const std::tuple<int32_t, int32_t, int32_t> &k)
+                               { return key(m_Entries[a]) < k; });
+  if (iter == m_ByEvent.end() || key(m_Entries[*iter]) != wanted)
+  {
+    return -1;
+  }
+  return m_Entries[*iter].entry;
+}
+
+int64_t DstEventIndex::FindBco(const int64_t bco) const
+{
+  Sort();
+  auto iter = std::lower_bound(m_ByBco.begin(), m_ByBco.end(), bco, [this](const uint32_t a, const int64_t b)
+                               { return m_Entries[a].bco < b; });
+  if (iter == m_ByBco.end() || m_Entries[*iter].bco != bco)
+  {
+    return -1;
+  }
+  return m_Entries[*iter].entry;
+}
+
+int64_t DstEventIndex::LowerBound(const int run, const int segment, const int event) const
+{
+  Sort();
+  const std::tuple<int32_t, int32_t, int32_t> wanted{run, segment, event};
+  auto iter = std::lower_bound(m_ByEvent.begin(), m_ByEvent.end(), wanted, [this](const uint32_t a, const std::tuple<int32_t, int32_t, int32_t> &k)
+                               { return key(m_Entries[a]) < k; });
+  if (iter == m_ByEvent.end())
+  {
+    return -1;
+  }
+  return m_Entries[*iter].entry;
+}
+
+void DstEventIndex::SetSource(const std::string &uuid, const uint64_t treeentries)
+{
+  m_SourceUUID = uuid;
+  m_SourceEntries = treeentries;
+}
+
+bool DstEventIndex::Matches(const std::string &uuid, const uint64_t treeentries) const
+{
+  return !m_SourceUUID.empty() && m_SourceUUID == uuid && m_SourceEntries == treeentries;
+}
+
+bool DstEventIndex::Write(const std::string &filename) const
+{
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+  {
+    std::cout << PHWHERE << " could not open " << filename << " for writing" << std::endl;
+    return false;
+  }
+  out.write(indexmagic, sizeof(indexmagic));
+  write_value(out, static_cast<uint32_t>(m_SourceUUID.size()));
+  out.write(m_SourceUUID.data(), static_cast<std::streamsize>(m_SourceUUID.size()));
+  write_value(out, m_SourceEntries);
+  write_value(out, static_cast<uint64_t>(m_Entries.size()));
+  for (const auto &entry : m_Entries)
+  {
+    write_value(out, entry.run);
+    write_value(out, entry.segment);
+    write_value(out, entry.event);
+    write_value(out, entry.bco);
+    write_value(out, entry.entry);
+  }
+  return out.good();
+}
+
+bool DstEventIndex::Read(const std::string &filename)
+{
+  Clear();
+  std::ifstream in(filename, std::ios::binary);
+  if (!in.is_open())
+  {
+    return false;
+  }
+  char magic[sizeof(indexmagic)];
+  in.read(magic, sizeof(magic));
+  if (in.good() && std::memcmp(magic, indexmagic_v1, sizeof(indexmagic_v1)) == 0)
+  {
+    std::cout << PHWHERE << " " << filename << " does not record which DST it belongs to, ignoring it" << std::endl;
+    return false;
+  }
+  if (!in.good() || std::memcmp(magic, indexmagic, sizeof(indexmagic)) != 0)
+  {
+    std::cout << PHWHERE << " " << filename << " is not an event index" << std::endl;
+    return false;
+  }
+  uint32_t uuidlength = 0;
+  read_value(in, uuidlength);
+  // a TUUID string has 36 characters, anything much longer is garbage
+  if (!in.good() || uuidlength > 64)
+  {
+    std::cout << PHWHERE << " " << filename << " has a corrupt header" << std::endl;
+    return false;
+  }
+  std::string uuid(uuidlength, '\0');
+  in.read(uuid.data(), uuidlength);
+  uint64_t treeentries = 0;
+  read_value(in, treeentries);
+  uint64_t nentries = 0;
+  read_value(in, nentries);
+  for (uint64_t i = 0; i < nentries && in.good(); ++i)
+  {
+    Entry entry;
+    read_value(in, entry.run);
+    read_value(in, entry.segment);
+    read_value(in, entry.event);
+    read_value(in, entry.bco);
+    read_value(in, entry.entry);
+    if (in.good())
+    {
+      Add(entry.run, entry.segment, entry.event, entry.bco, entry.entry);
+    }
+  }
+  if (m_Entries.size() != nentries)
+  {
+    std::cout << PHWHERE << " " << filename << " is truncated, expected "
+              << nentries << " entries, got " << m_Entries.size() << std::endl;
+    Clear();
+    return false;
+  }
+  SetSource(uuid, treeentries);
+  return true;
+}
@@ -0,0 +1,73 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_DSTEVENTINDEX_H
+#define FUN4ALL_DSTEVENTINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// maps run, segment, event number and GL1 BCO of each event in a DST
+// to its entry in the event TTree. It is written next to the DST
+// (SidecarName()) by the Fun4AllDstOutputManager or built by the
+// Fun4AllDstInputManager from the sync branch. The sidecar stores the
+// UUID and number of entries of the DST it was made for, an index which
+// does not match the DST (Matches()) must not be used
+class DstEventIndex
+{
+ public:
+  struct Entry
+  {
+    int32_t run{0};
+    int32_t segment{0};
+    int32_t event{0};
+    int64_t bco{-1};
+    uint64_t entry{0};
+  };
+
+  DstEventIndex() = default;
+  ~DstEventIndex() = default;
+
+  static std::string SidecarName(const std::string &dstfile) { return dstfile + ".evtidx"; }
+
+  void Add(const int run, const int segment, const int event, const int64_t bco, const uint64_t entry);
+  void Clear();
+  size_t size() const { return m_Entries.size(); }
+  bool empty() const { return m_Entries.empty(); }
+  // true if the entries in the file are ordered by run, segment and event number
+  bool Ordered() const { return m_Ordered; }
+  const std::vector<Entry> &Entries() const { return m_Entries; }
+
+  // tree entry of this event, -1 if it is not in the file
+  int64_t FindEvent(const int run, const int segment, const int event) const;
+  // tree entry of the event with this GL1 BCO, -1 if it is not in the file
+  int64_t FindBco(const int64_t bco) const;
+  // first tree entry whose run, segment and event number are not smaller
+  // than the given ones, -1 if there is none. Only meaningful if Ordered()
+  int64_t LowerBound(const int run, const int segment, const int event) const;
+
+  // identity of the DST this index belongs to
+  void SetSource(const std::string &uuid, const uint64_t treeentries);
+  const std::string &SourceUUID() const { return m_SourceUUID; }
+  uint64_t SourceEntries() const { return m_SourceEntries; }
+  bool Matches(const std::string &uuid, const uint64_t treeentries) const;
+
+  bool Write(const std::string &filename) const;
+  bool Read(const std::string &filename);
+
+ private:
+  // builds the lookup tables after entries were added
+  void Sort() const;
+
+  std::vector<Entry> m_Entries;
+  std::string m_SourceUUID;
+  uint64_t m_SourceEntries{0};
+  // indices into m_Entries sorted by event key and by bco
+  mutable std::vector<uint32_t> m_ByEvent;
+  mutable std::vector<uint32_t> m_ByBco;
+  mutable bool m_Sorted{true};
+  bool m_Ordered{true};
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "Fun4AllServer.h"
 #include "InputFileHandlerReturnCodes.h"
 
+#include <ffaobjects/EventHeader.h>
 #include <ffaobjects/RunHeader.h>
 #include <ffaobjects/SyncDefs.h>
 #include <ffaobjects/SyncObject.h>
@@ -24,6 +25,7 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <filesystem>
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <utility>   // for pair
 #include <vector>    // for vector
@@ -136,6 +138,22 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
     {
       m_IManager->DisableReadCache();
     }
+    m_IManager->BranchStatistics(m_BranchStatistics);
+    if (m_AdaptiveEvents > 0)
+    {
+      m_IManager->AdaptiveBranchSelect(m_AdaptiveEvents);
+      // the sync object is read on its own when syncing input managers
+      m_IManager->AlwaysRead(syncdefs::SYNCNODENAME);
+      for (const auto &nodename : m_AlwaysRead)
+      {
+        m_IManager->AlwaysRead(nodename);
+      }
+      // reuse what we learned on the previous file
+      if (!m_AdaptiveBranches.empty())
+      {
+        m_IManager->AdaptiveBranchSelect(m_AdaptiveBranches);
+      }
+    }
     if (m_IManager->NodeExist(syncdefs::SYNCNODENAME))
     {
       m_HaveSyncObject = 1;
@@ -219,8 +237,18 @@ int Fun4AllDstInputManager::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  if (m_IManager->AdaptiveBranchSelectDone())
+  {
+    m_AdaptiveBranches = m_IManager->AdaptiveBranches();
+  }
+  if (m_BranchStatistics)
+  {
+    m_IManager->PrintBranchStatistics();
+  }
   delete m_IManager;
   m_IManager = nullptr;
+  m_EventIndex.Clear();
+  m_EventIndexLoaded = false;
   IsOpen(0);
   UpdateFileList();
   m_HaveSyncObject = 0;
@@ -288,6 +316,34 @@ int Fun4AllDstInputManager::SyncIt(const SyncObject *mastersync)
                   << ", this run number: " << syncobject->RunNumber() << std::endl;
       }
 
+      // with an event index jump directly to the first event which is not
+      // before the master, the loops below then only confirm the position
+      if (LoadEventIndex() && m_EventIndex.Ordered())
+      {
+        int64_t target = m_EventIndex.LowerBound(mastersync->RunNumber(), mastersync->SegmentNumber(), mastersync->EventNumber());
+        if (target < 0)  // all events of this file are before the master
+        {
+          target = m_EventIndex.Entries().back().entry;
+        }
+        // the current sync object is the one of the last entry read
+        int64_t current = static_cast<int64_t>(m_IManager->getEventNumber()) - 1;
+        if (target > current)
+        {
+          if (Verbosity() > 2)
+          {
+            std::cout << Name() << ": event index, jumping from entry " << current
+                      << " to " << target << std::endl;
+          }
+          events_skipped_during_sync += target - current;
+          m_IManager->setEventNumber(target);
+          iret = ReadNextEventSyncObject();
+          if (iret)
+          {
+            return iret;
+          }
+        }
+      }
+
       while (syncobject->RunNumber() < mastersync->RunNumber())
       {
         events_skipped_during_sync++;
@@ -509,6 +565,144 @@ readnextsync:
   return 0;
 }
 
+std::string Fun4AllDstInputManager::FindBranch(const std::string &nodename)
+{
+  std::string delimeters = phooldefs::branchpathdelim + phooldefs::legacypathdelims;
+  for (const auto &branch : *m_IManager->GetBranchMap())
+  {
+    std::vector<std::string> splitvec;
+    boost::split(splitvec, branch.first, boost::is_any_of(delimeters));
+    if (splitvec.back() == nodename)
+    {
+      return branch.first;
+    }
+  }
+  return "";
+}
+
+bool Fun4AllDstInputManager::LoadEventIndex()
+{
+  if (!m_UseEventIndex || !m_IManager)
+  {
+    return false;
+  }
+  if (m_EventIndexLoaded)
+  {
+    return !m_EventIndex.empty();
+  }
+  m_EventIndexLoaded = true;
+  // the branches need to be connected to the nodes, which happens with
+  // the first event read
+  if (m_IManager->GetEntries() < 0)
+  {
+    m_IManager->read(dstNode);
+    m_IManager->setEventNumber(0);
+  }
+  std::string indexfile = DstEventIndex::SidecarName(fullfilename);
+  if (std::filesystem::exists(indexfile) && m_EventIndex.Read(indexfile))
+  {
+    // the sidecar might be left over from an earlier version of the DST
+    if (m_EventIndex.Matches(m_IManager->GetFileUUID(), static_cast<uint64_t>(m_IManager->GetEntries())))
+    {
+      if (Verbosity() > 0)
+      {
+        std::cout << Name() << ": read index of " << m_EventIndex.size()
+                  << " events from " << indexfile << std::endl;
+      }
+      return true;
+    }
+    std::cout << Name() << ": " << indexfile << " does not belong to "
+              << fullfilename << ", rebuilding the event index" << std::endl;
+    m_EventIndex.Clear();
+  }
+  // no valid index on disk, build it by reading only the sync object (and
+  // the EventHeader for the bco) of every event
+  std::string syncbranch = FindBranch(syncdefs::SYNCNODENAME);
+  SyncObject *sync = findNode::getClass<SyncObject>(dstNode, syncdefs::SYNCNODENAME);
+  if (syncbranch.empty() || !sync)
+  {
+    return false;
+  }
+  std::string headerbranch = FindBranch("EventHeader");
+  EventHeader *evtheader = findNode::getClass<EventHeader>(dstNode, "EventHeader");
+  if (!m_IManager->isSelected(headerbranch))
+  {
+    evtheader = nullptr;
+  }
+  int64_t nentries = m_IManager->GetEntries();
+  for (int64_t ientry = 0; ientry < nentries; ++ientry)
+  {
+    if (!m_IManager->readSpecific(ientry, syncbranch))
+    {
+      break;
+    }
+    int64_t bco = -1;
+    if (evtheader && m_IManager->readSpecific(ientry, headerbranch))
+    {
+      bco = evtheader->get_BunchCrossing();
+    }
+    m_EventIndex.Add(sync->RunNumber(), sync->SegmentNumber(), sync->EventNumber(), bco, ientry);
+  }
+  // restore the content of the last event read
+  int64_t current = static_cast<int64_t>(m_IManager->getEventNumber()) - 1;
+  if (current >= 0)
+  {
+    m_IManager->readSpecific(current, syncbranch);
+    if (evtheader)
+    {
+      m_IManager->readSpecific(current, headerbranch);
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": built index of " << m_EventIndex.size()
+              << " events for " << fullfilename << std::endl;
+  }
+  return !m_EventIndex.empty();
+}
+
+int Fun4AllDstInputManager::SeekEvent(const int run, const int segment, const int event)
+{
+  if (!LoadEventIndex())
+  {
+    std::cout << PHWHERE << Name() << ": no event index available for " << FileName() << std::endl;
+    return -1;
+  }
+  int64_t entry = m_EventIndex.FindEvent(run, segment, event);
+  if (entry < 0)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << Name() << ": run " << run << ", segment " << segment
+                << ", event " << event << " not in " << FileName() << std::endl;
+    }
+    return -1;
+  }
+  m_IManager->setEventNumber(entry);
+  return 0;
+}
+
+int Fun4AllDstInputManager::SeekBco(const int64_t bco)
+{
+  if (!LoadEventIndex())
+  {
+    std::cout << PHWHERE << Name() << ": no event index available for " << FileName() << std::endl;
+    return -1;
+  }
+  int64_t entry = m_EventIndex.FindBco(bco);
+  if (entry < 0)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << Name() << ": bco 0x" << std::hex << bco << std::dec
+                << " not in " << FileName() << std::endl;
+    }
+    return -1;
+  }
+  m_IManager->setEventNumber(entry);
+  return 0;
+}
+
 int Fun4AllDstInputManager::BranchSelect(const std::string &branch, const int iflag)
 {
   if (IsOpen())
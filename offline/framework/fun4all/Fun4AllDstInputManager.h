@@ -3,11 +3,14 @@
 #ifndef FUN4ALL_FUN4ALLDSTINPUTMANAGER_H
 #define FUN4ALL_FUN4ALLDSTINPUTMANAGER_H
 
+#include "DstEventIndex.h"
 #include "Fun4AllInputManager.h"
 
 #include <phool/PHNodeIOManager.h>
 
+#include <cstdint>
 #include <map>
+#include <set>
 #include <string>
 
 class PHCompositeNode;
@@ -27,6 +30,23 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   int BranchSelect(const std::string &branch, const int iflag) override;
   int setBranches() override;
   void CacheSize(uint64_t size) { m_IManager->CacheSize(size); }
+  // learn during the first nevents of the first file which nodes are used
+  // (their data is retrieved from the node, e.g. via findNode::getClass,
+  // or they are written by an output manager), afterwards read and cache
+  // only their branches
+  void AdaptiveBranchSelect(const uint64_t nevents) { m_AdaptiveEvents = nevents; }
+  // never switch off this node with the adaptive branch selection, for
+  // objects which are used without retrieving them from their node
+  void AlwaysRead(const std::string &nodename) { m_AlwaysRead.insert(nodename); }
+  // print bytes and time spent reading each branch when a file is closed
+  void BranchStatistics(const bool b) { m_BranchStatistics = b; }
+  // use the event index (DstEventIndex) to resynchronize and seek, it is
+  // read from the file next to the DST or built from its sync branch if
+  // that file is missing or belongs to a different DST
+  void UseEventIndex(const bool b) { m_UseEventIndex = b; }
+  // position the current file so the next event read is the requested one
+  int SeekEvent(const int run, const int segment, const int event);
+  int SeekBco(const int64_t bco);
   virtual int setSyncBranches(PHNodeIOManager *iman);
   void Print(const std::string &what = "ALL") const override;
   int PushBackEvents(const int i) override;
@@ -34,6 +54,8 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
 
  protected:
   int ReadNextEventSyncObject();
+  bool LoadEventIndex();
+  std::string FindBranch(const std::string &nodename);
   void ReadRunTTree(const int i) { m_ReadRunTTree = i; }
   void IManager(PHNodeIOManager *iman) { m_IManager = iman; }
   PHNodeIOManager *IManager() { return m_IManager; }
@@ -59,6 +81,14 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   int events_skipped_during_sync{0};
   int m_HaveSyncObject{0};
   std::map<const std::string, int> branchread;
+  std::set<std::string> m_AdaptiveBranches;
+  uint64_t m_AdaptiveEvents{0};
+  std::set<std::string> m_AlwaysRead;
+  bool m_BranchStatistics{false};
+  bool m_UseEventIndex{false};
+  // index of the current file, cleared when it is closed
+  DstEventIndex m_EventIndex;
+  bool m_EventIndexLoaded{false};
   std::string syncbranchname;
   std::string RunNode{"RUN"};
 };
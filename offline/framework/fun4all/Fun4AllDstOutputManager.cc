@@ -2,13 +2,19 @@
 
 #include "Fun4AllServer.h"
 
+#include <ffaobjects/EventHeader.h>
+#include <ffaobjects/SyncDefs.h>
+#include <ffaobjects/SyncObject.h>
+
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNode.h>
 #include <phool/PHNodeIOManager.h>
 #include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 #include <phool/recoConsts.h>
 
+#include <TROOT.h>
 #include <TSystem.h>
 
 #include <cstdlib>
@@ -25,6 +31,11 @@ Fun4AllDstOutputManager::Fun4AllDstOutputManager(const std::string &myname, cons
 
 Fun4AllDstOutputManager::~Fun4AllDstOutputManager()
 {
+  SaveEventIndex();
+  if (dstOut && m_WriteStatistics)
+  {
+    dstOut->PrintWriteStatistics();
+  }
   delete dstOut;
   return;
 }
@@ -172,6 +183,17 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
     }
   }
   dstOut->write(startNode);
+  if (m_WriteEventIndex)
+  {
+    SyncObject *syncobject = findNode::getClass<SyncObject>(startNode, syncdefs::SYNCNODENAME);
+    if (syncobject)
+    {
+      EventHeader *evtheader = findNode::getClass<EventHeader>(startNode, "EventHeader");
+      m_EventIndex.Add(syncobject->RunNumber(), syncobject->SegmentNumber(), syncobject->EventNumber(),
+                       evtheader ? evtheader->get_BunchCrossing() : -1,
+                       dstOut->getEventNumber() - 1);
+    }
+  }
   // to save some cpu cycles we only make it globally transient if
   // all nodes have been written (savenodes set is empty)
   // else we only make the nodes transient which we have written (all
@@ -197,6 +219,8 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
 
 int Fun4AllDstOutputManager::WriteNode(PHCompositeNode *thisNode)
 {
+  // the event part of the current file is done
+  SaveEventIndex();
   if (!m_SaveRunNodeFlag)
   {
     dstOut = nullptr;
@@ -227,6 +251,10 @@ int Fun4AllDstOutputManager::WriteNode(PHCompositeNode *thisNode)
       return 0;
     }
   }
+  if (dstOut && m_WriteStatistics)
+  {
+    dstOut->PrintWriteStatistics();
+  }
   delete dstOut;
 
   if (UsedOutFileName().empty())
@@ -337,6 +365,11 @@ int Fun4AllDstOutputManager::outfile_open_first_write()
     m_CurrentSegment++;
   }
   m_UsedOutFileName = OutFileName() + std::string("?reproducible=") + std::string(p.filename());
+  // has to be on before the tree is created
+  if (m_ImplicitMTThreads > 0 && !ROOT::IsImplicitMTEnabled())
+  {
+    ROOT::EnableImplicitMT(m_ImplicitMTThreads);
+  }
   dstOut = new PHNodeIOManager(UsedOutFileName(), PHWrite);
   if (SplitLevel() != std::numeric_limits<int>::min())
   {
@@ -355,9 +388,27 @@ int Fun4AllDstOutputManager::outfile_open_first_write()
   }
 
   dstOut->SetCompressionSetting(m_CompressionSetting);
+  dstOut->AsyncWrite(m_AsyncWriteDepth);
   return 0;
 }
 
+void Fun4AllDstOutputManager::SaveEventIndex()
+{
+  if (m_EventIndex.empty() || !dstOut)
+  {
+    return;
+  }
+  m_EventIndex.SetSource(dstOut->GetFileUUID(), dstOut->getEventNumber());
+  std::string indexfile = DstEventIndex::SidecarName(OutFileName());
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": writing index of " << m_EventIndex.size()
+              << " events to " << indexfile << std::endl;
+  }
+  m_EventIndex.Write(indexfile);
+  m_EventIndex.Clear();
+}
+
 // this method figures out the last event number to be saved before rolling over
 // an integer div of the current event by the number of events gives the first event we can expect
 // in this process (this is not needed), then adding the number of events we want gives us the last event
@@ -3,6 +3,7 @@
 #ifndef FUN4ALL_FUN4ALLDSTOUTPUTMANAGER_H
 #define FUN4ALL_FUN4ALLDSTOUTPUTMANAGER_H
 
+#include "DstEventIndex.h"
 #include "Fun4AllOutputManager.h"
 
 #include <set>
@@ -36,16 +37,30 @@ class Fun4AllDstOutputManager : public Fun4AllOutputManager
   const std::string &UsedOutFileName() const { return m_UsedOutFileName; }
   void CompressionSetting(const int i) override { m_CompressionSetting = i; }
   void InitializeLastEvent(int eventnumber) override;
-  
+  // hand events to a writer thread through a queue of depth events
+  void AsyncWrite(const unsigned int depth) { m_AsyncWriteDepth = depth; }
+  // compress baskets in parallel using ROOT implicit multithreading
+  void ImplicitMT(const unsigned int nthreads) { m_ImplicitMTThreads = nthreads; }
+  // print branch sizes and write times when the file is closed
+  void WriteStatistics(const bool b) { m_WriteStatistics = b; }
+  // write an event index (DstEventIndex) next to each output file
+  void WriteEventIndex(const bool b) { m_WriteEventIndex = b; }
+
  private:
   int outfile_open_first_write();
+  void SaveEventIndex();
   PHNodeIOManager *dstOut{nullptr};
   int m_SaveRunNodeFlag{1};
   int m_SaveDstNodeFlag{1};
   int m_CompressionSetting{505};
+  unsigned int m_AsyncWriteDepth{0};
+  unsigned int m_ImplicitMTThreads{0};
+  bool m_WriteStatistics{false};
+  bool m_WriteEventIndex{false};
   bool m_LastEventInitialized{false};
   std::string m_FileNameStem;
   std::string m_UsedOutFileName;
+  DstEventIndex m_EventIndex;
   std::set<std::string> savenodes;
   std::set<std::string> saverunnodes;
   std::set<std::string> m_StripCompositeNodes;
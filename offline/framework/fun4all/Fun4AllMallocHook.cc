@@ -0,0 +1,86 @@
+// malloc interposer counting allocations per thread, for Fun4AllProfiler.
+// Must be preloaded to be effective:
+//   LD_PRELOAD=libfun4all_mallochook.so root.exe ...
+// Forwards to the glibc implementation, memory is not touched
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+extern "C"
+{
+  void *__libc_malloc(size_t size);
+  void *__libc_calloc(size_t n, size_t size);
+  void *__libc_realloc(void *ptr, size_t size);
+  void *__libc_memalign(size_t alignment, size_t size);
+}
+
+namespace
+{
+  // initial-exec tls does not allocate, so it is safe to use from malloc
+  __attribute__((tls_model("initial-exec"))) thread_local uint64_t allocations = 0;
+  __attribute__((tls_model("initial-exec"))) thread_local uint64_t allocated_bytes = 0;
+
+  inline void count(const size_t size)
+  {
+    ++allocations;
+    allocated_bytes += size;
+  }
+}  // namespace
+
+extern "C"
+{
+  //! allocation count and bytes of the calling thread since it started
+  __attribute__((visibility("default"))) void fun4all_mallochook_counts(uint64_t *count, uint64_t *bytes)
+  {
+    *count = allocations;
+    *bytes = allocated_bytes;
+  }
+
+  void *malloc(size_t size) noexcept
+  {
+    count(size);
+    return __libc_malloc(size);
+  }
+
+  void *calloc(size_t n, size_t size) noexcept
+  {
+    count(n * size);
+    return __libc_calloc(n, size);
+  }
+
+  void *realloc(void *ptr, size_t size) noexcept
+  {
+    count(size);
+    return __libc_realloc(ptr, size);
+  }
+
+  void *memalign(size_t alignment, size_t size) noexcept
+  {
+    count(size);
+    return __libc_memalign(alignment, size);
+  }
+
+  void *aligned_alloc(size_t alignment, size_t size) noexcept
+  {
+    count(size);
+    return __libc_memalign(alignment, size);
+  }
+
+  int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept
+  {
+    // alignment must be a power of two multiple of sizeof(void*)
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0)
+    {
+      return EINVAL;
+    }
+    count(size);
+    void *p = __libc_memalign(alignment, size);
+    if (!p)
+    {
+      return ENOMEM;
+    }
+    *ptr = p;
+    return 0;
+  }
+}
@@ -0,0 +1,269 @@
+#include "Fun4AllProfiler.h"
+
+#include <phool/phool.h>
+
+#include <dlfcn.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+
+Fun4AllProfiler *Fun4AllProfiler::mInstance = nullptr;
+
+namespace
+{
+  uint64_t ReadClock(const clockid_t clock)
+  {
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000U + ts.tv_nsec;
+  }
+
+  // minimal json string escaping, enough for module names
+  std::string JSONString(const std::string &s)
+  {
+    std::string out = "\"";
+    for (char c : s)
+    {
+      if (c == '"' || c == '\\')
+      {
+        out += '\\';
+      }
+      out += c;
+    }
+    return out + "\"";
+  }
+}  // namespace
+
+Fun4AllProfiler::Fun4AllProfiler()
+  : Fun4AllBase("Fun4AllProfiler")
+{
+  // exported by libfun4all_mallochook.so when it is preloaded
+  mAllocCounts = reinterpret_cast<void (*)(uint64_t *, uint64_t *)>(dlsym(RTLD_DEFAULT, "fun4all_mallochook_counts"));
+}
+
+Fun4AllProfiler::~Fun4AllProfiler()
+{
+  mInstance = nullptr;
+}
+
+Fun4AllProfiler::Probe Fun4AllProfiler::Start() const
+{
+  Probe probe;
+  rusage usage{};
+  getrusage(RUSAGE_THREAD, &usage);
+  probe.minor_faults = usage.ru_minflt;
+  probe.major_faults = usage.ru_majflt;
+  probe.voluntary_switches = usage.ru_nvcsw;
+  probe.involuntary_switches = usage.ru_nivcsw;
+  if (mAllocCounts)
+  {
+    mAllocCounts(&probe.allocations, &probe.allocated_bytes);
+  }
+  // clocks last, so that the other probes are not included in the measurement
+  probe.cpu_ns = ReadClock(CLOCK_THREAD_CPUTIME_ID);
+  probe.wall_ns = ReadClock(CLOCK_MONOTONIC);
+  return probe;
+}
+
+void Fun4AllProfiler::Stop(const std::string &name, const Probe &probe)
+{
+  // clocks first, see Start()
+  const uint64_t wall_ns = ReadClock(CLOCK_MONOTONIC);
+  const uint64_t cpu_ns = ReadClock(CLOCK_THREAD_CPUTIME_ID);
+  Probe now;
+  rusage usage{};
+  getrusage(RUSAGE_THREAD, &usage);
+  if (mAllocCounts)
+  {
+    mAllocCounts(&now.allocations, &now.allocated_bytes);
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  Stats &stats = mStats[name];
+  const uint64_t elapsed = wall_ns - probe.wall_ns;
+  stats.calls++;
+  stats.wall_ns += elapsed;
+  stats.cpu_ns += cpu_ns - probe.cpu_ns;
+  stats.max_ns = std::max(stats.max_ns, elapsed);
+  stats.minor_faults += usage.ru_minflt - probe.minor_faults;
+  stats.major_faults += usage.ru_majflt - probe.major_faults;
+  stats.voluntary_switches += usage.ru_nvcsw - probe.voluntary_switches;
+  stats.involuntary_switches += usage.ru_nivcsw - probe.involuntary_switches;
+  stats.allocations += now.allocations - probe.allocations;
+  stats.allocated_bytes += now.allocated_bytes - probe.allocated_bytes;
+  stats.latency[LatencyBin(elapsed)]++;
+}
+
+int Fun4AllProfiler::LatencyBin(const uint64_t ns)
+{
+  if (ns < nSubBins)
+  {
+    return ns;
+  }
+  const int msb = 63 - __builtin_clzll(ns);
+  const int sub = (ns >> (msb - 3)) & (nSubBins - 1);
+  return (msb - 2) * nSubBins + sub;
+}
+
+double Fun4AllProfiler::LatencyBinCenter(const int bin)
+{
+  if (bin < nSubBins)
+  {
+    return bin;
+  }
+  const int shift = bin / nSubBins - 1;
+  const double low = static_cast<double>(nSubBins + bin % nSubBins) * (1ULL << shift);
+  return low + 0.5 * (1ULL << shift);
+}
+
+double Fun4AllProfiler::Percentile(const Stats &stats, const double fraction)
+{
+  if (stats.calls == 0)
+  {
+    return 0;
+  }
+  const double threshold = fraction * stats.calls;
+  uint64_t sum = 0;
+  for (int i = 0; i < nBins; ++i)
+  {
+    sum += stats.latency[i];
+    if (sum > 0 && sum >= threshold)
+    {
+      return std::min(LatencyBinCenter(i), static_cast<double>(stats.max_ns)) * 1e-6;
+    }
+  }
+  return stats.max_ns * 1e-6;
+}
+
+void Fun4AllProfiler::Reset()
+{
+  mStats.clear();
+}
+
+int Fun4AllProfiler::WriteOutFile() const
+{
+  if (mOutFileName.empty())
+  {
+    return 0;
+  }
+  std::ofstream outfile(mOutFileName, std::ios_base::trunc);
+  if (!outfile.is_open())
+  {
+    std::cout << PHWHERE << " could not open " << mOutFileName << std::endl;
+    return -1;
+  }
+  if (mOutFileName.ends_with(".json"))
+  {
+    WriteJSON(outfile);
+  }
+  else
+  {
+    WriteCSV(outfile);
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllProfiler: wrote " << mOutFileName << std::endl;
+  }
+  return 0;
+}
+
+void Fun4AllProfiler::WriteJSON(std::ostream &os) const
+{
+  const bool alloc = TracksAllocations();
+  os << "{" << std::endl;
+  os << "  \"allocations_tracked\": " << (alloc ? "true" : "false") << "," << std::endl;
+  os << "  \"modules\": [";
+  bool first = true;
+  for (const auto &[name, stats] : mStats)
+  {
+    os << (first ? "" : ",") << std::endl;
+    first = false;
+    os << "    {\"name\": " << JSONString(name)
+       << ", \"calls\": " << stats.calls
+       << ", \"wall_ms\": " << stats.wall_ns * 1e-6
+       << ", \"cpu_ms\": " << stats.cpu_ns * 1e-6
+       << ", \"cpu_fraction\": " << (stats.wall_ns ? static_cast<double>(stats.cpu_ns) / stats.wall_ns : 0.)
+       << ", \"minor_faults\": " << stats.minor_faults
+       << ", \"major_faults\": " << stats.major_faults
+       << ", \"voluntary_switches\": " << stats.voluntary_switches
+       << ", \"involuntary_switches\": " << stats.involuntary_switches
+       << ", \"allocations\": " << (alloc ? static_cast<int64_t>(stats.allocations) : -1)
+       << ", \"allocated_bytes\": " << (alloc ? static_cast<int64_t>(stats.allocated_bytes) : -1)
+       << ", \"latency_ms\": {\"p50\": " << Percentile(stats, 0.5)
+       << ", \"p90\": " << Percentile(stats, 0.9)
+       << ", \"p99\": " << Percentile(stats, 0.99)
+       << ", \"max\": " << stats.max_ns * 1e-6 << "}}";
+  }
+  os << std::endl
+     << "  ]" << std::endl
+     << "}" << std::endl;
+}
+
+void Fun4AllProfiler::WriteCSV(std::ostream &os) const
+{
+  const bool alloc = TracksAllocations();
+  os << "name,calls,wall_ms,cpu_ms,cpu_fraction,minor_faults,major_faults,voluntary_switches,involuntary_switches,"
+     << "allocations,allocated_bytes,p50_ms,p90_ms,p99_ms,max_ms" << std::endl;
+  for (const auto &[name, stats] : mStats)
+  {
+    os << name
+       << "," << stats.calls
+       << "," << stats.wall_ns * 1e-6
+       << "," << stats.cpu_ns * 1e-6
+       << "," << (stats.wall_ns ? static_cast<double>(stats.cpu_ns) / stats.wall_ns : 0.)
+       << "," << stats.minor_faults
+       << "," << stats.major_faults
+       << "," << stats.voluntary_switches
+       << "," << stats.involuntary_switches
+       << "," << (alloc ? static_cast<int64_t>(stats.allocations) : -1)
+       << "," << (alloc ? static_cast<int64_t>(stats.allocated_bytes) : -1)
+       << "," << Percentile(stats, 0.5)
+       << "," << Percentile(stats, 0.9)
+       << "," << Percentile(stats, 0.99)
+       << "," << stats.max_ns * 1e-6 << std::endl;
+  }
+}
+
+void Fun4AllProfiler::Print(const std::string &what) const
+{
+  std::ios state(nullptr);
+  state.copyfmt(std::cout);
+  std::cout << "Fun4AllProfiler: per module wall/cpu times in ms" << std::endl;
+  std::cout << std::left << std::setw(40) << "name" << std::right
+            << std::setw(10) << "calls"
+            << std::setw(12) << "wall/call"
+            << std::setw(12) << "cpu/call"
+            << std::setw(10) << "p50"
+            << std::setw(10) << "p99"
+            << std::setw(12) << "max"
+            << std::setw(12) << "faults"
+            << std::setw(14) << "allocs/call" << std::endl;
+  for (const auto &[name, stats] : mStats)
+  {
+    if (what != "ALL" && what != name)
+    {
+      continue;
+    }
+    const double calls = std::max<uint64_t>(stats.calls, 1);
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << stats.calls
+              << std::setw(12) << stats.wall_ns * 1e-6 / calls
+              << std::setw(12) << stats.cpu_ns * 1e-6 / calls
+              << std::setw(10) << Percentile(stats, 0.5)
+              << std::setw(10) << Percentile(stats, 0.99)
+              << std::setw(12) << stats.max_ns * 1e-6
+              << std::setw(12) << stats.minor_faults + stats.major_faults;
+    if (TracksAllocations())
+    {
+      std::cout << std::setw(14) << std::setprecision(1) << stats.allocations / calls;
+    }
+    else
+    {
+      std::cout << std::setw(14) << "n/a";
+    }
+    std::cout << std::endl;
+  }
+  std::cout.copyfmt(state);
+}
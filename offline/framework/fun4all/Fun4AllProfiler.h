@@ -0,0 +1,109 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLPROFILER_H
+#define FUN4ALL_FUN4ALLPROFILER_H
+
+#include "Fun4AllBase.h"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+/*!
+  \brief per module cpu, wall clock, page fault and allocation profiling
+
+  Measurements are taken around each call with Start()/Stop(), at the cost of a few
+  system calls. Wall and thread cpu time come from clock_gettime, page faults and
+  context switches from getrusage. Voluntary context switches with a low cpu over wall
+  ratio point to modules waiting on I/O.
+
+  Allocation counts are only available when libfun4all_mallochook.so is preloaded
+  (LD_PRELOAD), otherwise they are reported as -1.
+
+  Latencies are histogrammed on a log-linear scale (8 bins per power of two),
+  percentiles are quoted at bin centers, within 6% of the actual value.
+*/
+class Fun4AllProfiler : public Fun4AllBase
+{
+ public:
+  static Fun4AllProfiler *instance()
+  {
+    if (mInstance) return mInstance;
+    mInstance = new Fun4AllProfiler();
+    return mInstance;
+  }
+  ~Fun4AllProfiler() override;
+
+  //! counters at the start of a measurement
+  struct Probe
+  {
+    uint64_t wall_ns = 0;
+    uint64_t cpu_ns = 0;
+    uint64_t minor_faults = 0;
+    uint64_t major_faults = 0;
+    uint64_t voluntary_switches = 0;
+    uint64_t involuntary_switches = 0;
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+  };
+
+  void Enable(const bool b = true) { mEnabled = b; }
+  bool Enabled() const { return mEnabled; }
+
+  //! true if the malloc hook library is loaded
+  bool TracksAllocations() const { return mAllocCounts != nullptr; }
+
+  //! Start and Stop are thread safe. Measurements refer to the calling thread
+  Probe Start() const;
+  void Stop(const std::string &name, const Probe &probe);
+
+  //! file written by WriteOutFile, json if the name ends in .json, csv otherwise
+  void OutFileName(const std::string &fname) { mOutFileName = fname; }
+  const std::string &OutFileName() const { return mOutFileName; }
+  int WriteOutFile() const;
+
+  void WriteJSON(std::ostream &os) const;
+  void WriteCSV(std::ostream &os) const;
+  void Print(const std::string &what = "ALL") const override;
+
+  void Reset();
+
+ private:
+  Fun4AllProfiler();
+
+  //! log-linear latency histogram, in ns
+  static constexpr int nSubBins = 8;
+  static constexpr int nBins = 64 * nSubBins;
+  static int LatencyBin(const uint64_t ns);
+  static double LatencyBinCenter(const int bin);
+
+  struct Stats
+  {
+    uint64_t calls = 0;
+    uint64_t wall_ns = 0;
+    uint64_t cpu_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t minor_faults = 0;
+    uint64_t major_faults = 0;
+    uint64_t voluntary_switches = 0;
+    uint64_t involuntary_switches = 0;
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+    std::array<uint64_t, nBins> latency{};
+  };
+
+  //! latency percentile in ms, for fraction in [0,1]
+  static double Percentile(const Stats &stats, const double fraction);
+
+  static Fun4AllProfiler *mInstance;
+  bool mEnabled = false;
+  void (*mAllocCounts)(uint64_t *, uint64_t *) = nullptr;
+  std::string mOutFileName;
+  std::map<std::string, Stats> mStats;
+  std::mutex mMutex;
+};
+
+#endif
@@ -7,11 +7,13 @@
 #include "Fun4AllMemoryTracker.h"
 #include "Fun4AllMonitoring.h"
 #include "Fun4AllOutputManager.h"
+#include "Fun4AllProfiler.h"
 #include "Fun4AllReturnCodes.h"
 #include "Fun4AllSyncManager.h"
 #include "SubsysReco.h"
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHNodeReset.h>
@@ -24,6 +26,8 @@
 #include <phool/recoConsts.h>
 
 #include <Rtypes.h>  // for kMAXSIGNALS
+#include <TBufferFile.h>
+#include <TClass.h>
 #include <TDirectory.h>
 #include <TH1.h>
 #include <TROOT.h>
@@ -40,6 +44,19 @@
 
 // #define FFAMEMTRACKER
 
+namespace
+{
+  // deep copy through the streamer, PHObject::Clone() is disabled
+  PHObject *StreamerCopy(PHObject *source)
+  {
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.WriteObjectAny(source, source->IsA());
+    buffer.SetReadMode();
+    buffer.SetBufferOffset(0);
+    return static_cast<PHObject *>(buffer.ReadObjectAny(source->IsA()));
+  }
+}  // namespace
+
 Fun4AllServer *Fun4AllServer::__instance = nullptr;
 
 Fun4AllServer *Fun4AllServer::instance()
@@ -57,6 +74,7 @@ Fun4AllServer::Fun4AllServer(const std::string &name)
 #ifdef FFAMEMTRACKER
   , ffamemtracker(Fun4AllMemoryTracker::instance())
 #endif
+  , ffaprofiler(Fun4AllProfiler::instance())
 {
   InitAll();
   return;
@@ -64,6 +82,7 @@ Fun4AllServer::Fun4AllServer(const std::string &name)
 
 Fun4AllServer::~Fun4AllServer()
 {
+  StopWorkers();
   Reset();
   delete beginruntimestamp;
   while (Subsystems.begin() != Subsystems.end())
@@ -116,6 +135,7 @@ Fun4AllServer::~Fun4AllServer()
   recoConsts *rc = recoConsts::instance();
   delete rc;
   delete ffamemtracker;
+  delete ffaprofiler;
   __instance = nullptr;
   return;
 }
@@ -576,7 +596,16 @@ int Fun4AllServer::process_event()
       ffamemtracker->Start(timer_name, "SubsysReco");
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
 #endif
+      Fun4AllProfiler::Probe probe;
+      if (ffaprofiler->Enabled())
+      {
+        probe = ffaprofiler->Start();
+      }
       int retcode = Subsystem.first->process_event(Subsystem.second);
+      if (ffaprofiler->Enabled())
+      {
+        ffaprofiler->Stop(timer_name, probe);
+      }
       std::cout.copyfmt(m_saved_cout_state); // restore cout to default formatting
 #ifdef FFAMEMTRACKER
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
@@ -677,12 +706,43 @@ int Fun4AllServer::process_event()
 
   gROOT->cd(currdir.c_str());
   //  mainIter.print();
-  if (!OutputManager.empty() && !eventbad)  // there are registered IO managers and
-  // the event is not flagged bad
+  if (!eventbad)
+  {
+    PHCompositeNode *dstNode = nullptr;
+    if (!OutputManager.empty())
+    {
+      PHNodeIterator iter(TopNode);
+      dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    }
+    OutputEvent(dstNode);
+  }
+  for (auto &Subsystem : Subsystems)
+  {
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      std::cout << "Fun4AllServer::process_event Resetting Event " << Subsystem.first->Name() << std::endl;
+    }
+    Subsystem.first->ResetEvent(Subsystem.second);
+  }
+  for (auto &syncman : SyncManagers)
   {
-    PHNodeIterator iter(TopNode);
-    PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      std::cout << "Fun4AllServer::process_event Resetting Event for Sync Manager " << syncman->Name() << std::endl;
+    }
+    syncman->ResetEvent();
+  }
+  Fun4AllMonitoring::instance()->Snapshot("Event");
+  ResetNodeTree();
+  return 0;
+}
 
+// write out a good event from the given DST node, and save histograms
+// using the same scheme as the DSTs. RetCodes must hold the return codes of the event
+void Fun4AllServer::OutputEvent(PHCompositeNode *dstNode)
+{
+  if (!OutputManager.empty())  // there are registered IO managers
+  {
     if (dstNode)
     {
       // check if we have same number of nodes. After first event is
@@ -699,6 +759,7 @@ int Fun4AllServer::process_event()
 
       if (OutNodeCount != newcount)
       {
+        PHNodeIterator iter(dstNode);
         iter.print();
         std::cout << PHWHERE << " FATAL: Someone changed the number of Output Nodes on the fly, from " << OutNodeCount << " to " << newcount << std::endl;
         exit(1);
@@ -715,6 +776,11 @@ int Fun4AllServer::process_event()
           ffamemtracker->Snapshot("Fun4AllServerOutputManager");
           ffamemtracker->Start(iterOutMan->Name(), "OutputManager");
 #endif
+          Fun4AllProfiler::Probe probe;
+          if (ffaprofiler->Enabled())
+          {
+            probe = ffaprofiler->Start();
+          }
 	  iterOutMan->InitializeLastEvent(eventnumber); // only executed once, returns immediately for all subsequent calls
           if (eventnumber > iterOutMan->LastEventNumber())
           {
@@ -733,6 +799,10 @@ int Fun4AllServer::process_event()
           }
           // save runnode, open new file, write
           iterOutMan->WriteGeneric(dstNode);
+          if (ffaprofiler->Enabled())
+          {
+            ffaprofiler->Stop("OutputManager_" + iterOutMan->Name(), probe);
+          }
 #ifdef FFAMEMTRACKER
           ffamemtracker->Stop(iterOutMan->Name(), "OutputManager");
           ffamemtracker->Snapshot("Fun4AllServerOutputManager");
@@ -763,7 +833,7 @@ int Fun4AllServer::process_event()
     }
   }
   // saving the histograms using the same scheme as the DSTs
-  if (!HistoManager.empty() && !eventbad)
+  if (!HistoManager.empty())
   {
     // kludge to save at the correct event. This is called after the event processing. Normally it would be fine to check for == eventnumber
     // but if that event is missing we would overshoot. If there is more than one event missing this will overshoot, but there is only so much
@@ -786,25 +856,6 @@ int Fun4AllServer::process_event()
       }
     }
   }
-  for (auto &Subsystem : Subsystems)
-  {
-    if (Verbosity() >= VERBOSITY_EVEN_MORE)
-    {
-      std::cout << "Fun4AllServer::process_event Resetting Event " << Subsystem.first->Name() << std::endl;
-    }
-    Subsystem.first->ResetEvent(Subsystem.second);
-  }
-  for (auto &syncman : SyncManagers)
-  {
-    if (Verbosity() >= VERBOSITY_EVEN_MORE)
-    {
-      std::cout << "Fun4AllServer::process_event Resetting Event for Sync Manager " << syncman->Name() << std::endl;
-    }
-    syncman->ResetEvent();
-  }
-  Fun4AllMonitoring::instance()->Snapshot("Event");
-  ResetNodeTree();
-  return 0;
 }
 
 int Fun4AllServer::ResetNodeTree()
@@ -1053,6 +1104,8 @@ int Fun4AllServer::MakeNodesPersistent(PHCompositeNode *startNode)  // NOLINT(mi
 
 int Fun4AllServer::EndRun(const int runno)
 {
+  // events processed in parallel belong to the run which is ending
+  CompleteEvents(true);
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>>::iterator iter;
   gROOT->cd(default_Tdirectory.c_str());
   std::string currdir = gDirectory->GetPath();
@@ -1106,6 +1159,7 @@ int Fun4AllServer::End()
 {
   recoConsts *rc = recoConsts::instance();
   EndRun(rc->get_IntFlag("RUNNUMBER"));  // call SubsysReco EndRun methods for current run
+  StopWorkers();
   int i = 0;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>>::iterator iter;
   gROOT->cd(default_Tdirectory.c_str());
@@ -1206,6 +1260,10 @@ int Fun4AllServer::End()
     std::cout << "*******************************************************************************" << std::endl;
     std::cout << "*******************************************************************************" << std::endl;
   }
+  if (ffaprofiler->Enabled())
+  {
+    ffaprofiler->WriteOutFile();
+  }
 
   return i;
 }
@@ -1439,6 +1497,8 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
   int iret = 0;
   int icnt = 0;
   int icnt_good = 0;
+  const int good_events_start = m_GoodEventsCompleted;
+  m_ParallelAbort = 0;
   std::vector<Fun4AllSyncManager *>::const_iterator iter;
   while (!iret)
   {
@@ -1547,7 +1607,7 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
       Verbosity(++iverb);
     }
 
-    iret = process_event();
+    iret = (m_NWorkerThreads > 0) ? process_event_parallel() : process_event();
 
     if (icnt == 0 && Verbosity() > VERBOSITY_QUIET)
     {
@@ -1560,12 +1620,16 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
 
     if (require_nevents)
     {
-      if (std::find(RetCodes.begin(),
+      // in parallel mode only events which are written out are known to be good,
+      // they are counted when completed
+      if (m_EventSlots.empty() &&
+          std::find(RetCodes.begin(),
                     RetCodes.end(),
                     static_cast<int>(Fun4AllReturnCodes::ABORTEVENT)) == RetCodes.end())
       {
-        icnt_good++;
+        m_GoodEventsCompleted++;
       }
+      icnt_good = m_GoodEventsCompleted - good_events_start;
       if (iret || (nevnts > 0 && icnt_good >= nevnts))
       {
         break;
@@ -1576,6 +1640,15 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
       break;
     }
   }
+  if (!m_EventSlots.empty())
+  {
+    // write out the events still in flight, an aborted run takes precedence
+    int ret = CompleteEvents(true);
+    if (ret)
+    {
+      iret = ret;
+    }
+  }
   return iret;
 }
 
@@ -1817,6 +1890,26 @@ void Fun4AllServer::PrintMemoryTracker(const std::string &name)
   return;
 }
 
+void Fun4AllServer::EnableProfiling(const bool b)
+{
+  ffaprofiler->Enable(b);
+  if (b && !ffaprofiler->TracksAllocations())
+  {
+    std::cout << "Fun4AllServer::EnableProfiling: allocations are not counted, "
+              << "preload libfun4all_mallochook.so to enable" << std::endl;
+  }
+}
+
+void Fun4AllServer::ProfileOutFileName(const std::string &fname)
+{
+  ffaprofiler->OutFileName(fname);
+}
+
+void Fun4AllServer::PrintProfile(const std::string &name) const
+{
+  ffaprofiler->Print(name);
+}
+
 int Fun4AllServer::UpdateRunNode()
 {
   int iret{Fun4AllReturnCodes::EVENT_OK};
@@ -1826,3 +1919,534 @@ int Fun4AllServer::UpdateRunNode()
   }
   return iret;
 }
+
+int Fun4AllServer::process_event_parallel()
+{
+  if (m_EventSlots.empty())
+  {
+    if (!ParallelCapable())
+    {
+      m_NWorkerThreads = 0;
+      return process_event();
+    }
+    StartWorkers();
+  }
+  else if (!SharableTopNodes())
+  {
+    // a per event node appeared under TOP, finish the events in flight and continue serially
+    StopWorkers();
+    m_NWorkerThreads = 0;
+    std::cout << "Fun4AllServer: processing events serially from now on" << std::endl;
+    if (m_ParallelAbort)
+    {
+      return m_ParallelAbort;
+    }
+    return process_event();
+  }
+  eventcounter++;
+  if (unregistersubsystem)
+  {
+    CompleteEvents(true);
+    unregisterSubsystemsNow();
+  }
+
+  // find an idle worker, writing out completed events in order meanwhile
+  EventSlot *slot = nullptr;
+  while (!slot)
+  {
+    int iret = CompleteEvents(false);
+    if (iret)
+    {
+      return iret;
+    }
+    std::unique_lock<std::mutex> lock(m_SlotMutex);
+    for (auto &eventslot : m_EventSlots)
+    {
+      if (eventslot->state == EventSlot::IDLE)
+      {
+        slot = eventslot.get();
+        break;
+      }
+    }
+    if (!slot)
+    {
+      // all workers busy, wait for the oldest event or for a worker done with its reset
+      m_SlotCondition.wait(lock, [this]
+                           {
+        for (auto &eventslot : m_EventSlots)
+        {
+          if (eventslot->state == EventSlot::IDLE ||
+              (eventslot->state == EventSlot::DONE && eventslot->sequence == m_NextToComplete))
+          {
+            return true;
+          }
+        }
+        return false; });
+    }
+  }
+
+  // copy the event into the worker node tree
+  PHNodeIterator iter(TopNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  ShareTopNodes(slot);
+  slot->dstNode = CopyNodeTree(dstNode);
+  slot->topNode->addNode(slot->dstNode);
+  slot->sequence = m_NextSequence++;
+  slot->eventnumber = eventnumber;
+
+  // the TOP node tree is ready for the next input event
+  for (auto &syncman : SyncManagers)
+  {
+    syncman->ResetEvent();
+  }
+  ResetNodeTree();
+
+  {
+    std::lock_guard<std::mutex> lock(m_SlotMutex);
+    slot->state = EventSlot::QUEUED;
+  }
+  m_SlotCondition.notify_all();
+  return 0;
+}
+
+bool Fun4AllServer::ParallelCapable()
+{
+  bool capable = true;
+  for (auto &Subsystem : Subsystems)
+  {
+    if (!Subsystem.first->ThreadSafe())
+    {
+      std::cout << "Fun4AllServer: " << Subsystem.first->Name() << " is not thread safe" << std::endl;
+      capable = false;
+    }
+    if (Subsystem.second != TopNode)
+    {
+      std::cout << "Fun4AllServer: " << Subsystem.first->Name() << " is not registered under TOP" << std::endl;
+      capable = false;
+    }
+  }
+  PHNodeIterator iter(TopNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << "Fun4AllServer: no DST node" << std::endl;
+    capable = false;
+  }
+  else if (!CopyableNodeTree(dstNode))
+  {
+    capable = false;
+  }
+  if (!SharableTopNodes())
+  {
+    capable = false;
+  }
+  if (!capable)
+  {
+    std::cout << "Fun4AllServer: cannot use " << m_NWorkerThreads << " worker threads, processing events serially" << std::endl;
+  }
+  return capable;
+}
+
+// top level nodes other than DST are shared with the workers. Only the RUN and PAR nodes can be,
+// any other node (e.g. the PRDF node of Fun4AllPrdfInputManager) is replaced or reset
+// for the next input event while the workers still read it
+bool Fun4AllServer::SharableTopNodes()
+{
+  bool sharable = true;
+  PHNodeIterator iter(TopNode);
+  PHPointerListIterator<PHNode> iterat(iter.ls());
+  PHNode *thisNode;
+  while ((thisNode = iterat()))
+  {
+    const std::string &name = thisNode->getName();
+    if (name == "DST")
+    {
+      continue;
+    }
+    if (thisNode->getType() == "PHCompositeNode" && (name == "RUN" || name == "PAR") &&
+        std::find(ResetNodeList.begin(), ResetNodeList.end(), name) == ResetNodeList.end())
+    {
+      continue;
+    }
+    std::cout << "Fun4AllServer: top node " << name << " changes with every event and cannot be shared with worker threads" << std::endl;
+    sharable = false;
+  }
+  return sharable;
+}
+
+bool Fun4AllServer::CopyableNodeTree(PHCompositeNode *source)  // NOLINT(misc-no-recursion)
+{
+  bool copyable = true;
+  PHNodeIterator nodeiter(source);
+  PHPointerListIterator<PHNode> iterat(nodeiter.ls());
+  PHNode *thisNode;
+  while ((thisNode = iterat()))
+  {
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      copyable &= CopyableNodeTree(static_cast<PHCompositeNode *>(thisNode));
+    }
+    else if (thisNode->getType() != "PHIODataNode" || thisNode->getObjectType() != "PHObject")
+    {
+      std::cout << "Fun4AllServer: node " << thisNode->getName() << " cannot be copied to worker threads" << std::endl;
+      copyable = false;
+    }
+    else
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      PHObject *data = static_cast<PHIODataNode<PHObject> *>(thisNode)->peekData();
+      // class version 0 means no I/O, the streamer would not copy anything
+      if (data && data->IsA()->GetClassVersion() <= 0)
+      {
+        std::cout << "Fun4AllServer: node " << thisNode->getName() << " of class " << data->ClassName()
+                  << " has no streamer and cannot be copied to worker threads" << std::endl;
+        copyable = false;
+      }
+    }
+  }
+  return copyable;
+}
+
+PHCompositeNode *Fun4AllServer::CopyNodeTree(PHCompositeNode *source)  // NOLINT(misc-no-recursion)
+{
+  PHCompositeNode *copy = new PHCompositeNode(source->getName());
+  PHNodeIterator nodeiter(source);
+  PHPointerListIterator<PHNode> iterat(nodeiter.ls());
+  PHNode *thisNode;
+  while ((thisNode = iterat()))
+  {
+    PHNode *newNode = nullptr;
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      newNode = CopyNodeTree(static_cast<PHCompositeNode *>(thisNode));
+    }
+    else
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      PHObject *data = static_cast<PHIODataNode<PHObject> *>(thisNode)->peekData();
+      if (!data)
+      {
+        continue;
+      }
+      newNode = new PHIODataNode<PHObject>(StreamerCopy(data), thisNode->getName(), thisNode->getObjectType());
+    }
+    newNode->setResetFlag(thisNode->getResetFlag());
+    if (thisNode->isPersistent())
+    {
+      newNode->makePersistent();
+    }
+    else
+    {
+      newNode->makeTransient();
+    }
+    copy->addNode(newNode);
+  }
+  return copy;
+}
+
+// the modules of a worker use the copy, mark the nodes of the input tree they used
+// so the adaptive branch selection of the input managers keeps reading them
+void Fun4AllServer::MergeAccessed(PHCompositeNode *copy, PHCompositeNode *source)  // NOLINT(misc-no-recursion)
+{
+  PHNodeIterator copyiter(copy);
+  PHNodeIterator sourceiter(source);
+  PHPointerListIterator<PHNode> iterat(copyiter.ls());
+  PHNode *thisNode;
+  while ((thisNode = iterat()))
+  {
+    bool composite = (thisNode->getType() == "PHCompositeNode");
+    if (!composite && !thisNode->wasAccessed())
+    {
+      continue;
+    }
+    PHPointerListIterator<PHNode> sourceiterat(sourceiter.ls());
+    PHNode *sourceNode;
+    while ((sourceNode = sourceiterat()))
+    {
+      if (sourceNode->getName() == thisNode->getName())
+      {
+        break;
+      }
+    }
+    if (!sourceNode)
+    {
+      continue;
+    }
+    if (composite)
+    {
+      if (sourceNode->getType() == "PHCompositeNode")
+      {
+        MergeAccessed(static_cast<PHCompositeNode *>(thisNode), static_cast<PHCompositeNode *>(sourceNode));
+      }
+    }
+    else
+    {
+      sourceNode->markAccessed();
+    }
+  }
+}
+
+void Fun4AllServer::ShareTopNodes(EventSlot *slot)
+{
+  PHNodeIterator iter(TopNode);
+  PHNodeIterator slotiter(slot->topNode);
+  PHPointerListIterator<PHNode> iterat(iter.ls());
+  PHNode *thisNode;
+  while ((thisNode = iterat()))
+  {
+    if (thisNode->getName() == "DST" || slotiter.findFirst(thisNode->getType(), thisNode->getName()))
+    {
+      continue;
+    }
+    slot->topNode->addNode(thisNode);
+    thisNode->setParent(TopNode);  // the node stays owned by TOP
+  }
+}
+
+void Fun4AllServer::StartWorkers()
+{
+  ROOT::EnableThreadSafety();
+  m_StopWorkers = false;
+  for (int i = 0; i < m_NWorkerThreads; ++i)
+  {
+    auto slot = std::make_unique<EventSlot>();
+    slot->topNode = new PHCompositeNode("TOP");
+    slot->worker = std::thread(&Fun4AllServer::WorkerLoop, this, slot.get());
+    m_EventSlots.push_back(std::move(slot));
+  }
+  std::cout << "Fun4AllServer: processing events on " << m_NWorkerThreads << " worker threads" << std::endl;
+}
+
+void Fun4AllServer::StopWorkers()
+{
+  if (m_EventSlots.empty())
+  {
+    return;
+  }
+  CompleteEvents(true);
+  {
+    std::lock_guard<std::mutex> lock(m_SlotMutex);
+    m_StopWorkers = true;
+  }
+  m_SlotCondition.notify_all();
+  for (auto &slot : m_EventSlots)
+  {
+    slot->worker.join();
+    // take out the shared nodes before deleting the worker node tree
+    std::vector<PHNode *> shared;
+    PHNodeIterator iter(slot->topNode);
+    PHPointerListIterator<PHNode> iterat(iter.ls());
+    PHNode *thisNode;
+    while ((thisNode = iterat()))
+    {
+      shared.push_back(thisNode);
+    }
+    for (auto *node : shared)
+    {
+      static_cast<PHNode *>(slot->topNode)->forgetMe(node);
+    }
+    delete slot->topNode;
+  }
+  m_EventSlots.clear();
+}
+
+void Fun4AllServer::WorkerLoop(EventSlot *slot)
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_SlotMutex);
+      m_SlotCondition.wait(lock, [this, slot]
+                           { return m_StopWorkers || slot->state == EventSlot::QUEUED || slot->state == EventSlot::RESET; });
+      if (slot->state != EventSlot::QUEUED && slot->state != EventSlot::RESET)
+      {
+        return;
+      }
+    }
+    EventSlot::State next = EventSlot::DONE;
+    if (slot->state == EventSlot::QUEUED)
+    {
+      ProcessEventSlot(slot);
+    }
+    else
+    {
+      ResetEventSlot(slot);
+      next = EventSlot::IDLE;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_SlotMutex);
+      slot->state = next;
+    }
+    m_SlotCondition.notify_all();
+  }
+}
+
+// runs on a worker thread, same return code handling as process_event()
+void Fun4AllServer::ProcessEventSlot(EventSlot *slot)
+{
+  slot->retcodes.assign(Subsystems.size(), 0);
+  slot->status = Fun4AllReturnCodes::EVENT_OK;
+  slot->eventbad = false;
+  unsigned icnt = 0;
+  for (auto &Subsystem : Subsystems)
+  {
+    // gDirectory is thread local with ROOT thread safety enabled
+    std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
+    gROOT->cd(newdirname.c_str());
+    int retcode = 0;
+    try
+    {
+      Fun4AllProfiler::Probe probe;
+      if (ffaprofiler->Enabled())
+      {
+        probe = ffaprofiler->Start();
+      }
+      retcode = Subsystem.first->process_event(slot->topNode);
+      if (ffaprofiler->Enabled())
+      {
+        ffaprofiler->Stop(Subsystem.first->Name() + "_" + Subsystem.second->getName(), probe);
+      }
+    }
+    catch (const std::exception &e)
+    {
+      std::cout << PHWHERE << " caught exception thrown during process_event from "
+                << Subsystem.first->Name() << std::endl;
+      std::cout << "error: " << e.what() << std::endl;
+      gSystem->Exit(1);
+    }
+    catch (...)
+    {
+      std::cout << PHWHERE << " caught unknown type exception thrown during process_event from "
+                << Subsystem.first->Name() << std::endl;
+      exit(1);
+    }
+    slot->retcodes[icnt] = retcode;
+    if (retcode && retcode != Fun4AllReturnCodes::DISCARDEVENT)
+    {
+      slot->eventbad = true;
+      if (retcode == Fun4AllReturnCodes::ABORTEVENT ||
+          retcode == Fun4AllReturnCodes::ABORTRUN ||
+          retcode == Fun4AllReturnCodes::ABORTPROCESSING)
+      {
+        slot->status = retcode;
+      }
+      else
+      {
+        std::cout << "Fun4AllServer::Unknown return code: "
+                  << retcode << " from process_event method of "
+                  << Subsystem.first->Name() << ", this Run will be aborted" << std::endl;
+        slot->status = Fun4AllReturnCodes::ABORTRUN;
+      }
+      break;
+    }
+    icnt++;
+  }
+}
+
+// runs on a worker thread once its event is written out, as process_event() does after OutputEvent()
+void Fun4AllServer::ResetEventSlot(EventSlot *slot)
+{
+  for (auto &Subsystem : Subsystems)
+  {
+    Subsystem.first->ResetEvent(slot->topNode);
+  }
+
+  // drop the copy of the event
+  static_cast<PHNode *>(slot->topNode)->forgetMe(slot->dstNode);
+  delete slot->dstNode;
+  slot->dstNode = nullptr;
+}
+
+// write out completed events in their input order. With wait_all, wait for all events in flight
+// and for the workers to reset them
+int Fun4AllServer::CompleteEvents(const bool wait_all)
+{
+  while (!m_EventSlots.empty())
+  {
+    EventSlot *slot = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_SlotMutex);
+      for (auto &eventslot : m_EventSlots)
+      {
+        if (eventslot->state != EventSlot::IDLE && eventslot->sequence == m_NextToComplete)
+        {
+          slot = eventslot.get();
+          break;
+        }
+      }
+      if (!slot)
+      {
+        break;  // no event in flight
+      }
+      if (slot->state != EventSlot::DONE)
+      {
+        if (!wait_all)
+        {
+          break;
+        }
+        m_SlotCondition.wait(lock, [slot]
+                             { return slot->state == EventSlot::DONE; });
+      }
+    }
+    FinishEventSlot(slot);
+    m_NextToComplete++;
+  }
+  if (wait_all)
+  {
+    std::unique_lock<std::mutex> lock(m_SlotMutex);
+    m_SlotCondition.wait(lock, [this]
+                         {
+      for (auto &eventslot : m_EventSlots)
+      {
+        if (eventslot->state == EventSlot::RESET)
+        {
+          return false;
+        }
+      }
+      return true; });
+  }
+  return m_ParallelAbort;
+}
+
+void Fun4AllServer::FinishEventSlot(EventSlot *slot)
+{
+  if (slot->status != Fun4AllReturnCodes::EVENT_OK)
+  {
+    retcodesmap[slot->status]++;
+    if (slot->status == Fun4AllReturnCodes::ABORTRUN || slot->status == Fun4AllReturnCodes::ABORTPROCESSING)
+    {
+      std::cout << "Fun4AllServer::" << (slot->status == Fun4AllReturnCodes::ABORTRUN ? "Abort Run" : "Abort Processing")
+                << " in event " << slot->eventnumber << std::endl;
+      if (!m_ParallelAbort)
+      {
+        m_ParallelAbort = slot->status;
+      }
+    }
+  }
+  // events completed after an abort are dropped, as they would not have been processed serially
+  if (!slot->eventbad && !m_ParallelAbort)
+  {
+    retcodesmap[Fun4AllReturnCodes::EVENT_OK]++;
+    m_GoodEventsCompleted++;
+    RetCodes.swap(slot->retcodes);
+    int current_eventnumber = eventnumber;
+    eventnumber = slot->eventnumber;
+    OutputEvent(slot->dstNode);
+    eventnumber = current_eventnumber;
+    RetCodes.swap(slot->retcodes);
+  }
+  PHNodeIterator iter(TopNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (dstNode)
+  {
+    MergeAccessed(slot->dstNode, dstNode);
+  }
+  Fun4AllMonitoring::instance()->Snapshot("Event");
+
+  // the worker resets its event, while other workers may be processing theirs
+  {
+    std::lock_guard<std::mutex> lock(m_SlotMutex);
+    slot->state = EventSlot::RESET;
+  }
+  m_SlotCondition.notify_all();
+}
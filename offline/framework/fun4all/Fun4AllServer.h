@@ -9,15 +9,21 @@
 
 #include <phool/PHTimer.h>
 
+#include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>  // for pair
 #include <vector>
 
 class Fun4AllInputManager;
 class Fun4AllMemoryTracker;
+class Fun4AllProfiler;
 class Fun4AllSyncManager;
 class Fun4AllOutputManager;
 class PHCompositeNode;
@@ -112,11 +118,31 @@ class Fun4AllServer : public Fun4AllBase
   void KeepDBConnection(const int i = 1) { keep_db_connected = i; }
   void PrintTimer(const std::string &name = "");
   static void PrintMemoryTracker(const std::string &name = "");
+  //! per module cpu, wall clock, page fault and allocation profiling, see Fun4AllProfiler
+  void EnableProfiling(const bool b = true);
+  //! profile written at End(), json if the name ends in .json, csv otherwise
+  void ProfileOutFileName(const std::string &fname);
+  void PrintProfile(const std::string &name = "ALL") const;
   int RunNumber() const { return runnumber; }
   int EventCounter() const { return eventcounter; }
   std::map<const std::string, PHTimer>::const_iterator timer_begin() { return timer_map.begin(); }
   std::map<const std::string, PHTimer>::const_iterator timer_end() { return timer_map.end(); }
   int UpdateRunNode();
+
+  /*!
+    \brief process up to n events concurrently on n worker threads (0: serial, the default).
+    Input managers read events serially into the TOP node tree. The DST node of each event
+    is then copied into the node tree of a free worker, which also holds the RUN and PAR
+    nodes of TOP, shared between all workers. Output managers write the events in their
+    input order from the worker DST nodes, then each worker calls ResetEvent() on its own tree.
+    All subsystems must be registered under TOP and report SubsysReco::ThreadSafe(),
+    all nodes under DST must be PHIODataNodes, and TOP must not hold other per event nodes
+    (e.g. the PRDF node of Fun4AllPrdfInputManager), otherwise events are processed serially.
+    With require_nevents, up to n-1 events beyond the requested number may be processed
+  */
+  void SetWorkerThreads(const int n) { m_NWorkerThreads = n; }
+  int WorkerThreads() const { return m_NWorkerThreads; }
+
   void AddResetNodeName(const std::string &name) {ResetNodeList.emplace_back(name);}
 
  protected:
@@ -127,9 +153,51 @@ class Fun4AllServer : public Fun4AllBase
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
   int setRun(const int runno);
+  void OutputEvent(PHCompositeNode *dstNode);
+
+  //! an event processed by a worker thread in parallel mode
+  struct EventSlot
+  {
+    enum State
+    {
+      IDLE,
+      QUEUED,
+      DONE,
+      //! written out, to be reset by the worker
+      RESET
+    };
+    State state{IDLE};
+    //! worker node tree, the RUN and PAR nodes are shared with TOP
+    PHCompositeNode *topNode{nullptr};
+    //! copy of the TOP DST node for this event
+    PHCompositeNode *dstNode{nullptr};
+    uint64_t sequence{0};
+    int eventnumber{0};
+    int status{0};
+    bool eventbad{false};
+    std::vector<int> retcodes;
+    std::thread worker;
+  };
+
+  int process_event_parallel();
+  bool ParallelCapable();
+  void StartWorkers();
+  void StopWorkers();
+  void WorkerLoop(EventSlot *slot);
+  void ProcessEventSlot(EventSlot *slot);
+  void ResetEventSlot(EventSlot *slot);
+  int CompleteEvents(const bool wait_all);
+  void FinishEventSlot(EventSlot *slot);
+  void ShareTopNodes(EventSlot *slot);
+  bool SharableTopNodes();
+  static PHCompositeNode *CopyNodeTree(PHCompositeNode *source);
+  static bool CopyableNodeTree(PHCompositeNode *source);
+  static void MergeAccessed(PHCompositeNode *copy, PHCompositeNode *source);
+
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars{nullptr};
   Fun4AllMemoryTracker *ffamemtracker{nullptr};
+  Fun4AllProfiler *ffaprofiler{nullptr};
   Fun4AllHistoManager *ServerHistoManager{nullptr};
   PHTimeStamp *beginruntimestamp{nullptr};
   PHCompositeNode *TopNode{nullptr};
@@ -159,6 +227,18 @@ class Fun4AllServer : public Fun4AllBase
   std::vector<Fun4AllSyncManager *> SyncManagers;
   std::map<int, int> retcodesmap;
   std::map<const std::string, PHTimer> timer_map;
+
+  // parallel mode
+  int m_NWorkerThreads{0};
+  bool m_StopWorkers{false};
+  //! return code of an event which aborted the run or processing
+  int m_ParallelAbort{0};
+  int m_GoodEventsCompleted{0};
+  uint64_t m_NextSequence{0};
+  uint64_t m_NextToComplete{0};
+  std::vector<std::unique_ptr<EventSlot>> m_EventSlots;
+  std::mutex m_SlotMutex;
+  std::condition_variable m_SlotCondition;
 };
 
 #endif
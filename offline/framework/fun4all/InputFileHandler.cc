@@ -3,14 +3,119 @@
 
 #include <phool/phool.h>
 
-#include <TSystem.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 
+// background thread staging the upcoming files one after the other
+class InputFileHandler::Prefetcher
+{
+ public:
+  explicit Prefetcher(std::function<int(const std::string &, const std::string &)> stage)
+    : m_Stage(std::move(stage))
+    , m_Thread([this]
+               { loop(); })
+  {
+  }
+
+  ~Prefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Stop = true;
+    }
+    m_WorkCondition.notify_all();
+    m_Thread.join();
+  }
+
+  Prefetcher(const Prefetcher &) = delete;
+  Prefetcher &operator=(const Prefetcher &) = delete;
+
+  void schedule(const std::string &filename, const std::string &previous)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (m_Result.contains(filename))
+      {
+        return;
+      }
+      m_Result[filename] = PENDING;
+      m_Queue.emplace_back(filename, previous);
+    }
+    m_WorkCondition.notify_all();
+  }
+
+  //! wait until filename is staged, returns the staging return code
+  int wait(const std::string &filename)
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_DoneCondition.wait(lock, [this, &filename]
+                         { return m_Result[filename] != PENDING; });
+    const int iret = m_Result[filename];
+    m_Result.erase(filename);
+    return iret;
+  }
+
+ private:
+  static constexpr int PENDING = INT_MIN;
+
+  void loop()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (true)
+    {
+      m_WorkCondition.wait(lock, [this]
+                           { return m_Stop || !m_Queue.empty(); });
+      if (m_Stop)
+      {
+        return;
+      }
+      const auto [filename, previous] = m_Queue.front();
+      m_Queue.pop_front();
+      lock.unlock();
+      const int iret = m_Stage(filename, previous);
+      lock.lock();
+      m_Result[filename] = iret;
+      m_DoneCondition.notify_all();
+    }
+  }
+
+  std::function<int(const std::string &, const std::string &)> m_Stage;
+  std::mutex m_Mutex;
+  std::condition_variable m_WorkCondition;
+  std::condition_variable m_DoneCondition;
+  std::deque<std::pair<std::string, std::string>> m_Queue;
+  std::map<std::string, int> m_Result;
+  bool m_Stop{false};
+  std::thread m_Thread;  // last, started after everything else is initialized
+};
+
+InputFileHandler::InputFileHandler() = default;
+
+InputFileHandler::~InputFileHandler()
+{
+  if (m_NFilesOpened > 0 && (m_PrefetchDepth > 0 || !m_RunBeforeOpeningScript.empty()))
+  {
+    PrintStallStatistics();
+  }
+  // waits for a running opening script
+  m_Prefetcher.reset();
+}
+
 int InputFileHandler::AddFile(const std::string &filename)
 {
   if (GetVerbosity() > 0)
@@ -85,6 +190,8 @@ int InputFileHandler::AddListFile(const std::string &filename)
 
 int InputFileHandler::OpenNextFile()
 {
+  // the file read before, it is closed by now
+  const std::string finished = m_FileName;
   while (!m_FileList.empty())
   {
     std::list<std::string>::const_iterator iter = m_FileList.begin();
@@ -92,32 +199,123 @@ int InputFileHandler::OpenNextFile()
     {
       std::cout << PHWHERE << " opening next file: " << *iter << std::endl;
     }
-    if (!GetOpeningScript().empty())
+    auto start = std::chrono::steady_clock::now();
+    if (m_PrefetchDepth > 0)
+    {
+      SchedulePrefetch(false, finished);
+      if (m_Prefetcher->wait(*iter))
+      {
+        std::cout << PHWHERE << " RunBeforeOpening() failed" << std::endl;
+      }
+    }
+    else if (!GetOpeningScript().empty())
     {
       std::vector<std::string> stringvec;
       stringvec.push_back(*iter);
-      if (!m_FileName.empty())
+      if (!finished.empty())
       {
-        stringvec.push_back(m_FileName);
+        stringvec.push_back(finished);
       }
       if (RunBeforeOpening(stringvec))
       {
         std::cout << PHWHERE << " RunBeforeOpening() failed" << std::endl;
       }
     }
-    if (fileopen(*iter))
+    auto staged = std::chrono::steady_clock::now();
+    const double wait_time = std::chrono::duration<double>(staged - start).count();
+    m_StagingWaitTime += wait_time;
+    m_MaxStagingWaitTime = std::max(m_MaxStagingWaitTime, wait_time);
+    if (wait_time > 1e-3)
+    {
+      ++m_NStalls;
+    }
+    const int iret = fileopen(*iter);
+    m_OpenTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - staged).count();
+    if (iret)
     {
       std::cout << PHWHERE << " could not open file: " << *iter << std::endl;
       m_FileList.pop_front();
     }
     else
     {
+      ++m_NFilesOpened;
+      // the next files are staged while this one is read
+      if (m_PrefetchDepth > 0)
+      {
+        SchedulePrefetch(true, finished);
+      }
       return InputFileHandlerReturnCodes::SUCCESS;
     }
   }
   return InputFileHandlerReturnCodes::FAILURE;
 }
 
+void InputFileHandler::SchedulePrefetch(const bool skip_current, const std::string &finished)
+{
+  if (!m_Prefetcher)
+  {
+    m_Prefetcher = std::make_unique<Prefetcher>([this](const std::string &filename, const std::string &previous)
+                                                { return StageFile(filename, previous); });
+  }
+  // the head of the list is the file being opened (or read), followed by the n files to stage.
+  // The file being read is not finished, so the opening scripts of the files staged ahead
+  // get the last closed file as previous file
+  int nfiles = 0;
+  for (const auto &filename : m_FileList)
+  {
+    if (nfiles > m_PrefetchDepth)
+    {
+      break;
+    }
+    if (nfiles > 0 || !skip_current)
+    {
+      m_Prefetcher->schedule(filename, finished);
+    }
+    ++nfiles;
+  }
+}
+
+int InputFileHandler::StageFile(const std::string &filename, const std::string &previous)
+{
+  int iret = 0;
+  if (!m_RunBeforeOpeningScript.empty())
+  {
+    std::vector<std::string> stringvec;
+    stringvec.push_back(filename);
+    if (!previous.empty())
+    {
+      stringvec.push_back(previous);
+    }
+    iret = RunBeforeOpening(stringvec);
+  }
+  // ask the kernel to start reading the beginning of local files
+  static const off_t readahead_bytes = 64 * 1024 * 1024;
+  std::error_code ec;
+  if (std::filesystem::is_regular_file(filename, ec))
+  {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+      posix_fadvise(fd, 0, readahead_bytes, POSIX_FADV_WILLNEED);
+      close(fd);
+    }
+  }
+  return iret;
+}
+
+void InputFileHandler::PrintStallStatistics() const
+{
+  std::cout << "InputFileHandler: opened " << m_NFilesOpened << " files";
+  if (!m_FileListOpened.empty())
+  {
+    std::cout << " (last " << m_FileListOpened.back() << ")";
+  }
+  std::cout << " with prefetch depth " << m_PrefetchDepth << std::endl;
+  std::cout << "  waited " << m_StagingWaitTime << " s for staging (" << m_NStalls
+            << " stalls, longest " << m_MaxStagingWaitTime << " s), "
+            << m_OpenTime << " s in fileopen" << std::endl;
+}
+
 void InputFileHandler::Print(const std::string & /* what */) const
 {
   std::cout << "file list: " << std::endl;
@@ -190,7 +388,8 @@ int InputFileHandler::RunBeforeOpening(const std::vector<std::string> &stringvec
   {
     std::cout << PHWHERE << " running " << fullcmd << std::endl;
   }
-  unsigned int iret = gSystem->Exec(fullcmd.c_str());
+  // not gSystem->Exec(), this also runs on the prefetch thread
+  unsigned int iret = std::system(fullcmd.c_str());
 
   if (iret)
   {
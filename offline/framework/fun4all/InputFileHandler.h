@@ -3,14 +3,15 @@
 
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 
 class InputFileHandler
 {
  public:
-  InputFileHandler() = default;
-  virtual ~InputFileHandler() = default;
+  InputFileHandler();
+  virtual ~InputFileHandler();
   virtual int fileopen(const std::string & /*filename*/);  // { return 0; }
   virtual int fileclose() { return -1; }
 
@@ -39,7 +40,35 @@ class InputFileHandler
   const std::string &GetOpeningScriptArgs() const { return m_OpeningArgs; }
   int RunBeforeOpening(const std::vector<std::string> &stringvec);
 
+  //! stage (opening script and read ahead) the next n files on a background thread
+  /**
+   * the file itself is still opened by fileopen() on the calling thread,
+   * 0 (default) stages each file synchronously right before opening it.
+   * The previous file argument of the opening script is the last file closed
+   * when the staging was scheduled, never the file which is still being read
+   */
+  void SetPrefetchDepth(const int n) { m_PrefetchDepth = n; }
+  int GetPrefetchDepth() const { return m_PrefetchDepth; }
+  //! time spent in OpenNextFile waiting for staging and opening files
+  void PrintStallStatistics() const;
+
  private:
+  class Prefetcher;
+
+  //! run the opening script for filename and prime the page cache
+  int StageFile(const std::string &filename, const std::string &previous);
+  void SchedulePrefetch(const bool skip_current, const std::string &finished);
+
+  int m_PrefetchDepth{0};
+  std::unique_ptr<Prefetcher> m_Prefetcher;
+
+  //! stall statistics
+  unsigned int m_NFilesOpened{0};
+  unsigned int m_NStalls{0};
+  double m_StagingWaitTime{0};  // seconds
+  double m_MaxStagingWaitTime{0};
+  double m_OpenTime{0};
+
   int m_IsOpen{0};
   int m_Repeat{0};
   uint64_t m_Verbosity{0};
@@ -63,6 +63,18 @@ class SubsysReco : public Fun4AllBase
   /// For new rollover DSTs - we need to be able to update the Run Node before the End()
   virtual int UpdateRunNode(PHCompositeNode * /*topNode*/) { return 0; }
 
+  /** Return true if process_event() can be called concurrently for different events.
+      Used by the parallel mode of Fun4AllServer (Fun4AllServer::SetWorkerThreads()),
+      which calls process_event() of the same module instance from several threads,
+      each with its own node tree. The DST node of each tree holds a copy of the event,
+      the RUN and PAR nodes are shared and must only be read. ResetEvent() is called
+      on the same thread with the same node tree, while other events may be processed.
+      A thread safe module takes all event data from the topNode argument, does not
+      modify its members in process_event() or ResetEvent() and does not fill
+      histograms or ntuples.
+   */
+  virtual bool ThreadSafe() const { return false; }
+
 protected:
   /** ctor.
       @param name is the reference used inside the Fun4AllServer
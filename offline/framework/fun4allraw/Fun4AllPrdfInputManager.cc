@@ -1,5 +1,7 @@
 #include "Fun4AllPrdfInputManager.h"
 
+#include "MmapEventiterator.h"
+
 #include <fun4all/DBInterface.h>
 #include <fun4all/Fun4AllInputManager.h>  // for Fun4AllInputManager
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -70,7 +72,14 @@ int Fun4AllPrdfInputManager::fileopen(const std::string &filenam)
     std::cout << Name() << ": opening file " << FileName() << std::endl;
   }
   int status = 0;
-  m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  if (m_MemoryMapFlag)
+  {
+    m_EventIterator = new MmapEventiterator(fname, status, Verbosity());
+  }
+  else
+  {
+    m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  }
   m_EventsThisFile = 0;
   if (status)
   {
@@ -30,11 +30,14 @@ class Fun4AllPrdfInputManager : public Fun4AllInputManager
   int SyncIt(const SyncObject *mastersync) override;
   int HasSyncObject() const override { return 1; }
   std::string GetString(const std::string &what) const override;
+  //! read the files through a memory mapped, zero copy PRDF reader (local disk)
+  void MemoryMapFiles(const bool b = true) { m_MemoryMapFlag = b; }
 
  private:
   int m_Segment = -999;
   int m_EventsTotal = 0;
   int m_EventsThisFile = 0;
+  bool m_MemoryMapFlag = false;
   PHCompositeNode *m_topNode = nullptr;
   Event *m_Event = nullptr;
   Event *m_SaveEvent = nullptr;
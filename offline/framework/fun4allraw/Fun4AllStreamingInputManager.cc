@@ -1,5 +1,6 @@
 #include "Fun4AllStreamingInputManager.h"
 
+#include "InputFillWorkers.h"
 #include "InputManagerType.h"
 #include "MvtxRawDefs.h"
 #include "SingleMicromegasPoolInput.h"
@@ -37,6 +38,7 @@
 
 #include <TH1.h>
 #include <TH2.h>
+#include <TROOT.h>
 #include <TSystem.h>
 
 #include <algorithm>  // for max
@@ -45,7 +47,25 @@
 #include <cstdlib>
 #include <format>
 #include <iostream>  // for operator<<, basic_ostream, endl
-#include <utility>   // for pair
+#include <tuple>
+#include <utility>  // for pair
+
+namespace
+{
+  // hits handed to the Add*() methods by one input while its pool is filled
+  // on a worker thread. They are replayed on the calling thread afterwards
+  struct StagedHits
+  {
+    std::vector<std::pair<uint64_t, InttRawHit *>> intt;
+    std::vector<std::pair<uint64_t, MicromegasRawHit *>> micromegas;
+    std::vector<std::pair<uint64_t, MvtxRawHit *>> mvtx;
+    std::vector<std::tuple<uint64_t, uint16_t, uint32_t>> mvtx_feeid;
+    std::vector<std::pair<uint64_t, uint64_t>> mvtx_l1trg;
+    std::vector<std::pair<uint64_t, TpcRawHit *>> tpc;
+  };
+
+  thread_local StagedHits *t_staged{nullptr};
+}  // namespace
 
 Fun4AllStreamingInputManager::Fun4AllStreamingInputManager(const std::string &name, const std::string &dstnodename, const std::string &topnodename)
   : Fun4AllInputManager(name, dstnodename, topnodename)
@@ -61,6 +81,7 @@ Fun4AllStreamingInputManager::Fun4AllStreamingInputManager(const std::string &na
 
 Fun4AllStreamingInputManager::~Fun4AllStreamingInputManager()
 {
+  m_FillWorkers.reset();
   if (IsOpen())
   {
     fileclose();
@@ -112,14 +133,8 @@ Fun4AllStreamingInputManager::~Fun4AllStreamingInputManager()
   m_InttInputVector.clear();
 
   // TPC
-  for (auto const &mapiter : m_TpcRawHitMap)
-  {
-    for (auto *tpchititer : mapiter.second.TpcRawHitVector)
-    {
-      delete tpchititer;
-    }
-  }
-
+  // the hits belong to the raw hit pools of the TpcTimeFrameBuilders of the inputs,
+  // so the map is cleared before the inputs are deleted
   m_TpcRawHitMap.clear();
   for (auto *iter : m_TpcInputVector)
   {
@@ -494,6 +509,11 @@ void Fun4AllStreamingInputManager::AddGl1RawHit(uint64_t bclk, Gl1Packet *hit)
 
 void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
 {
+  if (t_staged)
+  {
+    t_staged->mvtx.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx hit to bclk 0x"
@@ -504,6 +524,11 @@ void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
 
 void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feeid, uint32_t detField)
 {
+  if (t_staged)
+  {
+    t_staged->mvtx_feeid.emplace_back(bclk, feeid, detField);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx feeid info to bclk 0x"
@@ -518,6 +543,11 @@ void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feei
 
 void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bco)
 {
+  if (t_staged)
+  {
+    t_staged->mvtx_l1trg.emplace_back(bclk, lv1Bco);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx L1Trg to bclk 0x"
@@ -528,6 +558,11 @@ void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bc
 
 void Fun4AllStreamingInputManager::AddInttRawHit(uint64_t bclk, InttRawHit *hit)
 {
+  if (t_staged)
+  {
+    t_staged->intt.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding intt hit to bclk 0x"
@@ -539,6 +574,11 @@ void Fun4AllStreamingInputManager::AddInttRawHit(uint64_t bclk, InttRawHit *hit)
 
 void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, MicromegasRawHit *hit)
 {
+  if (t_staged)
+  {
+    t_staged->micromegas.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding micromegas hit to bclk 0x"
@@ -549,6 +589,11 @@ void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, Micromegas
 
 void Fun4AllStreamingInputManager::AddTpcRawHit(uint64_t bclk, TpcRawHit *hit)
 {
+  if (t_staged)
+  {
+    t_staged->tpc.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding tpc hit to bclk 0x"
@@ -567,24 +612,7 @@ int Fun4AllStreamingInputManager::FillGl1()
       std::cout << "Fun4AllStreamingInputManager::FillGl1 - fill pool for " << iter->Name() << std::endl;
     }
     iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    CheckRunNumber(iter);
   }
   if (m_Gl1RawHitMap.empty())
   {
@@ -1238,6 +1266,94 @@ void Fun4AllStreamingInputManager::SetMvtxBcoRange(const unsigned int i)
   m_mvtx_bco_range = std::max(i, m_mvtx_bco_range);
 }
 
+void Fun4AllStreamingInputManager::SetFillThreads(const int n)
+{
+  if (n != m_FillThreads)
+  {
+    m_FillWorkers.reset();
+  }
+  m_FillThreads = n;
+}
+
+void Fun4AllStreamingInputManager::FillPools(const std::vector<SingleStreamingInput *> &inputs, const std::function<void(SingleStreamingInput *)> &fill)
+{
+  if (m_FillThreads <= 1 || inputs.size() < 2)
+  {
+    for (auto *iter : inputs)
+    {
+      fill(iter);
+    }
+  }
+  else
+  {
+    if (!m_FillWorkers)
+    {
+      ROOT::EnableThreadSafety();
+      m_FillWorkers = std::make_unique<InputFillWorkers>(m_FillThreads);
+    }
+    std::vector<StagedHits> staged(inputs.size());
+    m_FillWorkers->run(inputs.size(), [&inputs, &staged, &fill](size_t i)
+                       {
+      t_staged = &staged[i];
+      fill(inputs[i]);
+      t_staged = nullptr; });
+    // merge in registration order, which gives the same maps as the serial fill
+    for (const auto &hits : staged)
+    {
+      for (const auto &[bclk, hit] : hits.intt)
+      {
+        AddInttRawHit(bclk, hit);
+      }
+      for (const auto &[bclk, hit] : hits.micromegas)
+      {
+        AddMicromegasRawHit(bclk, hit);
+      }
+      for (const auto &[bclk, hit] : hits.mvtx)
+      {
+        AddMvtxRawHit(bclk, hit);
+      }
+      for (const auto &[bclk, feeid, detField] : hits.mvtx_feeid)
+      {
+        AddMvtxFeeIdInfo(bclk, feeid, detField);
+      }
+      for (const auto &[bclk, lv1Bco] : hits.mvtx_l1trg)
+      {
+        AddMvtxL1TrgBco(bclk, lv1Bco);
+      }
+      for (const auto &[bclk, hit] : hits.tpc)
+      {
+        AddTpcRawHit(bclk, hit);
+      }
+    }
+  }
+  for (auto *iter : inputs)
+  {
+    CheckRunNumber(iter);
+  }
+}
+
+void Fun4AllStreamingInputManager::CheckRunNumber(SingleStreamingInput *iter)
+{
+  if (m_RunNumber == 0)
+  {
+    m_RunNumber = iter->RunNumber();
+    SetRunNumber(m_RunNumber);
+  }
+  else
+  {
+    if (m_RunNumber != iter->RunNumber())
+    {
+      std::cout << PHWHERE << " Run Number mismatch, run is "
+                << m_RunNumber << ", " << iter->Name() << " reads "
+                << iter->RunNumber() << std::endl;
+      std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
+      Print("INPUTFILES");
+      gSystem->Exit(1);
+      exit(1);
+    }
+  }
+}
+
 int Fun4AllStreamingInputManager::FillInttPool()
 {
   uint64_t ref_bco_minus_range = 0;
@@ -1251,31 +1367,14 @@ int Fun4AllStreamingInputManager::FillInttPool()
     {
       iter->SetStandaloneMode(true);
     }
+  }
+  FillPools(m_InttInputVector, [this, ref_bco_minus_range](SingleStreamingInput *iter)
+            {
     if (Verbosity() > 0)
     {
       std::cout << "Fun4AllStreamingInputManager::FillInttPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
-    // iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
-  }
+    iter->FillPool(ref_bco_minus_range); });
   if (m_InttRawHitMap.empty())
   {
     std::cout << "InttRawHitMap is empty - we are done" << std::endl;
@@ -1292,32 +1391,13 @@ int Fun4AllStreamingInputManager::FillTpcPool()
     ref_bco_minus_range = m_RefBCO - m_tpc_negative_bco;
   }
 
-  for (auto *iter : m_TpcInputVector)
-  {
+  FillPools(m_TpcInputVector, [this, ref_bco_minus_range](SingleStreamingInput *iter)
+            {
     if (Verbosity() > 0)
     {
       std::cout << "Fun4AllStreamingInputManager::FillTpcPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
-  }
+    iter->FillPool(ref_bco_minus_range); });
   // if (m_TpcRawHitMap.empty())
   // {
   //   std::cout << "TpcRawHitMap is empty - we are done" << std::endl;
@@ -1328,32 +1408,13 @@ int Fun4AllStreamingInputManager::FillTpcPool()
 
 int Fun4AllStreamingInputManager::FillMicromegasPool()
 {
-  for (auto *iter : m_MicromegasInputVector)
-  {
+  FillPools(m_MicromegasInputVector, [this](SingleStreamingInput *iter)
+            {
     if (Verbosity() > 0)
     {
       std::cout << "Fun4AllStreamingInputManager::FillMicromegasPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
-  }
+    iter->FillPool(); });
   if (m_MicromegasRawHitMap.empty())
   {
     std::cout << "MicromegasRawHitMap is empty - we are done" << std::endl;
@@ -1365,32 +1426,13 @@ int Fun4AllStreamingInputManager::FillMicromegasPool()
 int Fun4AllStreamingInputManager::FillMvtxPool()
 {
   uint64_t ref_bco_minus_range = m_RefBCO < m_mvtx_negative_bco ? m_mvtx_negative_bco : m_RefBCO - m_mvtx_negative_bco;
-  for (auto *iter : m_MvtxInputVector)
-  {
+  FillPools(m_MvtxInputVector, [this, ref_bco_minus_range](SingleStreamingInput *iter)
+            {
     if (Verbosity() > 3)
     {
       std::cout << "Fun4AllStreamingInputManager::FillMvtxPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
-  }
+    iter->FillPool(ref_bco_minus_range); });
   if (m_MvtxRawHitMap.empty())
   {
     std::cout << "MvtxRawHitMap is empty - we are done" << std::endl;
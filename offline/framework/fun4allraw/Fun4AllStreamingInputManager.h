@@ -7,10 +7,15 @@
 
 #include <fun4all/Fun4AllInputManager.h>
 
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
+class InputFillWorkers;
 class SingleStreamingInput;
 class Gl1Packet;
 class InttRawHit;
@@ -69,6 +74,15 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
 
   void runMvtxTriggered(bool b = true) { m_mvtx_is_triggered = b; }
 
+  //! fill the pools of the inputs of one subsystem (e.g. the TPC EBDCs) concurrently
+  /**
+   * n <= 1 (default) fills them one after the other. Hits added by the inputs
+   * are staged per input and merged in registration order once all inputs are
+   * done, so the assembled events do not depend on the number of threads
+   */
+  void SetFillThreads(const int n);
+  int FillThreads() const { return m_FillThreads; }
+
  private:
   struct MvtxRawHitInfo
   {
@@ -103,6 +117,8 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   };
 
   void createQAHistos();
+  void FillPools(const std::vector<SingleStreamingInput *> &inputs, const std::function<void(SingleStreamingInput *)> &fill);
+  void CheckRunNumber(SingleStreamingInput *input);
 
   SyncObject *m_SyncObject{nullptr};
   PHCompositeNode *m_topNode{nullptr};
@@ -110,6 +126,7 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   uint64_t m_RefBCO{0};
 
   int m_RunNumber{0};
+  int m_FillThreads{0};
   unsigned int m_intt_bco_range{0};
   unsigned int m_intt_negative_bco{0};
   unsigned int m_micromegas_bco_range{0};
@@ -125,7 +142,7 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   bool m_mvtx_registered_flag{false};
   bool m_StreamingFlag{false};
   bool m_tpc_registered_flag{false};
-  bool m_mvtx_is_triggered{false};
+  std::atomic<bool> m_mvtx_is_triggered{false};
 
   std::vector<SingleStreamingInput *> m_Gl1InputVector;
   std::vector<SingleStreamingInput *> m_InttInputVector;
@@ -138,6 +155,7 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   std::map<uint64_t, MvtxRawHitInfo> m_MvtxRawHitMap;
   std::map<uint64_t, TpcRawHitInfo> m_TpcRawHitMap;
   std::map<int, std::map<int, uint64_t>> m_InttPacketFeeBcoMap;
+  std::unique_ptr<InputFillWorkers> m_FillWorkers;
 
   // QA histos
   TH1 *h_refbco_mvtx[12]{nullptr};
@@ -1,5 +1,6 @@
 #include "Fun4AllTriggeredInputManager.h"
 
+#include "InputFillWorkers.h"
 #include "SingleTriggeredInput.h"
 
 #include <fun4all/Fun4AllInputManager.h>  // for Fun4AllInputManager
@@ -24,6 +25,7 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <TROOT.h>
 #include <TSystem.h>
 
 #include <algorithm>  // for std::search
@@ -61,24 +63,16 @@ Fun4AllTriggeredInputManager::~Fun4AllTriggeredInputManager()
 int Fun4AllTriggeredInputManager::run(const int /*nevents*/)
 {
   m_Gl1TriggeredInput->FillPool();
-  for (auto *iter : m_TriggeredInputVector)
+  if (RunTriggeredInputs([](SingleTriggeredInput *input)
+                         { input->FillPool(); }))
   {
-    //    std::cout << "prdf input: " << iter->Name() << std::endl;
-    iter->FillPool();
-    if (iter->AllDone())
-    {
-      return -1;
-    }
+    return -1;
   }
   m_Gl1TriggeredInput->ReadEvent();
-  for (auto *iter : m_TriggeredInputVector)
+  if (RunTriggeredInputs([](SingleTriggeredInput *input)
+                         { input->ReadEvent(); }))
   {
-    //    std::cout << "prdf input: " << iter->Name() << std::endl;
-    iter->ReadEvent();
-    if (iter->AllDone())
-    {
-      return -1;
-    }
+    return -1;
   }
 
   if (m_RunNumber == 0)
@@ -98,6 +92,40 @@ int Fun4AllTriggeredInputManager::run(const int /*nevents*/)
   return 0;
 }
 
+void Fun4AllTriggeredInputManager::SetFillThreads(const int n)
+{
+  if (n != m_FillThreads)
+  {
+    m_FillWorkers.reset();
+  }
+  m_FillThreads = n;
+}
+
+bool Fun4AllTriggeredInputManager::RunTriggeredInputs(const std::function<void(SingleTriggeredInput *)> &fcn)
+{
+  if (m_FillThreads <= 1 || m_TriggeredInputVector.size() < 2)
+  {
+    for (auto *iter : m_TriggeredInputVector)
+    {
+      fcn(iter);
+      if (iter->AllDone())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (!m_FillWorkers)
+  {
+    ROOT::EnableThreadSafety();
+    m_FillWorkers = std::make_unique<InputFillWorkers>(m_FillThreads);
+  }
+  m_FillWorkers->run(m_TriggeredInputVector.size(), [this, &fcn](size_t i)
+                     { fcn(m_TriggeredInputVector[i]); });
+  return std::any_of(m_TriggeredInputVector.begin(), m_TriggeredInputVector.end(), [](const SingleTriggeredInput *input)
+                     { return input->AllDone(); });
+}
+
 int Fun4AllTriggeredInputManager::fileclose()
 {
   // for (auto iter : m_TriggerInputVector)
@@ -7,13 +7,16 @@
 
 #include <Event/phenixTypes.h>
 
+#include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 class Event;
+class InputFillWorkers;
 class SinglePrdfInput;
 class CaloPacket;
 class Gl1Packet;
@@ -46,14 +49,29 @@ class Fun4AllTriggeredInputManager : public Fun4AllInputManager
   void EventNumber(const int i) { m_EventNumber = i; }
   int EventNumber() const { return m_EventNumber; }
 
+  //! fill the pools of the SEB inputs and assemble their packets concurrently
+  /**
+   * n <= 1 (default) handles them one after the other. The Gl1 input always
+   * runs first since the SEB inputs align their clocks against it, each SEB
+   * input only writes its own packet nodes
+   */
+  void SetFillThreads(const int n);
+  int FillThreads() const { return m_FillThreads; }
+
  private:
+  //! calls fcn for all SEB inputs, returns true if one of them is done
+  bool RunTriggeredInputs(const std::function<void(SingleTriggeredInput *)> &fcn);
+
+
   int m_RunNumber{0};
   int m_EventNumber{0};
+  int m_FillThreads{0};
   std::set<int> m_Gl1DroppedEvent;
   SingleTriggeredInput *m_Gl1TriggeredInput{nullptr};
   std::vector<SingleTriggeredInput *> m_TriggeredInputVector;
   SyncObject *m_SyncObject{nullptr};
   PHCompositeNode *m_topNode{nullptr};
+  std::unique_ptr<InputFillWorkers> m_FillWorkers;
 };
 
 #endif
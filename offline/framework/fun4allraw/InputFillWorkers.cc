@@ -0,0 +1,72 @@
+#include "InputFillWorkers.h"
+
+InputFillWorkers::InputFillWorkers(const int nthreads)
+{
+  for (int i = 1; i < nthreads; i++)
+  {
+    m_Threads.emplace_back([this]
+                           { loop(); });
+  }
+}
+
+InputFillWorkers::~InputFillWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_CvWork.notify_all();
+  for (auto &thr : m_Threads)
+  {
+    thr.join();
+  }
+}
+
+void InputFillWorkers::run(const size_t n, const std::function<void(size_t)> &fcn)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Job = &fcn;
+    m_NJobs = n;
+    m_Next = 0;
+    m_Pending = n;
+  }
+  m_CvWork.notify_all();
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  work(lock);
+  m_CvDone.wait(lock, [this]
+                { return m_Pending == 0; });
+  m_Job = nullptr;
+  m_NJobs = 0;
+}
+
+void InputFillWorkers::loop()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (true)
+  {
+    m_CvWork.wait(lock, [this]
+                  { return m_Stop || m_Next < m_NJobs; });
+    if (m_Stop)
+    {
+      return;
+    }
+    work(lock);
+  }
+}
+
+void InputFillWorkers::work(std::unique_lock<std::mutex> &lock)
+{
+  while (m_Next < m_NJobs)
+  {
+    const size_t ijob = m_Next++;
+    const std::function<void(size_t)> *fcn = m_Job;
+    lock.unlock();
+    (*fcn)(ijob);
+    lock.lock();
+    if (--m_Pending == 0)
+    {
+      m_CvDone.notify_all();
+    }
+  }
+}
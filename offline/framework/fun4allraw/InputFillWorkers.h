@@ -0,0 +1,47 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALLRAW_INPUTFILLWORKERS_H
+#define FUN4ALLRAW_INPUTFILLWORKERS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! persistent threads used by the input managers to fill the pools of
+//! their inputs concurrently
+/**
+ * nthreads includes the calling thread, which takes jobs as well while it
+ * waits for run() to finish
+ */
+class InputFillWorkers
+{
+ public:
+  explicit InputFillWorkers(const int nthreads);
+  ~InputFillWorkers();
+
+  InputFillWorkers(const InputFillWorkers &) = delete;
+  InputFillWorkers &operator=(const InputFillWorkers &) = delete;
+
+  //! call fcn(0) ... fcn(n-1), returns when all of them are done
+  void run(const size_t n, const std::function<void(size_t)> &fcn);
+
+ private:
+  void loop();
+  //! runs jobs until none are left, the lock is released while a job runs
+  void work(std::unique_lock<std::mutex> &lock);
+
+  std::vector<std::thread> m_Threads;
+  std::mutex m_Mutex;
+  std::condition_variable m_CvWork;
+  std::condition_variable m_CvDone;
+  const std::function<void(size_t)> *m_Job{nullptr};
+  size_t m_NJobs{0};
+  size_t m_Next{0};
+  size_t m_Pending{0};
+  bool m_Stop{false};
+};
+
+#endif
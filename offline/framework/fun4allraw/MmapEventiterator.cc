@@ -0,0 +1,214 @@
+#include "MmapEventiterator.h"
+
+#include <phool/phool.h>
+
+#include <Event/A_Event.h>
+#include <Event/fileEventiterator.h>
+#include <Event/phenixTypes.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace
+{
+  // uncompressed PRDF buffers: a header (length in bytes, marker, buffer
+  // sequence, run number) followed by the events, each starting with its
+  // length in 32 bit words. Buffers are padded to multiples of the block size
+  constexpr uint32_t BufferMarker = 0xffffc0c0U;
+  constexpr size_t BufferBlockSize = 8192;
+  constexpr size_t BufferHeaderWords = 4;
+  constexpr size_t EventHeaderWords = 8;
+
+  // A_Event which keeps the mapping it points into alive
+  class MappedEvent : public A_Event
+  {
+   public:
+    MappedEvent(PHDWORD *data, std::shared_ptr<void> mapping)
+      : A_Event(data)
+      , m_Mapping(std::move(mapping))
+    {
+    }
+
+    // the mapped data stays valid as long as this event exists
+    int convert() override { return 0; }
+
+   private:
+    std::shared_ptr<void> m_Mapping;
+  };
+}  // namespace
+
+MmapEventiterator::MmapEventiterator(const std::string &filename, int &status, const int verbosity)
+  : m_FileName(filename)
+  , m_IdString("MmapEventiterator reading from " + filename)
+  , m_Verbosity(verbosity)
+{
+  status = 0;
+  if (!mapFile())
+  {
+    if (m_Verbosity > 0)
+    {
+      std::cout << "MmapEventiterator: " << m_FileName
+                << " cannot be read in place (compressed or unexpected buffers), reading it with fileEventiterator" << std::endl;
+    }
+    fallBack(status);
+  }
+}
+
+MmapEventiterator::~MmapEventiterator() = default;
+
+const char *MmapEventiterator::getIdString() const
+{
+  return m_IdString.c_str();
+}
+
+void MmapEventiterator::identify(std::ostream &os) const
+{
+  os << getIdString() << std::endl;
+}
+
+Event *MmapEventiterator::getNextEvent()
+{
+  if (m_Fallback)
+  {
+    return m_Fallback->getNextEvent();
+  }
+  if (!m_Mapping)
+  {
+    return nullptr;
+  }
+  char *base = static_cast<char *>(m_Mapping.get());
+  while (true)
+  {
+    PHDWORD *buffer = reinterpret_cast<PHDWORD *>(base + m_BufferOffset);
+    if (m_CurrentWord + EventHeaderWords <= m_BufferWords)
+    {
+      PHDWORD *evt = buffer + m_CurrentWord;
+      const size_t evtwords = evt[0];
+      if (evtwords >= EventHeaderWords && m_CurrentWord + evtwords <= m_BufferWords)
+      {
+        m_CurrentWord += evtwords;
+        m_EventsRead++;
+        prefetch(m_BufferOffset + m_CurrentWord * sizeof(PHDWORD));
+        return new MappedEvent(evt, m_Mapping);
+      }
+    }
+    // this buffer is exhausted (the rest is padding), go to the next block
+    const size_t bufbytes = m_BufferWords * sizeof(PHDWORD);
+    const size_t next = m_BufferOffset + (bufbytes + BufferBlockSize - 1) / BufferBlockSize * BufferBlockSize;
+    const int iret = setBuffer(next);
+    if (iret == 0)
+    {
+      return nullptr;
+    }
+    if (iret < 0)
+    {
+      std::cout << PHWHERE << " buffer at byte " << next << " of " << m_FileName
+                << " cannot be read in place, continuing with fileEventiterator" << std::endl;
+      int status = 0;
+      fallBack(status);
+      if (status)
+      {
+        return nullptr;
+      }
+      return m_Fallback->getNextEvent();
+    }
+  }
+}
+
+bool MmapEventiterator::mapFile()
+{
+  const int fd = open(m_FileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat filestat
+  {
+  };
+  if (fstat(fd, &filestat) != 0 || filestat.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+  m_FileSize = filestat.st_size;
+  // a private writable mapping, decoders modifying their packets in place
+  // get a private copy of the touched pages instead of a segfault
+  void *addr = mmap(nullptr, m_FileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+  {
+    return false;
+  }
+  const size_t size = m_FileSize;
+  m_Mapping = std::shared_ptr<void>(addr, [size](void *ptr)
+                                    { munmap(ptr, size); });
+  madvise(addr, m_FileSize, MADV_SEQUENTIAL);
+  if (setBuffer(0) <= 0)
+  {
+    m_Mapping.reset();
+    return false;
+  }
+  prefetch(0);
+  return true;
+}
+
+int MmapEventiterator::setBuffer(const size_t offset)
+{
+  if (offset + BufferHeaderWords * sizeof(PHDWORD) > m_FileSize)
+  {
+    return 0;
+  }
+  const PHDWORD *header = reinterpret_cast<const PHDWORD *>(static_cast<const char *>(m_Mapping.get()) + offset);
+  const size_t bufbytes = header[0];
+  if (bufbytes == 0)  // zero padding at the end of the file
+  {
+    return 0;
+  }
+  if (header[1] != BufferMarker || bufbytes < BufferHeaderWords * sizeof(PHDWORD) || offset + bufbytes > m_FileSize)
+  {
+    return -1;
+  }
+  m_BufferOffset = offset;
+  m_BufferWords = bufbytes / sizeof(PHDWORD);
+  m_CurrentWord = BufferHeaderWords;
+  return 1;
+}
+
+void MmapEventiterator::fallBack(int &status)
+{
+  // events handed out so far keep their own reference to the mapping
+  m_Mapping.reset();
+  m_Fallback = std::make_unique<fileEventiterator>(m_FileName.c_str(), status);
+  if (status)
+  {
+    m_Fallback.reset();
+    return;
+  }
+  for (size_t i = 0; i < m_EventsRead; i++)
+  {
+    delete m_Fallback->getNextEvent();
+  }
+}
+
+void MmapEventiterator::prefetch(const size_t offset)
+{
+  // ask for the next window once half of the previous one is used
+  if (m_PrefetchBytes == 0 || offset + m_PrefetchBytes / 2 < m_PrefetchedUntil)
+  {
+    return;
+  }
+  static const size_t pagesize = sysconf(_SC_PAGESIZE);
+  const size_t begin = std::max(offset, m_PrefetchedUntil) / pagesize * pagesize;
+  const size_t end = std::min(m_FileSize, offset + m_PrefetchBytes);
+  if (end > begin)
+  {
+    madvise(static_cast<char *>(m_Mapping.get()) + begin, end - begin, MADV_WILLNEED);
+  }
+  m_PrefetchedUntil = end;
+}
@@ -0,0 +1,72 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALLRAW_MMAPEVENTITERATOR_H
+#define FUN4ALLRAW_MMAPEVENTITERATOR_H
+
+#include <Event/Eventiterator.h>
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+
+class Event;
+
+//! Eventiterator reading a memory mapped, uncompressed PRDF file
+/**
+ * The buffer and event headers are walked in place and the events are
+ * handed out as A_Events pointing into the mapping, so neither the file
+ * read nor Event::convert() copies the event data. Packets decoded from
+ * them read the mapped pages directly. Every event keeps the mapping alive,
+ * events may outlive the iterator (the triggered inputs keep events across
+ * file boundaries).
+ *
+ * Pages ahead of the current event are requested with madvise so the
+ * kernel reads ahead while the events are decoded. Files with compressed
+ * or byte swapped buffers are read through a fileEventiterator instead.
+ */
+class MmapEventiterator : public Eventiterator
+{
+ public:
+  //! with verbosity > 0 a fallback to the fileEventiterator is reported
+  MmapEventiterator(const std::string &filename, int &status, const int verbosity = 0);
+  ~MmapEventiterator() override;
+
+  MmapEventiterator(const MmapEventiterator &) = delete;
+  MmapEventiterator &operator=(const MmapEventiterator &) = delete;
+
+  const char *getIdString() const override;
+  void identify(std::ostream &os = std::cout) const override;
+  Event *getNextEvent() override;
+
+  //! false if the file is read through the fileEventiterator fallback
+  bool Mapped() const { return m_Mapping != nullptr; }
+
+  //! number of bytes ahead of the current event requested from the kernel
+  void PrefetchBytes(const size_t n) { m_PrefetchBytes = n; }
+
+ private:
+  bool mapFile();
+  //! 1 if the buffer at offset can be read in place, 0 at the end of the file, -1 otherwise
+  int setBuffer(const size_t offset);
+  //! continues with a fileEventiterator after the events already read
+  void fallBack(int &status);
+  void prefetch(const size_t offset);
+
+  std::string m_FileName;
+  std::string m_IdString;
+  std::shared_ptr<void> m_Mapping;
+  std::unique_ptr<Eventiterator> m_Fallback;
+  size_t m_FileSize{0};
+  size_t m_EventsRead{0};
+  //! byte offset of the current buffer
+  size_t m_BufferOffset{0};
+  size_t m_BufferWords{0};
+  //! offset of the next event in 32 bit words from the start of the current buffer
+  size_t m_CurrentWord{0};
+  size_t m_PrefetchBytes{64UL * 1024UL * 1024UL};
+  size_t m_PrefetchedUntil{0};
+  int m_Verbosity{0};
+};
+
+#endif
@@ -24,6 +24,7 @@ class SingleGl1TriggeredInput : public SingleTriggeredInput
   void Print(const std::string &what = "ALL") const override;
   void CreateDSTNodes(Event *evt) override;
   uint64_t GetClock(Event *evt, int pid) override;
+  uint64_t PacketClock(Packet *pkt) override { return pkt->lValue(0, "BCO"); }
   int GetCurrentPacketNumber() const { return m_PacketNumber; }
   int GetLastPacketNumber() const { return m_LastPacketNumber; }
   const std::array<int, pooldepth>& GetGl1SkipArray() const { return m_Gl1SkipPerIndex; }
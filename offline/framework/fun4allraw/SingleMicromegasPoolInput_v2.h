@@ -61,6 +61,17 @@ class SingleMicromegasPoolInput_v2 : public SingleStreamingInput
   /// output file name for evaluation histograms
   void set_evaluation_outputfile(const std::string &outputfile) { m_evaluation_filename = outputfile; }
 
+  /// number of raw hits currently in the pool
+  size_t get_pool_hit_count() const
+  {
+    size_t count = 0;
+    for (const auto &[bco, hits] : m_MicromegasRawHitMap)
+    {
+      count += hits.size();
+    }
+    return count;
+  }
+
  private:
   //!@name decoding constants
   //@{
@@ -1,5 +1,7 @@
 #include "SingleStreamingInput.h"
 
+#include "MmapEventiterator.h"
+
 #include <fun4all/DBInterface.h>
 
 #include <phool/phool.h>
@@ -22,8 +24,16 @@ SingleStreamingInput::~SingleStreamingInput()
   delete m_EventIterator;
 }
 
+std::mutex &SingleStreamingInput::SharedStateMutex()
+{
+  static std::mutex shared_state_mutex;
+  return shared_state_mutex;
+}
+
 int SingleStreamingInput::fileopen(const std::string &filenam)
 {
+  // files are opened from FillPool, which may run on a worker thread
+  std::lock_guard<std::mutex> lock(SharedStateMutex());
   std::cout << PHWHERE << "trying to open " << filenam << std::endl;
   if (IsOpen())
   {
@@ -39,7 +49,14 @@ int SingleStreamingInput::fileopen(const std::string &filenam)
     std::cout << Name() << ": opening file " << FileName() << std::endl;
   }
   int status = 0;
-  m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  if (m_MemoryMapFlag)
+  {
+    m_EventIterator = new MmapEventiterator(fname, status, Verbosity());
+  }
+  else
+  {
+    m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  }
   m_EventsThisFile = 0;
   if (status)
   {
@@ -6,6 +6,7 @@
 
 #include <cstdint>  // for uint64_t
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -60,11 +61,19 @@ class SingleStreamingInput : public Fun4AllBase, public InputFileHandler
   const std::string &getHitContainerName() const { return m_rawHitContainerName; }
   const std::map<int, std::set<uint64_t>> &getFeeGTML1BCOMap() const { return m_FeeGTML1BCOMap; }
 
+  //! read the files through a memory mapped, zero copy PRDF reader (local disk)
+  void MemoryMapFiles(const bool b = true) { m_MemoryMapFlag = b; }
+  bool MemoryMapFiles() const { return m_MemoryMapFlag; }
+
   void SetStandaloneMode(bool mode) { m_standalone_mode = mode; }
   bool IsStandaloneMode() const { return m_standalone_mode; }  
   //! event assembly QA histograms
   virtual void createQAHistos() {}
 
+  //! serializes access to shared framework state (histogram manager, CDB, file catalog)
+  //! from FillPool, when inputs are filled on worker threads
+  static std::mutex &SharedStateMutex();
+
   //! event assembly QA for a given BCO
   /** TODO: check whether necessary */
   virtual void FillBcoQA(uint64_t /*gtm_bco*/) {};
@@ -123,6 +132,7 @@ class SingleStreamingInput : public Fun4AllBase, public InputFileHandler
   int m_EventsThisFile{0};
   int m_AllDone{0};
   int m_SubsystemEnum{0};
+  bool m_MemoryMapFlag{false};
   std::map<uint64_t, std::set<int>> m_BeamClockFEE;
   std::map<int, uint64_t> m_FEEBclkMap;
   std::set<uint64_t> m_BclkStack;
@@ -7,6 +7,7 @@
 #include <qautils/QAHistManagerDef.h>
 
 #include <ffarawobjects/TpcRawHitContainerv3.h>
+#include <ffarawobjects/TpcRawHitContainerv4.h>
 #include <ffarawobjects/TpcRawHitv3.h>
 
 #include <fun4all/Fun4AllHistoManager.h>
@@ -29,7 +30,9 @@
 #include <Event/Eventiterator.h>
 #include <Event/fileEventiterator.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
 
 SingleTpcTimeFrameInput::SingleTpcTimeFrameInput(const std::string &name)
@@ -114,11 +117,9 @@ SingleTpcTimeFrameInput::TimeTracker::~TimeTracker()
 void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
 {
   {
-    static bool first = true;
-    if (first)
+    static std::atomic<bool> first = true;
+    if (first.exchange(false))
     {
-      first = false;
-
       if (!m_SelectedPacketIDs.empty())
       {
         std::cout << "SingleTpcTimeFrameInput::" << Name() << " : note, only processing packets with ID: ";
@@ -291,6 +292,8 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
           std::cout << __PRETTY_FUNCTION__ << ": Creating TpcTimeFrameBuilder for packet id: " << packet_id << std::endl;
         }
 
+        // the builder registers histograms and reads the CDB
+        std::lock_guard<std::mutex> lock(SharedStateMutex());
         m_TpcTimeFrameBuilderMap[packet_id] = new TpcTimeFrameBuilder(packet_id);
         m_TpcTimeFrameBuilderMap[packet_id]->setVerbosity(Verbosity());
         m_TpcTimeFrameBuilderMap[packet_id]->fillBadFeeMap();
@@ -382,7 +385,14 @@ void SingleTpcTimeFrameInput::CreateDSTNode(PHCompositeNode *topNode)
   TpcRawHitContainer *tpchitcont = findNode::getClass<TpcRawHitContainer>(detNode, m_rawHitContainerName);
   if (!tpchitcont)
   {
-    tpchitcont = new TpcRawHitContainerv3();
+    if (m_ColumnarRawHits)
+    {
+      tpchitcont = new TpcRawHitContainerv4();
+    }
+    else
+    {
+      tpchitcont = new TpcRawHitContainerv3();
+    }
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(tpchitcont, m_rawHitContainerName, "PHObject");
     detNode->addNode(newNode);
   }
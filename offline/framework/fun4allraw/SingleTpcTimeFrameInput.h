@@ -37,6 +37,9 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
 
   void AddPacketID(const int packetID) { m_SelectedPacketIDs.insert(packetID); }
 
+  //! store the raw hits in a columnar TpcRawHitContainerv4 instead of a TpcRawHitContainerv3
+  void ColumnarRawHits(const bool b = true) { m_ColumnarRawHits = b; }
+
   void setDigitalCurrentDebugTTreeName(const std::string &name)
   {
     m_digitalCurrentDebugTTreeName = name;
@@ -49,6 +52,7 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
   unsigned int m_NumSpecialEvents{0};
   unsigned int m_BcoRange{0};
   unsigned int m_NegativeBco{0};
+  bool m_ColumnarRawHits{false};
 
   //! packet ID -> TimeFrame builder
   std::map<int, TpcTimeFrameBuilder *> m_TpcTimeFrameBuilderMap;
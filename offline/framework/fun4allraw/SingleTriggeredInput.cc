@@ -1,4 +1,6 @@
 #include "SingleTriggeredInput.h"
+
+#include "MmapEventiterator.h"
 #include "SingleGl1TriggeredInput.h"
 
 #include <ffarawobjects/CaloPacketContainerv1.h>
@@ -18,8 +20,10 @@
 
 #include <TSystem.h>
 
+#include <atomic>
 #include <cstdint>   // for uint64_t
 #include <iostream>  // for operator<<, basic_ostream, endl
+#include <memory>
 #include <ranges>
 #include <set>
 #include <unordered_set>
@@ -297,13 +301,24 @@ int SingleTriggeredInput::fileopen(const std::string& filenam)
     fileclose();
   }
   FileName(filenam);
-  std::string fname = DBInterface::instance()->location(FileName());
+  std::string fname;
+  {
+    std::lock_guard<std::mutex> lock(SharedStateMutex());
+    fname = DBInterface::instance()->location(FileName());
+  }
   if (Verbosity() > 0)
   {
     std::cout << Name() << ": opening file " << FileName() << std::endl;
   }
   int status = 0;
-  m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  if (m_MemoryMapFlag)
+  {
+    m_EventIterator = new MmapEventiterator(fname, status, Verbosity());
+  }
+  else
+  {
+    m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  }
   if (status)
   {
     delete m_EventIterator;
@@ -355,11 +370,10 @@ int SingleTriggeredInput::FillEventVector()
     m_bclkarray_map[pid][0] = tmp;
     m_bclkdiffarray_map[pid].fill(std::numeric_limits<uint64_t>::max());
 
-    static bool firstclockarray = true;
-    if (firstclockarray)
+    static std::atomic<bool> firstclockarray{true};
+    if (firstclockarray.exchange(false))
     {
       std::cout << "first clock call pid " << pid << " m_bclkarray_map[pid][0] : " << m_bclkarray_map[pid][0] << std::endl;
-      firstclockarray = false;
     }
 
     if (representative_pid == -1)
@@ -606,13 +620,24 @@ uint64_t SingleTriggeredInput::GetClock(Event* evt, int pid)
     std::cout << Name() << ": Missing packet " << pid << " in event " << evt->getEvtSequence() << std::endl;
     return std::numeric_limits<uint64_t>::max();
   }
-  uint64_t clkval = static_cast<uint64_t>(packet->lValue(0, "CLOCK"));
-  uint64_t clk = clkval & 0xFFFFFFFFU;
+  uint64_t clk = PacketClock(packet);
   delete packet;
   return clk;
 }
 
-void SingleTriggeredInput::FillPacketClock(Event* evt, Packet* pkt, size_t event_index)
+uint64_t SingleTriggeredInput::PacketClock(Packet* pkt)
+{
+  uint64_t clkval = static_cast<uint64_t>(pkt->lValue(0, "CLOCK"));
+  return clkval & 0xFFFFFFFFU;
+}
+
+std::mutex& SingleTriggeredInput::SharedStateMutex()
+{
+  static std::mutex mtx;
+  return mtx;
+}
+
+void SingleTriggeredInput::FillPacketClock(Event* /*evt*/, Packet* pkt, size_t event_index)
 {
   if (!pkt)
   {
@@ -657,7 +682,8 @@ void SingleTriggeredInput::FillPacketClock(Event* evt, Packet* pkt, size_t event
     return;
   }
 
-  uint64_t clk = GetClock(evt, pid);
+  // pkt is the packet pid of the event, no need to decode it again
+  uint64_t clk = PacketClock(pkt);
   if (clk == std::numeric_limits<uint64_t>::max())
   {
     std::cout << Name() << ": Bad clock for packet " << pid << " at event index " << event_index << std::endl;
@@ -669,12 +695,10 @@ void SingleTriggeredInput::FillPacketClock(Event* evt, Packet* pkt, size_t event
   uint64_t prev = clkarray[event_index];
   if (prev == std::numeric_limits<uint64_t>::max())
   {
-    static std::unordered_set<int> warned;
-
-    if (!warned.contains(pid))
+    if (!m_FirstPoolWarned.contains(pid))
     {
       std::cout << Name() << ": First pool for packet " << pid << " – skipping first diff because of no previous clock" << std::endl;
-      warned.insert(pid);
+      m_FirstPoolWarned.insert(pid);
     }
     else
     {
@@ -963,6 +987,8 @@ void SingleTriggeredInput::FillPool()
 
 void SingleTriggeredInput::CreateDSTNodes(Event* evt)
 {
+  // other inputs may be creating their nodes at the same time
+  std::lock_guard<std::mutex> lock(SharedStateMutex());
   std::string CompositeNodeName = "Packets";
   if (KeepMyPackets())
   {
@@ -1025,6 +1051,7 @@ void SingleTriggeredInput::CreateDSTNodes(Event* evt)
         detNode->addNode(newNode);
       }
     }
+    m_CaloPacketMap[packet_id] = calopacket;
     m_PacketShiftOffset.try_emplace(packet_id, 0);
     delete piter;
   }
@@ -1149,10 +1176,9 @@ int SingleTriggeredInput::FemEventNrClockCheck(OfflinePacket* pkt)
     }
     if (FemClockSet.size() == 1)
     {
-      static int icnt = 0;
-      if (icnt < 10)
+      static std::atomic<int> icnt{0};
+      if (icnt.fetch_add(1) < 10)
       {
-        icnt++;
         std::cout << "Packet " << calopkt->getIdentifier() << " has not unique event numbers"
                   << " but FEM Clock counters are identical" << std::endl;
       }
@@ -1162,10 +1188,9 @@ int SingleTriggeredInput::FemEventNrClockCheck(OfflinePacket* pkt)
       }
       return 1;
     }
-    static int icnt = 0;
-    if (icnt < 1000)
+    static std::atomic<int> icnt{0};
+    if (icnt.fetch_add(1) < 1000)
     {
-      icnt++;
       std::cout << "resetting packet " << calopkt->getIdentifier()
                 << " with fem event and clock mismatch" << std::endl;
       std::map<int, int> ClockMap;
@@ -1243,6 +1268,25 @@ int SingleTriggeredInput::ReadEvent()
       [](const std::pair<int, int>& p)
       { return p.second == 0; });
 
+  // decode all packets of each prdf event in one pass instead of searching
+  // the event for every packet id, unused ones are deleted with the map
+  std::map<Event*, std::map<int, std::unique_ptr<Packet>>> decoded;
+  for (auto& [pid, dq] : m_PacketEventDeque)
+  {
+    if (m_PacketAlignmentProblem[pid] || decoded.contains(dq.front()))
+    {
+      continue;
+    }
+    auto& packets = decoded[dq.front()];
+    for (Packet* pkt : dq.front()->getPacketVector())
+    {
+      if (!packets.try_emplace(pkt->getIdentifier(), pkt).second)  // duplicate packet id
+      {
+        delete pkt;
+      }
+    }
+  }
+
   std::set<Event*> events_to_delete;
   for (auto& [pid, dq] : m_PacketEventDeque)
   {
@@ -1252,24 +1296,30 @@ int SingleTriggeredInput::ReadEvent()
     }
 
     Event* evt = dq.front();
-    Packet* packet = evt->getPacket(pid);
-    int packet_id = packet->getIdentifier();
-    if (packet_id != pid)
+    auto& packets = decoded[evt];
+    auto pktiter = packets.find(pid);
+    if (pktiter == packets.end())
     {
-      std::cout << Name() << ": packet id mismatch... Should never happen. Abort combining" << std::endl;
+      std::cout << Name() << ": packet " << pid << " missing in prdf event... Should never happen. Abort combining" << std::endl;
       EventAlignmentProblem(1);
-      delete packet;
       return -1;
     }
+    std::unique_ptr<Packet> packet = std::move(pktiter->second);
+    packets.erase(pktiter);
+    int packet_id = pid;
 
-    CaloPacket* newhit = findNode::getClass<CaloPacket>(m_topNode, packet_id);
+    // the packet node objects are allocated once in CreateDSTNodes and reused
+    CaloPacket*& newhit = m_CaloPacketMap[packet_id];
+    if (!newhit)
+    {
+      newhit = findNode::getClass<CaloPacket>(m_topNode, packet_id);
+    }
     newhit->Reset();
     if (m_DitchPackets.contains(packet_id) && m_DitchPackets[packet_id].contains(0))
     {
       newhit->setStatus(OfflinePacket::PACKET_DROPPED);
       newhit->setIdentifier(packet_id);
       std::cout << "ditching packet " << packet_id << " from prdf event " << evt->getEvtSequence() << std::endl;
-      delete packet;
       continue;
     }
 
@@ -1290,7 +1340,7 @@ int SingleTriggeredInput::ReadEvent()
     {
       uint64_t prev_packet_clock = m_PreviousValidBCOMap[packet_id];
       newhit->setBCO(prev_packet_clock);
-      m_PreviousValidBCOMap[packet_id] = GetClock(evt, packet_id);
+      m_PreviousValidBCOMap[packet_id] = PacketClock(packet.get());
     }
     else
     {
@@ -1325,7 +1375,7 @@ int SingleTriggeredInput::ReadEvent()
         }
       }
     }
-    delete packet;
+    packet.reset();
     int iret = FemEventNrClockCheck(newhit);
     if (iret < 0)
     {
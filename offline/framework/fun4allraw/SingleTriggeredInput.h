@@ -15,11 +15,13 @@
 #include <fstream>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
+class CaloPacket;
 class Event;
 class Eventiterator;
 class OfflinePacket;
@@ -54,12 +56,17 @@ class SingleTriggeredInput : public Fun4AllBase, public InputFileHandler
   virtual SingleTriggeredInput *Gl1Input() { return m_Gl1Input; }
   virtual void Gl1Input(SingleTriggeredInput *input) { m_Gl1Input = input; }
   virtual uint64_t GetClock(Event *evt, int pid);
+  //! clock of an already decoded packet, saves decoding it a second time
+  virtual uint64_t PacketClock(Packet *pkt);
   virtual std::array<uint64_t, pooldepth>::const_iterator clkdiffbegin() { return m_bclkdiffarray.begin(); }
   virtual std::array<uint64_t, pooldepth>::const_iterator clkdiffend() { return m_bclkdiffarray.end(); }
   virtual std::array<uint64_t, pooldepth>::const_iterator beginclock() { return m_bclkarray.begin(); }
   virtual void KeepPackets() { m_KeepPacketsFlag = true; }
   virtual bool KeepMyPackets() const { return m_KeepPacketsFlag; }
   virtual void KeepPacket(const int packetnum) { m_KeepPacketSet.insert(packetnum); }
+  //! read the files through a memory mapped, zero copy PRDF reader (local disk)
+  void MemoryMapFiles(const bool b = true) { m_MemoryMapFlag = b; }
+  bool MemoryMapFiles() const { return m_MemoryMapFlag; }
   void topNode(PHCompositeNode *topNode) { m_topNode = topNode; }
   PHCompositeNode *topNode() { return m_topNode; }
   virtual void FakeProblemEvent(const int ievent) { m_ProblemEvent = ievent; }
@@ -87,6 +94,8 @@ class SingleTriggeredInput : public Fun4AllBase, public InputFileHandler
   std::map<int, std::array<uint64_t, pooldepth>> m_bclkdiffarray_map;
   std::set<int> m_PacketSet;
   static uint64_t ComputeClockDiff(uint64_t curr, uint64_t prev) { return (curr - prev) & 0xFFFFFFFF; }
+  //! serializes the node tree and file catalog access of inputs filled in parallel
+  static std::mutex &SharedStateMutex();
 
  private:
   Eventiterator *m_EventIterator{nullptr};
@@ -104,9 +113,11 @@ class SingleTriggeredInput : public Fun4AllBase, public InputFileHandler
   bool firstcall{true};
   bool firstclockcheck{true};
   bool m_KeepPacketsFlag{false};
+  bool m_MemoryMapFlag{false};
   bool m_packetclk_copy_runs{false};
   int64_t eventcounter{0};
   std::set<int> m_CorrectCopiedClockPackets;
+  std::map<int, CaloPacket *> m_CaloPacketMap;
   std::map<int, std::set<int>> m_DitchPackets;
   std::set<int> m_FEMEventNrSet;
   std::set<int> m_OverrideWithRepClock;
@@ -115,6 +126,7 @@ class SingleTriggeredInput : public Fun4AllBase, public InputFileHandler
   std::map<int, bool> m_PrevPoolLastDiffBad;
   std::map<int, uint64_t> m_PreviousValidBCOMap;
   std::unordered_set<int> m_KeepPacketSet;
+  std::unordered_set<int> m_FirstPoolWarned;
 };
 
 #endif
@@ -24,6 +24,7 @@
 #include <TTree.h>
 #include <TVector3.h>
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <limits>
@@ -52,7 +53,7 @@ TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
 
   m_hNorm = new TH1D(TString(m_HistoPrefix.c_str()) + "_Normalization",  //
                      TString(m_HistoPrefix.c_str()) + " Normalization;Items;Count",
-                     20, .5, 20.5);
+                     25, .5, 25.5);
   int i = 1;
   m_hNorm->GetXaxis()->SetBinLabel(i++, "Packet");
   m_hNorm->GetXaxis()->SetBinLabel(i++, "Lv1-Taggers");
@@ -75,7 +76,12 @@ TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
   m_hNorm->GetXaxis()->SetBinLabel(i++, "GTM_TimeFrame_Matched_Hit_Sum");
   m_hNorm->GetXaxis()->SetBinLabel(i++, "GTM_TimeFrame_Dropped_Hit_Sum");
 
-  assert(i <= 20);
+  m_hNorm->GetXaxis()->SetBinLabel(i++, "FEE_Buffer_Words_Appended");
+  m_hNorm->GetXaxis()->SetBinLabel(i++, "FEE_Buffer_Words_Consumed");
+  m_hNorm->GetXaxis()->SetBinLabel(i++, "RawHit_Pool_Allocated");
+  m_hNorm->GetXaxis()->SetBinLabel(i++, "RawHit_Pool_Recycled");
+
+  assert(i <= 25);
   m_hNorm->GetXaxis()->LabelsOption("v");
   hm->registerHisto(m_hNorm);
 
@@ -172,14 +178,8 @@ TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
 
 TpcTimeFrameBuilder::~TpcTimeFrameBuilder()
 {
-  for (auto& timeFrameEntry : m_timeFrameMap)
-  {
-    while (!timeFrameEntry.second.empty())
-    {
-      delete timeFrameEntry.second.back();
-      timeFrameEntry.second.pop_back();
-    }
-  }
+  // hits are owned by m_rawHitPool
+  m_timeFrameMap.clear();
 
   delete m_packetTimer;
 
@@ -267,10 +267,7 @@ std::vector<TpcRawHit*>& TpcTimeFrameBuilder::getTimeFrame(const uint64_t& gtm_b
       m_hNorm->Fill("GTM_TimeFrame_Dropped_Hit_Sum", it->second.size());
       assert(h_GTMClockDiff_Dropped);
       h_GTMClockDiff_Dropped->Fill(int64_t(it->first) - int64_t(bclk_rollover_corrected));
-      for (const auto& hit : it->second)
-      {
-        delete hit;
-      }
+      m_rawHitPool.release(it->second);
       it = m_timeFrameMap.erase(it);
     }
     else if (it->first < bclk_rollover_corrected + GL1_BCO_MATCH_WINDOW)
@@ -366,11 +363,7 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
 
     if (it != m_timeFrameMap.end())
     {
-      while (!it->second.empty())
-      {
-        delete it->second.back();
-        it->second.pop_back();
-      }
+      m_rawHitPool.release(it->second);
       m_timeFrameMap.erase(it);
     }
   }
@@ -383,14 +376,12 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
   {
     if (it->first <= bclk_rollover_corrected)
     {
-      int count = 0;
-      while (!it->second.empty())
+      const size_t count = it->second.size();
+      for (const auto* hit : it->second)
       {
-        m_hFEEDataStream->Fill(it->second.back()->get_fee(), "HitUnusedBeforeCleanup", 1);
-        delete it->second.back();
-        it->second.pop_back();
-        ++count;
+        m_hFEEDataStream->Fill(hit->get_fee(), "HitUnusedBeforeCleanup", 1);
       }
+      m_rawHitPool.release(it->second);
 
       if (m_verbosity >= 1)
       {
@@ -411,10 +402,20 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
   }  //   for (auto it = m_timeFrameMap.begin(); it != m_timeFrameMap.end();)
 }
 
+void TpcTimeFrameBuilder::dropTimeFrames()
+{
+  for (auto& timeframe : m_timeFrameMap)
+  {
+    m_rawHitPool.release(timeframe.second);
+  }
+  m_timeFrameMap.clear();
+}
+
 int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 {
-  static size_t call_count = 0;
-  ++call_count;
+  // shared by all builders, which may run on different threads
+  static std::atomic<size_t> global_call_count = 0;
+  const size_t call_count = ++global_call_count;
 
   if (m_verbosity > 1)
   {
@@ -607,10 +608,8 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 
       if (fee_id < MAX_FEECOUNT)
       {
-        for (const uint16_t& i : dma_word_data.data)
-        {
-          m_feeData[fee_id].push_back(i);
-        }
+        m_feeData[fee_id].append(dma_word_data.data, DAM_DMA_WORD_LENGTH - 1);
+        m_feeWordsAppended += DAM_DMA_WORD_LENGTH - 1;
         m_hNorm->Fill("DMA_WORD_FEE", 1);
 
         // immediate fee buffer processing to reduce memory consuption
@@ -649,14 +648,20 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
                 << std::endl;
       m_hNorm->Fill("TimeFrameSizeLimitError", 1);
 
-      while (!timeframe.second.empty())
-      {
-        delete timeframe.second.back();
-        timeframe.second.pop_back();
-      }
+      m_rawHitPool.release(timeframe.second);
     }
   }
 
+  // throughput counters, filled once per packet
+  const auto [hits_allocated, hits_recycled] = m_rawHitPool.take_counters();
+  m_hNorm->Fill("FEE_Buffer_Words_Appended", m_feeWordsAppended);
+  m_hNorm->Fill("FEE_Buffer_Words_Consumed", m_feeWordsConsumed);
+  m_hNorm->Fill("RawHit_Pool_Allocated", hits_allocated);
+  m_hNorm->Fill("RawHit_Pool_Recycled", hits_recycled);
+  m_decodedHitCount += hits_allocated + hits_recycled;
+  m_feeWordsAppended = 0;
+  m_feeWordsConsumed = 0;
+
   m_packetTimer->stop();
   assert(h_ProcessPacket_Time);
   h_ProcessPacket_Time->Fill(call_count, m_packetTimer->elapsed());
@@ -674,7 +679,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
   }
 
   assert(fee < m_feeData.size());
-  std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  FeeDataRingBuffer& data_buffer = m_feeData[fee];
 
   while (HEADER_LENGTH <= data_buffer.size())
   {
@@ -704,6 +709,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         }
         m_hFEEDataStream->Fill(fee, "WordSkipped", 1);
         data_buffer.pop_front();
+        ++m_feeWordsConsumed;
         continue;
       }
       assert(data_buffer[1] == FEE_PACKET_MAGIC_KEY_1);
@@ -716,6 +722,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         }
         m_hFEEDataStream->Fill(fee, "WordSkipped", 1);
         data_buffer.pop_front();
+        ++m_feeWordsConsumed;
         continue;
       }
       assert(data_buffer[2] == FEE_PACKET_MAGIC_KEY_2);
@@ -731,6 +738,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
       }
       m_hFEEDataStream->Fill(fee, "InvalidLength", 1);
       data_buffer.pop_front();
+      ++m_feeWordsConsumed;
       continue;
     }
 
@@ -755,7 +763,8 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
     {
       process_fee_data_waveform(fee, data_buffer);
     }
-    data_buffer.erase(data_buffer.begin(), data_buffer.begin() + pkt_length + 1);
+    data_buffer.consume(pkt_length + 1);
+    m_feeWordsConsumed += pkt_length + 1;
     m_hFEEDataStream->Fill(fee, "WordValid", pkt_length + 1);
 
   }  //     while (HEADER_LENGTH < data_buffer.size())
@@ -763,7 +772,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, FeeDataRingBuffer& data_buffer)
 {
   const uint16_t& pkt_length = data_buffer[0];
 
@@ -924,16 +933,12 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
 
     // Format is (N sample) (start time), (1st sample)... (Nth sample)
     size_t pos = HEADER_LENGTH;
-    std::deque<uint16_t>::const_iterator data_buffer_iterator = data_buffer.cbegin();
-    std::advance(data_buffer_iterator, pos);
     while (pos + 2 < pkt_length)
     {
-      const uint16_t& nsamp = *data_buffer_iterator;
+      const uint16_t& nsamp = data_buffer[pos];
       ++pos;
-      ++data_buffer_iterator;
-      const uint16_t& start_t = *data_buffer_iterator;
+      const uint16_t& start_t = data_buffer[pos];
       ++pos;
-      ++data_buffer_iterator;
       if (m_verbosity > 3)
       {
         std::cout << __PRETTY_FUNCTION__ << ": nsamp: " << nsamp
@@ -964,13 +969,12 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
       std::vector<uint16_t> adc(nsamp);
       for (int j = 0; j < nsamp; j++)
       {
-        const uint16_t& adc_value = *data_buffer_iterator;
+        const uint16_t& adc_value = data_buffer[pos];
 
         adc[j] = adc_value;
         m_hFEESAMPAADC->Fill(start_t + j, fee_sampa_address, adc_value);
 
         ++pos;
-        ++data_buffer_iterator;  // data_buffer[pos++];
       }
       payload.waveforms.emplace_back(start_t, std::move(adc));
 
@@ -992,7 +996,7 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
     // valid packet in the buffer, create a new hit
     if (payload.type != TpcTimeFrameBuilder::BcoMatchingInformation::HEARTBEAT_T)
     {
-      TpcRawHitv3* hit = new TpcRawHitv3();
+      TpcRawHitv3* hit = m_rawHitPool.get();
       m_timeFrameMap[payload.gtm_bco].push_back(hit);
 
       hit->set_bco(payload.bx_timestamp);
@@ -1015,7 +1019,7 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
   return;
 }
 
-void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int& fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int& fee, FeeDataRingBuffer& data_buffer)
 {
   if (m_verbosity > 2)
   {
@@ -1124,6 +1128,47 @@ void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int& f
   return;
 }
 
+TpcTimeFrameBuilder::RawHitPool::~RawHitPool() = default;
+
+TpcRawHitv3* TpcTimeFrameBuilder::RawHitPool::get()
+{
+  if (!m_free.empty())
+  {
+    TpcRawHitv3* hit = m_free.back();
+    m_free.pop_back();
+    ++m_recycled;
+    return hit;
+  }
+
+  if (m_slab_used == kSlabSize)
+  {
+    m_slabs.emplace_back(new TpcRawHitv3[kSlabSize]);
+    m_slab_used = 0;
+  }
+  ++m_allocated;
+  return &m_slabs.back()[m_slab_used++];
+}
+
+void TpcTimeFrameBuilder::RawHitPool::release(std::vector<TpcRawHit*>& hits)
+{
+  for (auto* hit : hits)
+  {
+    // all hits in the time frames are taken from this pool
+    TpcRawHitv3* hitv3 = static_cast<TpcRawHitv3*>(hit);  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+    hitv3->Clear(nullptr);
+    m_free.push_back(hitv3);
+  }
+  hits.clear();
+}
+
+std::pair<size_t, size_t> TpcTimeFrameBuilder::RawHitPool::take_counters()
+{
+  std::pair<size_t, size_t> counters(m_allocated, m_recycled);
+  m_allocated = 0;
+  m_recycled = 0;
+  return counters;
+}
+
 void TpcTimeFrameBuilder::SaveDigitalCurrentDebugTTree(const std::string& name)
 {
   if (m_verbosity >= 1)
@@ -1267,17 +1312,15 @@ uint16_t TpcTimeFrameBuilder::reverseBits(const uint16_t x) const
 
 std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint32_t fee, const uint16_t l) const
 {
-  const std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  const FeeDataRingBuffer& data_buffer = m_feeData[fee];
   assert(l < data_buffer.size());
 
-  std::deque<uint16_t>::const_iterator it = data_buffer.begin();
-
   uint16_t crc = 0xffffU;
   uint16_t data_parity = 0U;
 
-  for (int i = 0; i < l; ++i, ++it)
+  for (int i = 0; i < l; ++i)
   {
-    const uint16_t& x = *it;
+    const uint16_t& x = data_buffer[i];
 
     crc ^= reverseBits(x);
     for (uint16_t k = 0; k < 16U; k++)
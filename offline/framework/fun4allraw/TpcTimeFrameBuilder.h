@@ -2,13 +2,15 @@
 #define Fun4All_TpcTimeFrameBuilder_H
 
 #include <algorithm>
+#include <cassert>
 #include <cstdint>
-#include <deque>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <limits>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <queue>
 #include <set>
@@ -18,6 +20,7 @@
 
 class Packet;
 class TpcRawHit;
+class TpcRawHitv3;
 class PHTimer;
 class TH1;
 class TH2;
@@ -46,6 +49,12 @@ class TpcTimeFrameBuilder
   // enable saving of digital current debug TTree with file name `name`
   void SaveDigitalCurrentDebugTTree(const std::string &name);
 
+  //! number of raw hits decoded since construction
+  uint64_t getDecodedHitCount() const { return m_decodedHitCount; }
+
+  //! drop all assembled time frames, for standalone use without GL1 requests (e.g. benchmarks)
+  void dropTimeFrames();
+
  protected:
   // Length for the 256-bit wide Round Robin Multiplexer for the data stream
   static const size_t DAM_DMA_WORD_LENGTH = 16;
@@ -81,10 +90,117 @@ class TpcTimeFrameBuilder
     uint16_t data[DAM_DMA_WORD_LENGTH - 1] = {0};
   };
 
+  //! per FEE buffer of 16-bit data words, waiting to be decoded
+  /**
+   * fixed capacity ring buffer with bulk append and consume.
+   * FEE data are decoded after every DMA word, so the buffer never holds
+   * much more than one FEE packet. It only grows if that ever fails
+   */
+  class FeeDataRingBuffer
+  {
+   public:
+    // power of 2, larger than MAX_PACKET_LENGTH plus one DMA word
+    static const size_t kDefaultCapacity = 4096;
+
+    explicit FeeDataRingBuffer(const size_t capacity = kDefaultCapacity)
+      : m_data(capacity)
+      , m_mask(capacity - 1)
+    {
+      assert((capacity & m_mask) == 0);
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t capacity() const { return m_data.size(); }
+
+    const uint16_t &operator[](const size_t i) const
+    {
+      return m_data[(m_head + i) & m_mask];
+    }
+
+    //! append n words at the end of the buffer
+    void append(const uint16_t *words, const size_t n)
+    {
+      if (m_size + n > m_data.size())
+      {
+        grow(m_size + n);
+      }
+      const size_t tail = (m_head + m_size) & m_mask;
+      const size_t first = std::min(n, m_data.size() - tail);
+      std::memcpy(&m_data[tail], words, first * sizeof(uint16_t));
+      std::memcpy(m_data.data(), words + first, (n - first) * sizeof(uint16_t));
+      m_size += n;
+    }
+
+    //! remove n words from the front of the buffer
+    void consume(const size_t n)
+    {
+      const size_t used = std::min(n, m_size);
+      m_head = (m_head + used) & m_mask;
+      m_size -= used;
+    }
+
+    void pop_front() { consume(1); }
+
+   private:
+    void grow(const size_t min_capacity)
+    {
+      size_t capacity = m_data.size();
+      while (capacity < min_capacity)
+      {
+        capacity *= 2;
+      }
+      std::vector<uint16_t> data(capacity);
+      for (size_t i = 0; i < m_size; ++i)
+      {
+        data[i] = (*this)[i];
+      }
+      m_data.swap(data);
+      m_mask = capacity - 1;
+      m_head = 0;
+    }
+
+    std::vector<uint16_t> m_data;
+    size_t m_mask = 0;
+    size_t m_head = 0;
+    size_t m_size = 0;
+  };
+
+  //! pool of TpcRawHitv3 objects, allocated in slabs
+  /**
+   * hits of a time frame are handed back all at once when the time frame
+   * is used or dropped, and are recycled for the following time frames
+   */
+  class RawHitPool
+  {
+   public:
+    RawHitPool() = default;
+    ~RawHitPool();
+    RawHitPool(const RawHitPool &) = delete;
+    RawHitPool &operator=(const RawHitPool &) = delete;
+
+    TpcRawHitv3 *get();
+
+    //! return all hits of a time frame to the pool, and clear it
+    void release(std::vector<TpcRawHit *> &hits);
+
+    //! number of hits allocated and recycled since last call
+    std::pair<size_t, size_t> take_counters();
+
+   private:
+    static const size_t kSlabSize = 1024;
+
+    std::vector<std::unique_ptr<TpcRawHitv3[]>> m_slabs;
+    std::vector<TpcRawHitv3 *> m_free;
+    size_t m_slab_used = kSlabSize;
+    size_t m_allocated = 0;
+    size_t m_recycled = 0;
+  };
+
   int decode_gtm_data(const dma_word &gtm_word);
   int process_fee_data(unsigned int fee_id);
-  void process_fee_data_waveform(const unsigned int &fee_id, std::deque<uint16_t> &data_buffer);
-  void process_fee_data_digital_current(const unsigned int &fee_id, std::deque<uint16_t> &data_buffer);
+  void process_fee_data_waveform(const unsigned int &fee_id, FeeDataRingBuffer &data_buffer);
+  void process_fee_data_digital_current(const unsigned int &fee_id, FeeDataRingBuffer &data_buffer);
 
   struct gtm_payload
   {
@@ -371,7 +487,12 @@ class TpcTimeFrameBuilder
   };  //   class BcoMatchingInformation
 
  private:
-  std::vector<std::deque<uint16_t>> m_feeData;
+  std::vector<FeeDataRingBuffer> m_feeData;
+
+  //! FEE words buffered and decoded during the current packet
+  uint64_t m_feeWordsAppended = 0;
+  uint64_t m_feeWordsConsumed = 0;
+  uint64_t m_decodedHitCount = 0;
 
   std::map<int, std::set<int>> m_maskedFEEs;
 
@@ -385,6 +506,7 @@ class TpcTimeFrameBuilder
   //! Map to store TpcRawHit pointers indexed by GTM BCO values
   //! This is used to organize hits into time frames based on their BCO values
   std::map<uint64_t, std::vector<TpcRawHit *>> m_timeFrameMap;
+  RawHitPool m_rawHitPool;
   static const size_t kMaxRawHitLimit = 10000;  // 10k hits per event > 256ch/fee * 26fee
   std::queue<uint64_t> m_UsedTimeFrameSet;
 
@@ -0,0 +1,332 @@
+// Measure the throughput of the streaming raw data decoders on a local PRDF
+// file, outside of a Fun4All job: MB/s of packet data, hits/s, heap
+// allocations per hit and peak resident memory.
+//
+// tpc, intt and mvtx drive TpcTimeFrameBuilder, intt_pool and mvtx_pool
+// directly with the packets of the file, so file reading is not timed.
+// micromegas and gl1 run FillPool of SingleMicromegasPoolInput_v2 and
+// SingleGl1PoolInput, which read the file themselves, so their rate
+// includes reading it (use mmap and a file in the page cache) and they
+// always read the whole file, max events applies to the other decoders.
+// Peak memory is per process, run one decoder per invocation.
+//
+// usage: rawdecoder_benchmark <tpc|intt|mvtx|micromegas|gl1> <prdf file> [max events] [mmap]
+
+#include "MmapEventiterator.h"
+#include "SingleGl1PoolInput.h"
+#include "SingleMicromegasPoolInput_v2.h"
+#include "TpcTimeFrameBuilder.h"
+#include "intt_pool.h"
+#include "mvtx_pool.h"
+
+#include <Event/Event.h>
+#include <Event/EventTypes.h>
+#include <Event/fileEventiterator.h>
+#include <Event/packet.h>
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+
+namespace
+{
+  std::atomic<uint64_t> s_allocations{0};
+}  // namespace
+
+// count all heap allocations of the process
+void *operator new(std::size_t size)
+{
+  s_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+  using bench_clock = std::chrono::steady_clock;
+
+  struct result_t
+  {
+    double seconds = 0;
+    uint64_t events = 0;
+    uint64_t bytes = 0;
+    uint64_t hits = 0;
+    uint64_t allocations = 0;
+    uint64_t checksum = 0;
+  };
+
+  // time a decoder call and count the heap allocations it makes
+  template <typename F>
+  void measure(result_t &result, F &&fcn)
+  {
+    const uint64_t allocations = s_allocations.load(std::memory_order_relaxed);
+    const auto start = bench_clock::now();
+    fcn();
+    result.seconds += std::chrono::duration<double>(bench_clock::now() - start).count();
+    result.allocations += s_allocations.load(std::memory_order_relaxed) - allocations;
+  }
+
+  std::unique_ptr<Eventiterator> open_file(const std::string &filename, bool mmap)
+  {
+    int status = 0;
+    std::unique_ptr<Eventiterator> iterator;
+    if (mmap)
+    {
+      iterator = std::make_unique<MmapEventiterator>(filename, status);
+    }
+    else
+    {
+      iterator = std::make_unique<fileEventiterator>(filename.c_str(), status);
+    }
+    if (status)
+    {
+      std::cout << "could not open " << filename << std::endl;
+      iterator.reset();
+    }
+    return iterator;
+  }
+
+  // call fcn for the packets of every data event of the file
+  void for_each_packet(Eventiterator *iterator, uint64_t maxevents, result_t &result, const std::function<void(Packet *)> &fcn)
+  {
+    while (result.events < maxevents)
+    {
+      std::unique_ptr<Event> evt(iterator->getNextEvent());
+      if (!evt)
+      {
+        break;
+      }
+      if (evt->getEvtType() != DATAEVENT)
+      {
+        continue;
+      }
+      ++result.events;
+      for (Packet *pkt : evt->getPacketVector())
+      {
+        std::unique_ptr<Packet> packet(pkt);
+        result.bytes += packet->getLength() * sizeof(uint32_t);
+        fcn(packet.get());
+      }
+    }
+  }
+
+  result_t run_tpc(Eventiterator *iterator, uint64_t maxevents)
+  {
+    result_t result;
+    std::map<int, std::unique_ptr<TpcTimeFrameBuilder>> builders;
+    for_each_packet(iterator, maxevents, result, [&](Packet *packet)
+                    {
+      auto &builder = builders[packet->getIdentifier()];
+      if (!builder)
+      {
+        builder = std::make_unique<TpcTimeFrameBuilder>(packet->getIdentifier());
+      }
+      measure(result, [&]
+              { builder->ProcessPacket(packet);
+                // no GL1 time frame requests here, recycle the assembled hits
+                builder->dropTimeFrames(); }); });
+    for (const auto &[id, builder] : builders)
+    {
+      result.hits += builder->getDecodedHitCount();
+    }
+    return result;
+  }
+
+  // read the same fields as SingleInttPoolInput for all hits of the pool
+  void read_intt_pool(intt_pool *pool, result_t &result)
+  {
+    while (pool->depth_ok())
+    {
+      const int nhits = pool->iValue(0, "NR_HITS");
+      for (int j = 0; j < nhits; j++)
+      {
+        result.checksum += pool->lValue(j, "BCO") + pool->iValue(j, "FEE") + pool->iValue(j, "ADC") + pool->iValue(j, "AMPLITUDE") + pool->iValue(j, "CHIP_ID") + pool->iValue(j, "CHANNEL_ID") + pool->iValue(j, "FPHX_BCO");
+      }
+      result.hits += nhits;
+      pool->next();
+    }
+  }
+
+  result_t run_intt(Eventiterator *iterator, uint64_t maxevents)
+  {
+    result_t result;
+    std::map<int, std::unique_ptr<intt_pool>> pools;
+    for_each_packet(iterator, maxevents, result, [&](Packet *packet)
+                    {
+      auto &pool = pools[packet->getIdentifier()];
+      if (!pool)
+      {
+        pool = std::make_unique<intt_pool>(1000, 100);
+      }
+      measure(result, [&]
+              { pool->addPacket(packet);
+                read_intt_pool(pool.get(), result); }); });
+    for (auto &[id, pool] : pools)
+    {
+      measure(result, [&]
+              { pool->drain();
+                read_intt_pool(pool.get(), result); });
+    }
+    return result;
+  }
+
+  result_t run_mvtx(Eventiterator *iterator, uint64_t maxevents)
+  {
+    result_t result;
+    std::map<int, std::unique_ptr<mvtx_pool>> pools;
+    for_each_packet(iterator, maxevents, result, [&](Packet *packet)
+                    {
+      auto &pool = pools[packet->getIdentifier()];
+      if (!pool)
+      {
+        pool = std::make_unique<mvtx_pool>();
+      }
+      measure(result, [&]
+              {
+        pool->addPacket(packet);
+        // same loop as SingleMvtxPoolInput
+        const int nfee = pool->get_feeidSet_size();
+        for (int i_fee = 0; i_fee < nfee; ++i_fee)
+        {
+          const int feeId = pool->get_feeid(i_fee);
+          const int nstrobes = pool->get_strbSet_size(feeId);
+          for (int i_strb = 0; i_strb < nstrobes; ++i_strb)
+          {
+            result.checksum += pool->get_TRG_IR_BCO(feeId, i_strb);
+            for (const auto *hit : pool->get_hits(feeId, i_strb))
+            {
+              result.checksum += hit->chip_id + hit->bunchcounter + hit->row_pos + hit->col_pos;
+              ++result.hits;
+            }
+          }
+        } }); });
+    return result;
+  }
+
+  // the streaming inputs read the file in FillPool, their hits are counted
+  // and dropped after every call
+  result_t run_streaming(SingleStreamingInput *input, const std::string &filename, bool mmap, const std::function<size_t()> &poolhits)
+  {
+    result_t result;
+    input->MemoryMapFiles(mmap);
+    input->AddFile(filename);
+    input->createQAHistos();
+    while (!input->AllDone())
+    {
+      measure(result, [&]
+              { input->FillPool(); });
+      result.hits += poolhits();
+      input->CleanupUsedPackets(std::numeric_limits<uint64_t>::max());
+    }
+    result.bytes = std::filesystem::file_size(filename);
+    return result;
+  }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3)
+  {
+    std::cout << "usage: " << argv[0] << " <tpc|intt|mvtx|micromegas|gl1> <prdf file> [max events] [mmap]" << std::endl;
+    return 1;
+  }
+  const std::string decoder = argv[1];
+  const std::string filename = argv[2];
+  const uint64_t maxevents = argc > 3 && std::atoll(argv[3]) > 0 ? std::atoll(argv[3]) : std::numeric_limits<uint64_t>::max();
+  const bool mmap = argc > 4 && std::string(argv[4]) == "mmap";
+
+  result_t result;
+  if (decoder == "micromegas")
+  {
+    SingleMicromegasPoolInput_v2 input("MICROMEGAS_BENCHMARK");
+    result = run_streaming(&input, filename, mmap, [&input]
+                           { return input.get_pool_hit_count(); });
+  }
+  else if (decoder == "gl1")
+  {
+    SingleGl1PoolInput input("GL1_BENCHMARK");
+    // one raw hit per beam clock
+    result = run_streaming(&input, filename, mmap, [&input]
+                           { return input.BclkStack().size(); });
+  }
+  else
+  {
+    auto iterator = open_file(filename, mmap);
+    if (!iterator)
+    {
+      return 1;
+    }
+    if (decoder == "tpc")
+    {
+      result = run_tpc(iterator.get(), maxevents);
+    }
+    else if (decoder == "intt")
+    {
+      result = run_intt(iterator.get(), maxevents);
+    }
+    else if (decoder == "mvtx")
+    {
+      result = run_mvtx(iterator.get(), maxevents);
+    }
+    else
+    {
+      std::cout << "unknown decoder " << decoder << std::endl;
+      return 1;
+    }
+  }
+
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  const double mbytes = result.bytes / (1024. * 1024.);
+  std::cout << decoder << ":"
+            << " events: " << result.events
+            << " data: " << mbytes << " MB"
+            << " time: " << result.seconds << " s"
+            << " rate: " << (result.seconds > 0 ? mbytes / result.seconds : 0) << " MB/s"
+            << " hits: " << result.hits
+            << " (" << (result.seconds > 0 ? result.hits / result.seconds : 0) << " hits/s)"
+            << " allocations/hit: " << (result.hits ? static_cast<double>(result.allocations) / result.hits : 0)
+            << " peak rss: " << usage.ru_maxrss / 1024. << " MB"
+            << " checksum: " << result.checksum
+            << std::endl;
+  return 0;
+}
@@ -18,7 +18,14 @@ class PHDataNode : public PHNode
   ~PHDataNode() override;
 
  public:
-  T* getData() { return data.data; }
+  // marks the node as accessed, see PHNode::wasAccessed()
+  T* getData()
+  {
+    markAccessed();
+    return data.data;
+  }
+  // for the framework (I/O, reset, copies), does not mark the node as accessed
+  T* peekData() { return data.data; }
   void setData(T* d) { data.data = d; }
   void prune() override {}
   void forgetMe(PHNode*) override {}
@@ -78,6 +78,8 @@ bool PHIODataNode<T>::write(PHIOManager *IOManager, const std::string &path)
       if (dynamic_cast<TObject *>(this->data.data))
       {
         bret = np->write(&(this->data.tobj), newPath, buffersize, splitlevel);
+        // written out by an output manager, an adaptive input has to keep reading it
+        this->markAccessed();
       }
       return bret;
     }
@@ -4,6 +4,7 @@
 //  Declaration of class PHNode
 //  Purpose: abstract base class for all node classes
 
+#include <atomic>
 #include <iosfwd>
 #include <string>
 
@@ -35,11 +36,26 @@ class PHNode
   void setName(const std::string &n) { name = n; }
   void setObjectType(const std::string &n) { objecttype = n; }
   void makeTransient() { persistent = false; }
+  // set when the data of the node is used (PHDataNode::getData(), e.g. via
+  // findNode::getClass) and when an output manager writes the node, used by
+  // PHNodeIOManager to learn which input branches are actually used.
+  // Modules may run on several threads, only the flag itself is synchronized
+  void setAccessed(const bool b) { accessed.store(b, std::memory_order_relaxed); }
+  bool wasAccessed() const { return accessed.load(std::memory_order_relaxed); }
+  // check first, so threads using the same node do not keep writing to it
+  void markAccessed()
+  {
+    if (!wasAccessed())
+    {
+      setAccessed(true);
+    }
+  }
 
  protected:
   PHNode *parent{nullptr};
   bool persistent{true};
   bool reset_able{true};
+  std::atomic<bool> accessed{false};
   std::string type{"PHNode"};
   std::string objecttype;
   std::string name;
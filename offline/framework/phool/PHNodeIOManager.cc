@@ -5,11 +5,13 @@
 #include "PHCompositeNode.h"
 #include "PHIODataNode.h"
 #include "PHNodeIterator.h"
+#include "PHObject.h"
 #include "phooldefs.h"
 
 #include <TBranch.h>  // for TBranch
 #include <TBranchElement.h>
 #include <TBranchObject.h>
+#include <TBufferFile.h>
 #include <TClass.h>
 #include <TDirectory.h>  // for TDirectory
 #include <TFile.h>
@@ -20,17 +22,180 @@
 #include <TSystem.h>
 #include <TTree.h>
 #include <TTreeCache.h>
+#include <TUUID.h>
 
 #include <boost/algorithm/string.hpp>
 
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+namespace
+{
+  // deep copy through the streamer, the copy is exactly what gets written
+  TObject* StreamerCopy(TObject* source, int& nbytes)
+  {
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.WriteObjectAny(source, source->IsA());
+    nbytes = buffer.Length();
+    buffer.SetReadMode();
+    buffer.SetBufferOffset(0);
+    return static_cast<TObject*>(buffer.ReadObjectAny(TObject::Class()));
+  }
+}  // namespace
+
+// Fills the output tree on its own thread. The event thread collects
+// copies of the persistent objects of one event and commits them, the
+// writer thread points the branches to these copies and fills the tree
+class PHNodeIOManager::AsyncWriter
+{
+ public:
+  AsyncWriter(PHNodeIOManager* ioman, const unsigned int depth)
+    : m_IOManager(ioman)
+    , m_Depth(depth)
+    , m_Thread(&AsyncWriter::run, this)
+  {
+  }
+  ~AsyncWriter()
+  {
+    stop();
+    for (auto& iter : m_Objects)
+    {
+      delete iter.second;
+    }
+  }
+  AsyncWriter(const AsyncWriter&) = delete;
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  void add(const std::string& path, TObject* object, const int buffersize, const int splitlevel)
+  {
+    m_Pending.push_back({path, object, buffersize, splitlevel});
+  }
+
+  // hand the current event to the writer, blocks while the queue is full
+  void commit()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (m_Queue.size() >= m_Depth)
+    {
+      auto starttime = std::chrono::steady_clock::now();
+      m_CvNotFull.wait(lock, [this]
+                       { return m_Queue.size() < m_Depth; });
+      m_Stalls++;
+      m_StallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - starttime).count();
+    }
+    m_Queue.push_back(std::move(m_Pending));
+    m_Pending.clear();
+    m_CvWork.notify_one();
+  }
+
+  // wait until all committed events are in the tree
+  void drain()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_CvIdle.wait(lock, [this]
+                  { return m_Queue.empty() && !m_Busy; });
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Stop = true;
+    }
+    m_CvWork.notify_all();
+    if (m_Thread.joinable())
+    {
+      m_Thread.join();
+    }
+  }
+
+  uint64_t Stalls() const { return m_Stalls; }
+  double StallSeconds() const { return m_StallSeconds; }
+
+ private:
+  struct Item
+  {
+    std::string path;
+    TObject* object{nullptr};
+    int buffersize{0};
+    int splitlevel{0};
+  };
+  using Event = std::vector<Item>;
+
+  void run()
+  {
+    while (true)
+    {
+      Event event;
+      {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_CvWork.wait(lock, [this]
+                      { return !m_Queue.empty() || m_Stop; });
+        if (m_Queue.empty())
+        {
+          return;  // stopped and nothing left to write
+        }
+        event = std::move(m_Queue.front());
+        m_Queue.pop_front();
+        m_Busy = true;
+      }
+      m_CvNotFull.notify_one();
+      write(event);
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Busy = false;
+      }
+      m_CvIdle.notify_all();
+    }
+  }
+
+  void write(Event& event)
+  {
+    for (auto& item : event)
+    {
+      // we own the copy of the previous event until it is replaced
+      auto [iter, inserted] = m_Objects.try_emplace(item.path, item.object);
+      if (!inserted)
+      {
+        delete iter->second;
+        iter->second = item.object;
+      }
+      m_IOManager->createBranch(&iter->second, item.path, item.buffersize, item.splitlevel);
+    }
+    auto starttime = std::chrono::steady_clock::now();
+    m_IOManager->tree->Fill();
+    m_IOManager->m_FillSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - starttime).count();
+  }
+
+  PHNodeIOManager* m_IOManager{nullptr};
+  unsigned int m_Depth{1};
+  // event thread only
+  Event m_Pending;
+  // writer thread only
+  std::map<std::string, TObject*> m_Objects;
+  std::mutex m_Mutex;
+  std::condition_variable m_CvWork;
+  std::condition_variable m_CvNotFull;
+  std::condition_variable m_CvIdle;
+  std::deque<Event> m_Queue;
+  bool m_Busy{false};
+  bool m_Stop{false};
+  uint64_t m_Stalls{0};
+  double m_StallSeconds{0};
+  std::thread m_Thread;
+};
+
 PHNodeIOManager::PHNodeIOManager(const std::string& f,
                                  const PHAccessType a)
 {
@@ -63,6 +228,11 @@ PHNodeIOManager::~PHNodeIOManager()
 
 void PHNodeIOManager::closeFile()
 {
+  if (m_AsyncWriter)
+  {
+    // writes the remaining events
+    m_AsyncWriter->stop();
+  }
   if (file)
   {
     if (accessMode == PHWrite || accessMode == PHUpdate)
@@ -71,6 +241,24 @@ void PHNodeIOManager::closeFile()
     }
     file->Close();
   }
+  delete m_AsyncWriter;
+  m_AsyncWriter = nullptr;
+}
+
+void PHNodeIOManager::AsyncWrite(const unsigned int depth)
+{
+  if (m_AsyncWriter)
+  {
+    std::cout << PHWHERE << " asynchronous writing already started with depth "
+              << m_AsyncWriteDepth << std::endl;
+    return;
+  }
+  m_AsyncWriteDepth = depth;
+  if (depth > 0 && file && tree && (accessMode == PHWrite || accessMode == PHUpdate))
+  {
+    ROOT::EnableThreadSafety();
+    m_AsyncWriter = new AsyncWriter(this, depth);
+  }
 }
 
 bool PHNodeIOManager::setFile(const std::string& f, const std::string& title,
@@ -147,7 +335,16 @@ bool PHNodeIOManager::write(PHCompositeNode* topNode)
   // be filled.
   if (file && tree)
   {
-    tree->Fill();
+    if (m_AsyncWriter)
+    {
+      m_AsyncWriter->commit();
+    }
+    else
+    {
+      auto starttime = std::chrono::steady_clock::now();
+      tree->Fill();
+      m_FillSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - starttime).count();
+    }
     eventNumber++;
     return true;
   }
@@ -159,35 +356,52 @@ bool PHNodeIOManager::write(TObject** data, const std::string& path, int nodebuf
 {
   if (file && tree)
   {
-    TBranch* thisBranch = tree->GetBranch(path.c_str());
-    if (!thisBranch)
-    {
-      int use_splitlevel = splitlevel;
-      int use_buffersize = buffersize;
-      // the buffersize and splitlevel are set on the first call
-      // when the branch is created, the values come from the caller
-      // which is the node which writes itself
-      if (splitlevel == std::numeric_limits<int>::min())
-      {
-        use_splitlevel = nodesplitlevel;
-      }
-      if (buffersize == std::numeric_limits<int>::min())
-      {
-        use_buffersize = nodebuffersize;
-      }
-      tree->Branch(path.c_str(), (*data)->ClassName(),
-                   data, use_buffersize, use_splitlevel);
-    }
-    else
+    OutputBranch& outbranch = m_OutputBranches[path];
+    outbranch.entries++;
+    if (m_AsyncWriter)
     {
-      thisBranch->SetAddress(data);
+      auto starttime = std::chrono::steady_clock::now();
+      int nbytes = 0;
+      TObject* copy = StreamerCopy(*data, nbytes);
+      outbranch.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - starttime).count();
+      outbranch.bytes += nbytes;
+      m_AsyncWriter->add(path, copy, nodebuffersize, nodesplitlevel);
+      return true;
     }
-    return true;
+    return createBranch(data, path, nodebuffersize, nodesplitlevel);
   }
 
   return false;
 }
 
+bool PHNodeIOManager::createBranch(TObject** data, const std::string& path, int nodebuffersize, int nodesplitlevel)
+{
+  TBranch* thisBranch = tree->GetBranch(path.c_str());
+  if (!thisBranch)
+  {
+    int use_splitlevel = splitlevel;
+    int use_buffersize = buffersize;
+    // the buffersize and splitlevel are set on the first call
+    // when the branch is created, the values come from the caller
+    // which is the node which writes itself
+    if (splitlevel == std::numeric_limits<int>::min())
+    {
+      use_splitlevel = nodesplitlevel;
+    }
+    if (buffersize == std::numeric_limits<int>::min())
+    {
+      use_buffersize = nodebuffersize;
+    }
+    tree->Branch(path.c_str(), (*data)->ClassName(),
+                 data, use_buffersize, use_splitlevel);
+  }
+  else
+  {
+    thisBranch->SetAddress(data);
+  }
+  return true;
+}
+
 bool PHNodeIOManager::read(size_t requestedEvent)
 {
   return readEventFromFile(requestedEvent);
@@ -299,9 +513,18 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
     tree->SetCacheSize(m_cacheSize);
   }
 
+  if (m_AdaptiveDone)
+  {
+    checkDisabledBranches();
+  }
+  else if (m_AdaptivePreset || (m_AdaptiveEvents > 0 && m_EventsRead >= m_AdaptiveEvents))
+  {
+    applyAdaptiveBranchSelect();
+  }
+
   if (requestedEvent)
   {
-    bytesRead = tree->GetEvent(requestedEvent);
+    bytesRead = readEntry(requestedEvent);
     if (bytesRead)
     {
       eventNumber = requestedEvent + 1;
@@ -309,7 +532,11 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
   }
   else
   {
-    bytesRead = tree->GetEvent(eventNumber++);
+    bytesRead = readEntry(eventNumber++);
+  }
+  if (bytesRead > 0)
+  {
+    m_EventsRead++;
   }
 
   gFile = file_ptr;  // recover gFile
@@ -327,6 +554,233 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
   return true;
 }
 
+int PHNodeIOManager::readEntry(size_t entry)
+{
+  if (!m_BranchStatistics)
+  {
+    return tree->GetEvent(entry);
+  }
+  // this is what TTree::GetEntry() does, done branch by branch so
+  // the time spent reading and decompressing each of them can be measured
+  if (tree->LoadTree(entry) < 0)
+  {
+    return 0;
+  }
+  int nbytes = 0;
+  for (auto& inbranch : m_InputBranches)
+  {
+    if (inbranch.branch->TestBit(kDoNotProcess))
+    {
+      continue;
+    }
+    auto starttime = std::chrono::steady_clock::now();
+    int nb = inbranch.branch->GetEntry(entry);
+    inbranch.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - starttime).count();
+    if (nb < 0)
+    {
+      return -1;
+    }
+    inbranch.entries++;
+    inbranch.bytes += nb;
+    nbytes += nb;
+  }
+  return nbytes;
+}
+
+void PHNodeIOManager::AdaptiveBranchSelect(const std::set<std::string>& branches)
+{
+  m_AdaptiveBranches = branches;
+  m_AdaptivePreset = true;
+}
+
+void PHNodeIOManager::applyAdaptiveBranchSelect()
+{
+  m_AdaptiveDone = true;
+  if (!m_AdaptivePreset)
+  {
+    m_AdaptiveBranches.clear();
+  }
+  for (auto& inbranch : m_InputBranches)
+  {
+    bool keep = false;
+    if (m_AlwaysRead.contains(inbranch.node->getName()))
+    {
+      keep = true;
+    }
+    else if (m_AdaptivePreset)
+    {
+      keep = m_AdaptiveBranches.contains(inbranch.name);
+    }
+    else
+    {
+      keep = inbranch.node->wasAccessed();
+    }
+    if (keep)
+    {
+      m_AdaptiveBranches.insert(inbranch.name);
+      continue;
+    }
+    inbranch.enabled = false;
+    tree->SetBranchStatus(inbranch.name.c_str(), false);
+    fBranches.erase(inbranch.name);
+    // do not leave the content of the last event read in the node
+    PHObject* obj = dynamic_cast<PHObject*>(static_cast<PHIODataNode<TObject>*>(inbranch.node)->peekData());  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+    if (obj)
+    {
+      obj->Reset();
+    }
+    inbranch.node->setAccessed(false);
+  }
+  // the cache only needs to know about the branches we still read
+  if (file->GetCacheRead(tree))
+  {
+    tree->DropBranchFromCache("*", true);
+    for (const auto& inbranch : m_InputBranches)
+    {
+      if (inbranch.enabled)
+      {
+        tree->AddBranchToCache(inbranch.name.c_str(), true);
+      }
+    }
+    tree->StopCacheLearningPhase();
+  }
+}
+
+void PHNodeIOManager::checkDisabledBranches()
+{
+  // a node which was not used during the learning phase is asked for
+  // now, it is empty for the current event but read from now on
+  for (auto& inbranch : m_InputBranches)
+  {
+    if (!inbranch.enabled && inbranch.node->wasAccessed())
+    {
+      std::cout << PHWHERE << " Node " << inbranch.node->getName()
+                << " was not used during the first " << m_AdaptiveEvents
+                << " events, it was empty in event " << eventNumber
+                << " and is read again from now on" << std::endl;
+      enableBranch(inbranch);
+    }
+  }
+}
+
+void PHNodeIOManager::enableBranch(InputBranch& inbranch)
+{
+  inbranch.enabled = true;
+  tree->SetBranchStatus(inbranch.name.c_str(), true);
+  fBranches[inbranch.name] = inbranch.branch;
+  m_AdaptiveBranches.insert(inbranch.name);
+  if (file->GetCacheRead(tree))
+  {
+    tree->AddBranchToCache(inbranch.name.c_str(), true);
+  }
+}
+
+void PHNodeIOManager::PrintBranchStatistics(std::ostream& os) const
+{
+  os << "PHNodeIOManager branch statistics for " << filename
+     << ", " << m_EventsRead << " events read" << std::endl;
+  if (m_AdaptiveDone)
+  {
+    os << "adaptive branch selection: reading " << m_AdaptiveBranches.size()
+       << " of " << m_InputBranches.size() << " branches" << std::endl;
+  }
+  double totseconds = 0;
+  uint64_t totbytes = 0;
+  os << std::setw(50) << std::left << "branch" << std::right
+     << std::setw(10) << "entries"
+     << std::setw(14) << "bytes"
+     << std::setw(14) << "bytes (zip)"
+     << std::setw(12) << "read [s]" << std::endl;
+  for (const auto& inbranch : m_InputBranches)
+  {
+    // the compressed size is estimated from the ratio of the whole branch
+    Long64_t totbranch = inbranch.branch->GetTotBytes("*");
+    double zipratio = (totbranch > 0) ? static_cast<double>(inbranch.branch->GetZipBytes("*")) / totbranch : 1.;
+    os << std::setw(50) << std::left << inbranch.name << std::right
+       << std::setw(10) << inbranch.entries
+       << std::setw(14) << inbranch.bytes
+       << std::setw(14) << static_cast<uint64_t>(inbranch.bytes * zipratio)
+       << std::setw(12) << std::setprecision(3) << inbranch.seconds;
+    if (!inbranch.enabled)
+    {
+      os << "  (off)";
+    }
+    os << std::endl;
+    totseconds += inbranch.seconds;
+    totbytes += inbranch.bytes;
+  }
+  os << std::setw(50) << std::left << "total" << std::right
+     << std::setw(10) << m_EventsRead
+     << std::setw(14) << totbytes
+     << std::setw(14) << ""
+     << std::setw(12) << std::setprecision(3) << totseconds << std::endl;
+}
+
+void PHNodeIOManager::PrintWriteStatistics(std::ostream& os)
+{
+  if (!tree)
+  {
+    return;
+  }
+  if (m_AsyncWriter)
+  {
+    m_AsyncWriter->drain();
+  }
+  // the sizes only count baskets written to the file, this is meant
+  // to be called when closing the file anyway
+  tree->FlushBaskets();
+  os << "PHNodeIOManager write statistics for " << filename
+     << ", " << eventNumber << " events written" << std::endl;
+  os << std::setw(50) << std::left << "branch" << std::right
+     << std::setw(10) << "entries"
+     << std::setw(14) << "bytes"
+     << std::setw(14) << "bytes (zip)"
+     << std::setw(8) << "ratio";
+  if (m_AsyncWriter)
+  {
+    os << std::setw(12) << "copy [s]";
+  }
+  os << std::endl;
+  Long64_t totbytes = 0;
+  Long64_t zipbytes = 0;
+  for (const auto& [path, outbranch] : m_OutputBranches)
+  {
+    TBranch* thisBranch = tree->GetBranch(path.c_str());
+    if (!thisBranch)
+    {
+      continue;
+    }
+    Long64_t branchtot = thisBranch->GetTotBytes("*");
+    Long64_t branchzip = thisBranch->GetZipBytes("*");
+    os << std::setw(50) << std::left << path << std::right
+       << std::setw(10) << outbranch.entries
+       << std::setw(14) << branchtot
+       << std::setw(14) << branchzip
+       << std::setw(8) << std::setprecision(3) << (branchzip > 0 ? static_cast<double>(branchtot) / branchzip : 0.);
+    if (m_AsyncWriter)
+    {
+      os << std::setw(12) << std::setprecision(3) << outbranch.seconds;
+    }
+    os << std::endl;
+    totbytes += branchtot;
+    zipbytes += branchzip;
+  }
+  os << std::setw(50) << std::left << "total" << std::right
+     << std::setw(10) << eventNumber
+     << std::setw(14) << totbytes
+     << std::setw(14) << zipbytes
+     << std::setw(8) << std::setprecision(3) << (zipbytes > 0 ? static_cast<double>(totbytes) / zipbytes : 0.)
+     << std::endl;
+  os << "time spent filling and compressing: " << m_FillSeconds << " s";
+  if (m_AsyncWriter)
+  {
+    os << " (on the writer thread), event thread waited "
+       << m_AsyncWriter->StallSeconds() << " s in "
+       << m_AsyncWriter->Stalls() << " stalls for a free queue slot";
+  }
+  os << std::endl;
+}
+
 int PHNodeIOManager::readSpecific(size_t requestedEvent, const std::string& objectName)
 {
   // objectName should be one of the valid branch name of the "T" TTree, and
@@ -465,7 +919,7 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
     }
     else
     {
-      TObject* oldobject = newIODataNode->getData();
+      TObject* oldobject = newIODataNode->peekData();
       std::string oldclass = oldobject->ClassName();
       if (oldclass != branchClassName)
       {
@@ -498,6 +952,11 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
       newIODataNode->setObjectType("PHObject");
     }
     thisBranch->SetAddress(&(newIODataNode->data));
+    InputBranch inbranch;
+    inbranch.name = branchName;
+    inbranch.branch = thisBranch;
+    inbranch.node = newIODataNode;
+    m_InputBranches.push_back(inbranch);
     for (j = 1; j < splitvec.size() - 1; j++)
     {
       nodeIter.cd("..");
@@ -566,6 +1025,24 @@ PHNodeIOManager::GetFileSize()
   return 0.;
 }
 
+int64_t PHNodeIOManager::GetEntries() const
+{
+  if (tree)
+  {
+    return tree->GetEntries();
+  }
+  return -1;
+}
+
+std::string PHNodeIOManager::GetFileUUID() const
+{
+  if (file)
+  {
+    return file->GetUUID().AsString();
+  }
+  return "";
+}
+
 std::map<std::string, TBranch*>*
 PHNodeIOManager::GetBranchMap()
 {
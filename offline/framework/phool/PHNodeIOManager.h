@@ -11,11 +11,15 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <iostream>
 #include <limits>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
+class PHNode;
 class TBranch;
 class TFile;
 class TObject;
@@ -45,6 +49,10 @@ class PHNodeIOManager : public PHIOManager
   bool SetCompressionSetting(const int level);
   uint64_t GetBytesWritten();
   uint64_t GetFileSize();
+  // number of entries in the tree, -1 before the first read
+  int64_t GetEntries() const;
+  // unique id of the file, stays the same when it is copied
+  std::string GetFileUUID() const;
   std::map<std::string, TBranch *> *GetBranchMap();
 
   bool write(TObject **, const std::string &, int nodebuffersize, int nodesplitlevel);
@@ -59,10 +67,64 @@ class PHNodeIOManager : public PHIOManager
   
   void DisableReadCache();
 
+  // adaptive branch selection: during the first nevents all selected
+  // branches are read, afterwards only the branches whose node data was
+  // used (PHDataNode::getData(), which findNode::getClass and the node
+  // iterators go through) or written out by an output manager are read
+  // and added to the TTreeCache. Objects only reached through pointers
+  // held elsewhere are not seen, keep their nodes with AlwaysRead()
+  // (0 switches it off)
+  void AdaptiveBranchSelect(const uint64_t nevents) { m_AdaptiveEvents = nevents; }
+  // skip the learning and use the branches learned on a previous file
+  void AdaptiveBranchSelect(const std::set<std::string> &branches);
+  bool AdaptiveBranchSelectDone() const { return m_AdaptiveDone; }
+  const std::set<std::string> &AdaptiveBranches() const { return m_AdaptiveBranches; }
+  // the branch of this node is never switched off by the adaptive selection
+  void AlwaysRead(const std::string &nodename) { m_AlwaysRead.insert(nodename); }
+
+  // fill and compress on a separate writer thread, the event thread only
+  // makes copies of the persistent objects and hands them over through a
+  // queue of at most depth events (0 writes synchronously)
+  void AsyncWrite(const unsigned int depth);
+  unsigned int AsyncWrite() const { return m_AsyncWriteDepth; }
+  // per branch compressed/uncompressed size and write time, waits for
+  // the writer thread to catch up
+  void PrintWriteStatistics(std::ostream &os = std::cout);
+
+  // time and count the bytes of each branch read
+  void BranchStatistics(const bool b) { m_BranchStatistics = b; }
+  bool BranchStatistics() const { return m_BranchStatistics; }
+  void PrintBranchStatistics(std::ostream &os = std::cout) const;
+
 private:
+  class AsyncWriter;
+
+  struct OutputBranch
+  {
+    uint64_t entries{0};
+    uint64_t bytes{0};
+    double seconds{0};
+  };
+
+  struct InputBranch
+  {
+    std::string name;
+    TBranch *branch{nullptr};
+    PHNode *node{nullptr};
+    bool enabled{true};
+    uint64_t entries{0};
+    uint64_t bytes{0};
+    double seconds{0};
+  };
+
   int FillBranchMap();
   PHCompositeNode *reconstructNodeTree(PHCompositeNode *);
   bool readEventFromFile(size_t requestedEvent);
+  int readEntry(size_t entry);
+  void applyAdaptiveBranchSelect();
+  void checkDisabledBranches();
+  void enableBranch(InputBranch &inbranch);
+  bool createBranch(TObject **data, const std::string &path, int nodebuffersize, int nodesplitlevel);
   static std::string getBranchClassName(TBranch *);
 
   TFile *file{nullptr};
@@ -76,6 +138,18 @@ private:
   int splitlevel{std::numeric_limits<int>::min()};
   std::map<std::string, TBranch *> fBranches;
   std::map<std::string, bool> objectToRead;
+  std::vector<InputBranch> m_InputBranches;
+  std::set<std::string> m_AdaptiveBranches;
+  std::set<std::string> m_AlwaysRead;
+  uint64_t m_AdaptiveEvents{0};
+  uint64_t m_EventsRead{0};
+  bool m_AdaptivePreset{false};
+  bool m_AdaptiveDone{false};
+  bool m_BranchStatistics{false};
+  AsyncWriter *m_AsyncWriter{nullptr};
+  unsigned int m_AsyncWriteDepth{0};
+  std::map<std::string, OutputBranch> m_OutputBranches;
+  double m_FillSeconds{0};
 };
 
 #endif
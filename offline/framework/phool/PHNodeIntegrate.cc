@@ -21,7 +21,7 @@ void PHNodeIntegrate::perform(PHNode *node)
     if (node->getObjectType() == "PHObject")
     {
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
-      PHObject *obj = static_cast<PHDataNode<PHObject> *>(node)->getData();
+      PHObject *obj = static_cast<PHDataNode<PHObject> *>(node)->peekData();
       if (obj->Integrate())
       {
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
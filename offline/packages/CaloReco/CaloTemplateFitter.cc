@@ -0,0 +1,358 @@
+#include "CaloTemplateFitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  //! number of waveforms processed together in fit_batch
+  constexpr std::size_t batch_size = 8;
+
+  //! relative precision on time for the golden section refinement, in samples
+  constexpr double time_tolerance = 1e-6;
+
+  //! least-squares amplitude and pedestal for given sums. Returns false for degenerate template values
+  bool solve(double n, double sx, double sxx, double sy, double sxy, double &amplitude, double &pedestal)
+  {
+    const double det = n * sxx - sx * sx;
+    if (!(det > 1e-12 * n * sxx))
+    {
+      amplitude = 0;
+      pedestal = sy / n;
+      return false;
+    }
+
+    amplitude = (n * sxy - sx * sy) / det;
+    pedestal = (sy - amplitude * sx) / n;
+    return true;
+  }
+}  // namespace
+
+//____________________________________________________________________________..
+void CaloTemplateFitter::set_template(const std::vector<float> &values, double xmin, double step)
+{
+  m_template.assign(values.begin(), values.end());
+  m_template_xmin = xmin;
+  m_template_inverse_step = 1. / step;
+
+  // tables depend on the template
+  m_tables.clear();
+}
+
+//____________________________________________________________________________..
+double CaloTemplateFitter::template_value(double x) const
+{
+  const double u = (x - m_template_xmin) * m_template_inverse_step;
+  if (!(u > 0))
+  {
+    return m_template.front();
+  }
+
+  const std::size_t last = m_template.size() - 1;
+  if (u >= last)
+  {
+    return m_template.back();
+  }
+
+  const std::size_t index = u;
+  const double fraction = u - index;
+  return m_template[index] + fraction * (m_template[index + 1] - m_template[index]);
+}
+
+//____________________________________________________________________________..
+void CaloTemplateFitter::prepare(int nsamples, double tmin, double tmax)
+{
+  if (!find_table(nsamples, tmin, tmax))
+  {
+    m_tables.push_back(make_table(nsamples, tmin, tmax));
+  }
+}
+
+//____________________________________________________________________________..
+const CaloTemplateFitter::ScanTable *CaloTemplateFitter::find_table(int nsamples, double tmin, double tmax) const
+{
+  for (const auto &table : m_tables)
+  {
+    if (table.nsamples == nsamples && table.tmin == tmin && table.tmax == tmax)
+    {
+      return &table;
+    }
+  }
+  return nullptr;
+}
+
+//____________________________________________________________________________..
+CaloTemplateFitter::ScanTable CaloTemplateFitter::make_table(int nsamples, double tmin, double tmax) const
+{
+  ScanTable table;
+  table.nsamples = nsamples;
+  table.tmin = tmin;
+  table.tmax = tmax;
+  if (tmax > tmin)
+  {
+    table.npoints = std::max<int>(2, std::ceil((tmax - tmin) / m_scan_step) + 1);
+    table.step = (tmax - tmin) / (table.npoints - 1);
+  }
+  else
+  {
+    table.npoints = 1;
+    table.step = 0;
+  }
+
+  table.values.resize(static_cast<std::size_t>(table.npoints) * nsamples);
+  table.sum.resize(table.npoints);
+  table.sum2.resize(table.npoints);
+  for (int k = 0; k < table.npoints; ++k)
+  {
+    const double time = tmin + k * table.step;
+    double *row = &table.values[static_cast<std::size_t>(k) * nsamples];
+    double sum = 0;
+    double sum2 = 0;
+    for (int i = 0; i < nsamples; ++i)
+    {
+      row[i] = template_value(i - time);
+      sum += row[i];
+      sum2 += row[i] * row[i];
+    }
+    table.sum[k] = sum;
+    table.sum2[k] = sum2;
+  }
+  return table;
+}
+
+//____________________________________________________________________________..
+CaloTemplateFitter::Result CaloTemplateFitter::fit(const float *samples, const unsigned char *use, int nsamples, double tmin, double tmax) const
+{
+  const ScanTable *table = find_table(nsamples, tmin, tmax);
+  ScanTable local_table;
+  if (!table)
+  {
+    local_table = make_table(nsamples, tmin, tmax);
+    table = &local_table;
+  }
+
+  double n = 0;
+  double sy = 0;
+  for (int i = 0; i < nsamples; ++i)
+  {
+    if (!use || use[i])
+    {
+      n += 1;
+      sy += samples[i];
+    }
+  }
+
+  if (n < 1)
+  {
+    Result result;
+    result.status = 1;
+    return result;
+  }
+
+  // time scan
+  int best = 0;
+  double best_chi2 = std::numeric_limits<double>::max();
+  for (int k = 0; k < table->npoints; ++k)
+  {
+    const double *row = &table->values[static_cast<std::size_t>(k) * nsamples];
+    double sx = 0;
+    double sxx = 0;
+    double sxy = 0;
+    double syy = 0;
+    for (int i = 0; i < nsamples; ++i)
+    {
+      if (!use || use[i])
+      {
+        sx += row[i];
+        sxx += row[i] * row[i];
+        sxy += row[i] * samples[i];
+        syy += static_cast<double>(samples[i]) * samples[i];
+      }
+    }
+
+    double amplitude = 0;
+    double pedestal = 0;
+    solve(n, sx, sxx, sy, sxy, amplitude, pedestal);
+    const double chi2 = syy - amplitude * sxy - pedestal * sy;
+    if (chi2 < best_chi2)
+    {
+      best_chi2 = chi2;
+      best = k;
+    }
+  }
+
+  return refine(samples, use, nsamples, *table, best);
+}
+
+//____________________________________________________________________________..
+void CaloTemplateFitter::fit_batch(const float *const *samples, std::size_t nwaveforms, int nsamples, double tmin, double tmax, Result *results) const
+{
+  const ScanTable *table = find_table(nsamples, tmin, tmax);
+  ScanTable local_table;
+  if (!table)
+  {
+    local_table = make_table(nsamples, tmin, tmax);
+    table = &local_table;
+  }
+
+  const double n = nsamples;
+  std::vector<double> y(static_cast<std::size_t>(nsamples) * batch_size);
+  for (std::size_t start = 0; start < nwaveforms; start += batch_size)
+  {
+    const std::size_t nbatch = std::min(batch_size, nwaveforms - start);
+
+    // samples, transposed so that waveforms are contiguous. Padding waveforms are zero
+    double sy[batch_size] = {};
+    double syy[batch_size] = {};
+    std::fill(y.begin(), y.end(), 0);
+    for (std::size_t b = 0; b < nbatch; ++b)
+    {
+      for (int i = 0; i < nsamples; ++i)
+      {
+        const double value = samples[start + b][i];
+        y[i * batch_size + b] = value;
+        sy[b] += value;
+        syy[b] += value * value;
+      }
+    }
+
+    // time scan, for all waveforms in the batch at once
+    double best_chi2[batch_size];
+    int best[batch_size] = {};
+    std::fill(best_chi2, best_chi2 + batch_size, std::numeric_limits<double>::max());
+    for (int k = 0; k < table->npoints; ++k)
+    {
+      const double *row = &table->values[static_cast<std::size_t>(k) * nsamples];
+      double sxy[batch_size] = {};
+      for (int i = 0; i < nsamples; ++i)
+      {
+        const double value = row[i];
+        const double *yi = &y[i * batch_size];
+        for (std::size_t b = 0; b < batch_size; ++b)
+        {
+          sxy[b] += value * yi[b];
+        }
+      }
+
+      const double sx = table->sum[k];
+      const double sxx = table->sum2[k];
+      const double det = n * sxx - sx * sx;
+      const bool valid = det > 1e-12 * n * sxx;
+      for (std::size_t b = 0; b < batch_size; ++b)
+      {
+        const double amplitude = valid ? (n * sxy[b] - sx * sy[b]) / det : 0;
+        const double pedestal = (sy[b] - amplitude * sx) / n;
+        const double chi2 = syy[b] - amplitude * sxy[b] - pedestal * sy[b];
+        const bool better = chi2 < best_chi2[b];
+        best_chi2[b] = better ? chi2 : best_chi2[b];
+        best[b] = better ? k : best[b];
+      }
+    }
+
+    for (std::size_t b = 0; b < nbatch; ++b)
+    {
+      results[start + b] = refine(samples[start + b], nullptr, nsamples, *table, best[b]);
+    }
+  }
+}
+
+//____________________________________________________________________________..
+CaloTemplateFitter::Result CaloTemplateFitter::refine(const float *samples, const unsigned char *use, int nsamples, const ScanTable &table, int best) const
+{
+  double amplitude = 0;
+  double pedestal = 0;
+  double time = table.tmin + best * table.step;
+  double best_chi2 = chi2(samples, use, nsamples, time, amplitude, pedestal);
+
+  // golden section search between neighboring scan points
+  if (table.npoints > 1)
+  {
+    constexpr double ratio = 0.6180339887498949;
+    double low = table.tmin + std::max(best - 1, 0) * table.step;
+    double high = table.tmin + std::min(best + 1, table.npoints - 1) * table.step;
+    double x1 = high - ratio * (high - low);
+    double x2 = low + ratio * (high - low);
+    double a = 0;
+    double p = 0;
+    double f1 = chi2(samples, use, nsamples, x1, a, p);
+    double f2 = chi2(samples, use, nsamples, x2, a, p);
+    while (high - low > time_tolerance)
+    {
+      if (f1 < f2)
+      {
+        high = x2;
+        x2 = x1;
+        f2 = f1;
+        x1 = high - ratio * (high - low);
+        f1 = chi2(samples, use, nsamples, x1, a, p);
+      }
+      else
+      {
+        low = x1;
+        x1 = x2;
+        f1 = f2;
+        x2 = low + ratio * (high - low);
+        f2 = chi2(samples, use, nsamples, x2, a, p);
+      }
+    }
+
+    // keep scan point if refinement did not improve
+    const double refined_time = 0.5 * (low + high);
+    const double refined_chi2 = chi2(samples, use, nsamples, refined_time, a, p);
+    if (refined_chi2 <= best_chi2)
+    {
+      time = refined_time;
+      best_chi2 = refined_chi2;
+      amplitude = a;
+      pedestal = p;
+    }
+  }
+
+  Result result;
+  result.amplitude = amplitude;
+  result.time = time;
+  result.pedestal = pedestal;
+  result.chi2 = best_chi2;
+  for (int i = 0; i < nsamples; ++i)
+  {
+    result.ndata += (!use || use[i]) ? 1 : 0;
+  }
+  result.status = 0;
+  return result;
+}
+
+//____________________________________________________________________________..
+double CaloTemplateFitter::chi2(const float *samples, const unsigned char *use, int nsamples, double time, double &amplitude, double &pedestal) const
+{
+  double count = 0;
+  double sx = 0;
+  double sxx = 0;
+  double sy = 0;
+  double sxy = 0;
+  for (int i = 0; i < nsamples; ++i)
+  {
+    if (!use || use[i])
+    {
+      const double value = template_value(i - time);
+      count += 1;
+      sx += value;
+      sxx += value * value;
+      sy += samples[i];
+      sxy += value * samples[i];
+    }
+  }
+
+  solve(count, sx, sxx, sy, sxy, amplitude, pedestal);
+
+  double chi2 = 0;
+  for (int i = 0; i < nsamples; ++i)
+  {
+    if (!use || use[i])
+    {
+      const double residual = samples[i] - amplitude * template_value(i - time) - pedestal;
+      chi2 += residual * residual;
+    }
+  }
+  return chi2;
+}
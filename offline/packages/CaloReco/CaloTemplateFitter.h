@@ -0,0 +1,108 @@
+#ifndef CALORECO_CALOTEMPLATEFITTER_H
+#define CALORECO_CALOTEMPLATEFITTER_H
+
+#include <cstddef>
+#include <vector>
+
+//! Least-squares fit of waveforms to a pulse template, without ROOT
+/*!
+ * The model is y_i = amplitude * T(i - time) + pedestal, with unit errors on all samples,
+ * and T the template, linearly interpolated between samples and constant beyond its ends
+ * (same as TH1::Interpolate on the template TProfile).
+ *
+ * For a fixed time, amplitude and pedestal follow from a closed form 2x2 linear solve,
+ * so that only the time is minimized numerically: a scan on a regular grid within the time
+ * limits, followed by a golden section refinement around the best grid point.
+ *
+ * The template values at the scan grid points only depend on the number of samples and
+ * the time limits. They are tabulated by prepare(), which must be called before fitting
+ * from multiple threads. The fit methods are const and thread-safe.
+ * fit_batch() evaluates the scan for several waveforms at once, as a small matrix product
+ * over contiguous arrays that the compiler vectorizes.
+ */
+class CaloTemplateFitter
+{
+ public:
+  //! fit result
+  struct Result
+  {
+    float amplitude = 0;
+    float time = 0;
+    float pedestal = 0;
+
+    //! sum of squared residuals, not normalized
+    float chi2 = 0;
+
+    //! number of samples used in the fit
+    int ndata = 0;
+
+    //! 0 on success
+    int status = 0;
+  };
+
+  //! set template values, sampled on a uniform grid starting at xmin
+  void set_template(const std::vector<float> &values, double xmin, double step);
+
+  //! true if template is set
+  bool has_template() const { return !m_template.empty(); }
+
+  //! template value, linearly interpolated
+  double template_value(double x) const;
+
+  //! scan step, in samples
+  void set_scan_step(double step) { m_scan_step = step; }
+
+  //! tabulate the time scan for a given number of samples and time limits. Not thread safe
+  void prepare(int nsamples, double tmin, double tmax);
+
+  //! fit one waveform. Samples for which use is zero are ignored. use can be null to use all samples
+  Result fit(const float *samples, const unsigned char *use, int nsamples, double tmin, double tmax) const;
+
+  //! fit nwaveforms waveforms, all samples used, with the same number of samples and time limits
+  void fit_batch(const float *const *samples, std::size_t nwaveforms, int nsamples, double tmin, double tmax, Result *results) const;
+
+ private:
+  //! tabulated template values at scan times
+  struct ScanTable
+  {
+    int nsamples = 0;
+    double tmin = 0;
+    double tmax = 0;
+
+    //! number of scan points, and step between them
+    int npoints = 0;
+    double step = 0;
+
+    //! template values, npoints x nsamples
+    std::vector<double> values;
+
+    //! sum and sum of squares of template values over all samples, for each scan point
+    std::vector<double> sum;
+    std::vector<double> sum2;
+  };
+
+  //! find table matching parameters, null if not prepared
+  const ScanTable *find_table(int nsamples, double tmin, double tmax) const;
+
+  //! build table
+  ScanTable make_table(int nsamples, double tmin, double tmax) const;
+
+  //! refine time around a scan point and fill result
+  Result refine(const float *samples, const unsigned char *use, int nsamples, const ScanTable &table, int best) const;
+
+  //! chi2 at a given time, with best amplitude and pedestal
+  double chi2(const float *samples, const unsigned char *use, int nsamples, double time, double &amplitude, double &pedestal) const;
+
+  //! template values on a uniform grid
+  std::vector<double> m_template;
+  double m_template_xmin = 0;
+  double m_template_inverse_step = 1;
+
+  //! scan step, in samples
+  double m_scan_step = 0.05;
+
+  //! prepared scan tables
+  std::vector<ScanTable> m_tables;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #define CALORECO_CALOTOWERBUILDER_H
 
 #include "CaloTowerDefs.h"
+#include "CaloWaveformBatch.h"
 #include "CaloWaveformProcessing.h"
 
 #include <cdbobjects/CDBTTree.h>  // for CDBTTree
@@ -29,7 +30,7 @@ public:
 
   void CreateNodeTree(PHCompositeNode *topNode);
 
-  int process_data(PHCompositeNode *topNode, std::vector<std::vector<float>> &waveforms);
+  int process_data(PHCompositeNode *topNode, CaloWaveformBatch &waveforms);
 
   void set_detector_type(CaloTowerDefs::DetectorSystem dettype)
   {
@@ -140,6 +141,9 @@ private:
   CDBTTree *cdbttree_sepd_map = nullptr;
   CDBTTree *cdbttree_tbt_zs = nullptr;
 
+  // waveforms of the current event, memory is reused between events
+  CaloWaveformBatch m_waveforms;
+
   bool m_isdata{true};
   bool m_bdosoftwarezerosuppression{false};
   bool m_UseOfflinePacketFlag{false};
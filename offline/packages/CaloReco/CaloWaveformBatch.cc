@@ -0,0 +1,83 @@
+#include "CaloWaveformBatch.h"
+
+#include <algorithm>
+
+void CaloWaveformBatch::reset(int stride)
+{
+  m_stride = stride;
+  clear();
+}
+
+void CaloWaveformBatch::clear()
+{
+  m_samples.clear();
+  m_nsamples.clear();
+  for (auto &column : m_results)
+  {
+    column.clear();
+  }
+}
+
+float *CaloWaveformBatch::add_channel(int nsamples)
+{
+  if (nsamples > m_stride)
+  {
+    // channels with more samples than the stride: repack existing channels with the larger stride
+    std::vector<float> samples(m_nsamples.size() * nsamples);
+    for (std::size_t ch = 0; ch < m_nsamples.size(); ++ch)
+    {
+      std::copy_n(&m_samples[ch * m_stride], m_nsamples[ch], &samples[ch * nsamples]);
+    }
+    m_samples.swap(samples);
+    m_stride = nsamples;
+  }
+
+  const std::size_t channel = m_nsamples.size();
+  m_nsamples.push_back(nsamples);
+  m_samples.resize(m_samples.size() + m_stride);
+  for (auto &column : m_results)
+  {
+    column.push_back(0);
+  }
+  return &m_samples[channel * m_stride];
+}
+
+void CaloWaveformBatch::add_channel(const std::vector<float> &samples)
+{
+  std::copy(samples.begin(), samples.end(), add_channel(samples.size()));
+}
+
+std::vector<float> CaloWaveformBatch::get_waveform(std::size_t channel) const
+{
+  const float *samples = get_samples(channel);
+  return {samples, samples + m_nsamples[channel]};
+}
+
+void CaloWaveformBatch::set_results(std::size_t channel, float amplitude, float time, float pedestal, float chi2, float recovered, float status)
+{
+  m_results[AMPLITUDE][channel] = amplitude;
+  m_results[TIME][channel] = time;
+  m_results[PEDESTAL][channel] = pedestal;
+  m_results[CHI2][channel] = chi2;
+  m_results[RECOVERED][channel] = recovered;
+  m_results[STATUS][channel] = status;
+}
+
+void CaloWaveformBatch::set_results(std::size_t channel, const std::vector<float> &values)
+{
+  const std::size_t n = std::min<std::size_t>(values.size(), NRESULTS);
+  for (std::size_t r = 0; r < n; ++r)
+  {
+    m_results[r][channel] = values[r];
+  }
+}
+
+std::vector<float> CaloWaveformBatch::get_results(std::size_t channel) const
+{
+  std::vector<float> values(NRESULTS);
+  for (std::size_t r = 0; r < NRESULTS; ++r)
+  {
+    values[r] = m_results[r][channel];
+  }
+  return values;
+}
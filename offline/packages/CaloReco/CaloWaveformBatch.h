@@ -0,0 +1,73 @@
+#ifndef CALORECO_CALOWAVEFORMBATCH_H
+#define CALORECO_CALOWAVEFORMBATCH_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+//! contiguous storage of the waveforms of one event, and of their processing results
+/*!
+ * Samples are stored channel major with a fixed stride, the largest number of samples
+ * per channel. Each channel has its own number of samples (e.g. 2 for zero suppressed channels).
+ * Results are stored in one column per quantity, allocated when channels are added.
+ * Memory is kept between events: clear() only resets the number of channels.
+ */
+class CaloWaveformBatch
+{
+ public:
+  //! processing results
+  enum result
+  {
+    AMPLITUDE = 0,
+    TIME = 1,
+    PEDESTAL = 2,
+    CHI2 = 3,
+    RECOVERED = 4,
+    STATUS = 5,
+    NRESULTS = 6
+  };
+
+  //! remove all channels and set the sample stride
+  void reset(int stride);
+
+  //! remove all channels, keeping the stride and allocated memory
+  void clear();
+
+  //! add a channel with nsamples samples. Returns pointer to its samples, to be filled by the caller.
+  //! The pointer is invalidated when the next channel is added
+  float *add_channel(int nsamples);
+
+  //! add a channel, copying the samples
+  void add_channel(const std::vector<float> &samples);
+
+  std::size_t size() const { return m_nsamples.size(); }
+  bool empty() const { return m_nsamples.empty(); }
+  int get_stride() const { return m_stride; }
+
+  int get_nsamples(std::size_t channel) const { return m_nsamples[channel]; }
+  const float *get_samples(std::size_t channel) const { return &m_samples[channel * m_stride]; }
+  float *get_samples(std::size_t channel) { return &m_samples[channel * m_stride]; }
+
+  //! copy of the samples of a channel
+  std::vector<float> get_waveform(std::size_t channel) const;
+
+  float get_result(std::size_t channel, result r) const { return m_results[r][channel]; }
+  void set_result(std::size_t channel, result r, float value) { m_results[r][channel] = value; }
+
+  //! set all results of a channel at once
+  void set_results(std::size_t channel, float amplitude, float time, float pedestal, float chi2, float recovered, float status);
+
+  //! set all results of a channel from a vector ordered as the result enum
+  void set_results(std::size_t channel, const std::vector<float> &values);
+
+  //! all results of a channel, ordered as the result enum
+  std::vector<float> get_results(std::size_t channel) const;
+
+ private:
+  int m_stride{0};
+  std::vector<float> m_samples;
+  std::vector<int> m_nsamples;
+  std::array<std::vector<float>, NRESULTS> m_results;
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <iostream>
 #include <limits>
+#include <numeric>
 #include <string>
 
 static ROOT::TThreadExecutor *t = new ROOT::TThreadExecutor(1);  // NOLINT(misc-use-anonymous-namespace)
@@ -45,41 +46,109 @@ void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
   fin->Close();
   delete fin;
   m_peakTimeTemp = h_template->GetBinCenter(h_template->GetMaximumBin());
+
+  // template lookup table for the ROOT-free fitter. Matches TProfile::Interpolate
+  std::vector<float> template_values;
+  template_values.reserve(h_template->GetNbinsX());
+  for (int i = 1; i <= h_template->GetNbinsX(); ++i)
+  {
+    template_values.push_back(h_template->GetBinContent(i));
+  }
+  m_template_fitter.set_template(template_values, h_template->GetBinCenter(1), h_template->GetBinWidth(1));
+
   t = new ROOT::TThreadExecutor(_nthreads);
 }
 
 std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(std::vector<std::vector<float>> waveformvector)
 {
-  int size1 = waveformvector.size();
-  std::vector<std::vector<float>> fitresults;
-  for (int i = 0; i < size1; i++)
+  CaloWaveformBatch batch;
+  fill_batch(batch, waveformvector, false);
+  calo_processing_templatefit(batch);
+  return batch_results(batch);
+}
+
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit(std::vector<std::vector<float>> chnlvector)
+{
+  // the last element of each waveform is the channel index
+  CaloWaveformBatch batch;
+  fill_batch(batch, chnlvector, true);
+  calo_processing_templatefit(batch);
+  return batch_results(batch);
+}
+
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit_fast(const std::vector<std::vector<float>> &chnlvector)
+{
+  CaloWaveformBatch batch;
+  fill_batch(batch, chnlvector, false);
+  calo_processing_templatefit_fast(batch);
+  return batch_results(batch);
+}
+
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(const std::vector<std::vector<float>> &chnlvector)
+{
+  CaloWaveformBatch batch;
+  fill_batch(batch, chnlvector, false);
+  calo_processing_fast(batch);
+  return batch_results(batch);
+}
+
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_nyquist(const std::vector<std::vector<float>> &chnlvector)
+{
+  CaloWaveformBatch batch;
+  fill_batch(batch, chnlvector, false);
+  calo_processing_nyquist(batch);
+  return batch_results(batch);
+}
+
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_funcfit(const std::vector<std::vector<float>> &chnlvector)
+{
+  CaloWaveformBatch batch;
+  fill_batch(batch, chnlvector, false);
+  calo_processing_funcfit(batch);
+  return batch_results(batch);
+}
+
+void CaloWaveformFitting::fill_batch(CaloWaveformBatch &batch, const std::vector<std::vector<float>> &chnlvector, bool has_index)
+{
+  int stride = 0;
+  for (const auto &v : chnlvector)
   {
-    waveformvector.at(i).push_back(i);
+    stride = std::max<int>(stride, v.size());
+  }
+  batch.reset(stride);
+  for (const auto &v : chnlvector)
+  {
+    const int nsamples = has_index ? v.size() - 1 : v.size();
+    std::copy_n(v.begin(), nsamples, batch.add_channel(nsamples));
   }
-  fitresults = calo_processing_templatefit(waveformvector);
-  return fitresults;
 }
 
-std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit(std::vector<std::vector<float>> chnlvector)
+std::vector<std::vector<float>> CaloWaveformFitting::batch_results(const CaloWaveformBatch &batch)
+{
+  std::vector<std::vector<float>> fit_params;
+  fit_params.reserve(batch.size());
+  for (std::size_t ch = 0; ch < batch.size(); ++ch)
+  {
+    fit_params.push_back(batch.get_results(ch));
+  }
+  return fit_params;
+}
+
+void CaloWaveformFitting::calo_processing_templatefit(CaloWaveformBatch &batch)
 {
-  auto func = [&](std::vector<float> &v)
+  auto func = [&](unsigned int channel)
   {
-    int size1 = v.size() - 1;
+    const float *v = batch.get_samples(channel);
+    int size1 = batch.get_nsamples(channel);
     if (size1 == _nzerosuppresssamples)
     {
-      v.push_back(v.at(1) - v.at(0));                        // returns peak sample - pedestal sample
-      v.push_back(std::numeric_limits<float>::quiet_NaN());  // set time to qnan for ZS
-      v.push_back(v.at(0));
-      if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
-      {
-        v.push_back(1000000);
-      }
-      else
+      float chi2 = std::numeric_limits<float>::quiet_NaN();
+      if (v[0] != 0 && v[1] == 0)  // check if post-sample is 0, if so set high chi2
       {
-        v.push_back(std::numeric_limits<float>::quiet_NaN());
+        chi2 = 1000000;
       }
-      v.push_back(0);
-      v.push_back(0);
+      // returns peak sample - pedestal sample, time set to qnan for ZS
+      batch.set_results(channel, v[1] - v[0], std::numeric_limits<float>::quiet_NaN(), v[0], chi2, 0, 0);
     }
     else
     {
@@ -87,55 +156,48 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
       int maxbin = 0;
       for (int i = 0; i < size1; i++)
       {
-        if (v.at(i) > maxheight)
+        if (v[i] > maxheight)
         {
-          maxheight = v.at(i);
+          maxheight = v[i];
           maxbin = i;
         }
       }
       float pedestal = 1500;
       if (maxbin > 4)
       {
-        pedestal = 0.5 * (v.at(maxbin - 4) + v.at(maxbin - 5));
+        pedestal = 0.5 * (v[maxbin - 4] + v[maxbin - 5]);
       }
       else if (maxbin > 3)
       {
-        pedestal = (v.at(maxbin - 4));
+        pedestal = (v[maxbin - 4]);
       }
       else
       {
-        pedestal = 0.5 * (v.at(size1 - 3) + v.at(size1 - 2));
+        pedestal = 0.5 * (v[size1 - 3] + v[size1 - 2]);
       }
 
-      if ((_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+      if ((_bdosoftwarezerosuppression && v[6] - v[0] < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
       {
-        v.push_back(v.at(6) - v.at(0));
-        v.push_back(std::numeric_limits<float>::quiet_NaN());
-        v.push_back(v.at(0));
-        if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
+        float chi2 = std::numeric_limits<float>::quiet_NaN();
+        if (v[0] != 0 && v[1] == 0)  // check if post-sample is 0, if so set high chi2
         {
-          v.push_back(1000000);
+          chi2 = 1000000;
         }
-        else
-        {
-          v.push_back(std::numeric_limits<float>::quiet_NaN());
-        }
-        v.push_back(0);
-        v.push_back(0);
+        batch.set_results(channel, v[6] - v[0], std::numeric_limits<float>::quiet_NaN(), v[0], chi2, 0, 0);
       }
       else
       {
-        auto *h = new TH1F(std::string("h_" + std::to_string((int) round(v.at(size1)))).c_str(), "", size1, -0.5, size1 - 0.5);
+        auto *h = new TH1F(std::string("h_" + std::to_string(channel)).c_str(), "", size1, -0.5, size1 - 0.5);
 
         int ndata = 0;
         for (int i = 0; i < size1; ++i)
         {
-          if ((v.at(i) == 16383) && _handleSaturation)
+          if ((v[i] == 16383) && _handleSaturation)
           {
             continue;
           }
 
-          h->SetBinContent(i + 1, v.at(i));
+          h->SetBinContent(i + 1, v[i]);
           h->SetBinError(i + 1, 1);
           ndata++;
         }
@@ -145,14 +207,14 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
           ndata = size1;
           for (int i = 0; i < size1; ++i)
           {
-            h->SetBinContent(i + 1, v.at(i));
+            h->SetBinContent(i + 1, v[i]);
             h->SetBinError(i + 1, 1);
           }
         }
 
-        auto *f = new TF1(std::string("f_" + std::to_string((int) round(v.at(size1)))).c_str(), this, &CaloWaveformFitting::template_function, 0, 31, 3, "CaloWaveformFitting", "template_function");
+        auto *f = new TF1(std::string("f_" + std::to_string(channel)).c_str(), this, &CaloWaveformFitting::template_function, 0, 31, 3, "CaloWaveformFitting", "template_function");
         ROOT::Math::WrappedMultiTF1 *fitFunction = new ROOT::Math::WrappedMultiTF1(*f, 3);
-        ROOT::Fit::BinData data(v.size() - 1, 1);
+        ROOT::Fit::BinData data(size1, 1);
         ROOT::Fit::FillData(data, h);
         ROOT::Fit::Chi2Function *EPChi2 = new ROOT::Fit::Chi2Function(data, *fitFunction);
         ROOT::Fit::Fitter *fitter = new ROOT::Fit::Fitter();
@@ -176,7 +238,7 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
           std::cout<<"invalid fit status in waveform fitting: " << validfit <<std::endl;
           for (int i = 0; i < size1; ++i)
         {
-          std::cout<<v.at(i) << " ";
+          std::cout<<v[i] << " ";
         }
         std::cout<<std::endl;
         }
@@ -186,12 +248,7 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
         chi2min /= ndata - 3;  // divide by the number of dof
         if (chi2min > _chi2threshold && (f->GetParameter(2) < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (f->GetParameter(2) > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery)
         {
-          std::vector<float> rv;  // temporary recovered waveform
-          rv.reserve(size1);
-          for (int i = 0; i < size1; i++)
-          {
-            rv.push_back(v.at(i));
-          }
+          std::vector<float> rv(v, v + size1);  // temporary recovered waveform
           unsigned int bits[3] = {8192, 4096, 2048};
           for (auto bit : bits)
           {
@@ -232,7 +289,7 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
             pedestal = 0.5 * (rv.at(size1 - 3) + rv.at(size1 - 2));
           }
 
-          auto *recover_f = new TF1(std::string("recover_f_" + std::to_string((int) round(v.at(size1)))).c_str(), this, &CaloWaveformFitting::template_function, 0, 31, 3, "CaloWaveformFitting", "template_function");
+          auto *recover_f = new TF1(std::string("recover_f_" + std::to_string(channel)).c_str(), this, &CaloWaveformFitting::template_function, 0, 31, 3, "CaloWaveformFitting", "template_function");
           ROOT::Math::WrappedMultiTF1 *recoverFitFunction = new ROOT::Math::WrappedMultiTF1(*recover_f, 3);
           ROOT::Fit::BinData recoverData(rv.size() - 1, 1);
           ROOT::Fit::FillData(recoverData, h);
@@ -249,27 +306,11 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
           recover_chi2min /= size1 - 3;  // divide by the number of dof
           if (recover_chi2min < _chi2lowthreshold && recover_f->GetParameter(2) < _bfr_highpedestalthreshold && recover_f->GetParameter(2) > _bfr_lowpedestalthreshold)
           {
-            for (int i = 0; i < size1; i++)
-            {
-              v.at(i) = rv.at(i);
-            }
-            for (int i = 0; i < 3; i++)
-            {
-              v.push_back(recover_f->GetParameter(i));
-            }
-            v.push_back(recover_chi2min);
-            v.push_back(1);
-            v.push_back(recover_validfit);
+            batch.set_results(channel, recover_f->GetParameter(0), recover_f->GetParameter(1), recover_f->GetParameter(2), recover_chi2min, 1, recover_validfit);
           }
           else
           {
-            for (int i = 0; i < 3; i++)
-            {
-              v.push_back(f->GetParameter(i));
-            }
-            v.push_back(chi2min);
-            v.push_back(0);
-            v.push_back(validfit);
+            batch.set_results(channel, f->GetParameter(0), f->GetParameter(1), f->GetParameter(2), chi2min, 0, validfit);
           }
           recover_f->Delete();
           delete recoverFitFunction;
@@ -278,13 +319,7 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
         }
         else
         {
-          for (int i = 0; i < 3; i++)
-          {
-            v.push_back(f->GetParameter(i));
-          }
-          v.push_back(chi2min);
-          v.push_back(0);
-          v.push_back(validfit);
+          batch.set_results(channel, f->GetParameter(0), f->GetParameter(1), f->GetParameter(2), chi2min, 0, validfit);
         }
         h->Delete();
         f->Delete();
@@ -295,23 +330,174 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
     }
   };
 
-  t->Foreach(func, chnlvector);
-  int size3 = chnlvector.size();
-  std::vector<std::vector<float>> fit_params;
-  std::vector<float> fit_params_tmp;
-  for (int i = 0; i < size3; i++)
+  std::vector<unsigned int> channels(batch.size());
+  std::iota(channels.begin(), channels.end(), 0);
+  t->Foreach(func, channels);
+}
+
+void CaloWaveformFitting::calo_processing_templatefit_fast(CaloWaveformBatch &batch)
+{
+  // channels to be fitted
+  struct FitJob
   {
-    const std::vector<float> &tv = chnlvector.at(i);
-    int size2 = tv.size();
-    for (int q = 6; q > 0; q--)
+    std::size_t channel = 0;
+    float pedestal = 0;
+    bool masked = false;
+  };
+
+  const std::size_t nchannels = batch.size();
+  std::vector<FitJob> jobs;
+  jobs.reserve(nchannels);
+
+  for (std::size_t ch = 0; ch < nchannels; ++ch)
+  {
+    const float *v = batch.get_samples(ch);
+    int size1 = batch.get_nsamples(ch);
+    if (size1 == _nzerosuppresssamples)
     {
-      fit_params_tmp.push_back(tv.at(size2 - q));
+      // returns peak sample - pedestal sample, time set to qnan for ZS. If post-sample is 0, set high chi2
+      const float chi2 = (v[0] != 0 && v[1] == 0) ? 1000000 : std::numeric_limits<float>::quiet_NaN();
+      batch.set_results(ch, v[1] - v[0], std::numeric_limits<float>::quiet_NaN(), v[0], chi2, 0, 0);
+      continue;
+    }
+
+    float maxheight = 0;
+    int maxbin = 0;
+    for (int i = 0; i < size1; i++)
+    {
+      if (v[i] > maxheight)
+      {
+        maxheight = v[i];
+        maxbin = i;
+      }
+    }
+    float pedestal = 1500;
+    if (maxbin > 4)
+    {
+      pedestal = 0.5 * (v[maxbin - 4] + v[maxbin - 5]);
+    }
+    else if (maxbin > 3)
+    {
+      pedestal = (v[maxbin - 4]);
+    }
+    else
+    {
+      pedestal = 0.5 * (v[size1 - 3] + v[size1 - 2]);
+    }
+
+    if ((_bdosoftwarezerosuppression && v[6] - v[0] < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+    {
+      const float chi2 = (v[0] != 0 && v[1] == 0) ? 1000000 : std::numeric_limits<float>::quiet_NaN();
+      batch.set_results(ch, v[6] - v[0], std::numeric_limits<float>::quiet_NaN(), v[0], chi2, 0, 0);
+      continue;
+    }
+
+    // saturated samples are excluded from the fit, unless too many are saturated
+    int ndata = size1;
+    if (_handleSaturation)
+    {
+      ndata = std::count(v, v + size1, 16383);
+      ndata = size1 - ndata;
+    }
+    jobs.push_back({ch, pedestal, ndata < size1 && ndata >= (size1 - 4)});
+
+    // scan tables must exist before fitting from multiple threads
+    const double tmin = m_setTimeLim ? m_timeLim_low : -1 * m_peakTimeTemp;
+    const double tmax = m_setTimeLim ? m_timeLim_high : size1 - m_peakTimeTemp;
+    m_template_fitter.prepare(size1, tmin, tmax);
+    if (_dobitfliprecovery)
+    {
+      m_template_fitter.prepare(size1, -1 * m_peakTimeTemp, size1 - m_peakTimeTemp);
     }
-    fit_params.push_back(fit_params_tmp);
-    fit_params_tmp.clear();
   }
-  chnlvector.clear();
-  return fit_params;
+
+  // fit channels in chunks, unmasked channels with the same number of samples are fitted as a batch
+  static constexpr std::size_t chunk_size = 64;
+  auto func = [&](unsigned int chunk)
+  {
+    const std::size_t begin = chunk * chunk_size;
+    const std::size_t end = std::min(begin + chunk_size, jobs.size());
+
+    std::vector<const float *> fit_batch;
+    std::vector<std::size_t> fit_batch_jobs;
+    std::vector<CaloTemplateFitter::Result> results(end - begin);
+    std::vector<unsigned char> use;
+    const int batch_size1 = batch.get_nsamples(jobs[begin].channel);
+    for (std::size_t j = begin; j < end; ++j)
+    {
+      const float *v = batch.get_samples(jobs[j].channel);
+      int size1 = batch.get_nsamples(jobs[j].channel);
+      const double tmin = m_setTimeLim ? m_timeLim_low : -1 * m_peakTimeTemp;
+      const double tmax = m_setTimeLim ? m_timeLim_high : size1 - m_peakTimeTemp;
+      if (jobs[j].masked)
+      {
+        use.resize(size1);
+        for (int i = 0; i < size1; ++i)
+        {
+          use[i] = (v[i] != 16383);
+        }
+        results[j - begin] = m_template_fitter.fit(v, use.data(), size1, tmin, tmax);
+      }
+      else if (size1 == batch_size1)
+      {
+        fit_batch.push_back(v);
+        fit_batch_jobs.push_back(j - begin);
+      }
+      else
+      {
+        results[j - begin] = m_template_fitter.fit(v, nullptr, size1, tmin, tmax);
+      }
+    }
+
+    if (!fit_batch.empty())
+    {
+      const double tmin = m_setTimeLim ? m_timeLim_low : -1 * m_peakTimeTemp;
+      const double tmax = m_setTimeLim ? m_timeLim_high : batch_size1 - m_peakTimeTemp;
+      std::vector<CaloTemplateFitter::Result> batch_results(fit_batch.size());
+      m_template_fitter.fit_batch(fit_batch.data(), fit_batch.size(), batch_size1, tmin, tmax, batch_results.data());
+      for (std::size_t b = 0; b < fit_batch.size(); ++b)
+      {
+        results[fit_batch_jobs[b]] = batch_results[b];
+      }
+    }
+
+    for (std::size_t j = begin; j < end; ++j)
+    {
+      const FitJob &job = jobs[j];
+      const float *v = batch.get_samples(job.channel);
+      int size1 = batch.get_nsamples(job.channel);
+      const CaloTemplateFitter::Result &result = results[j - begin];
+      const double chi2min = result.chi2 / (result.ndata - 3);  // divide by the number of dof
+      batch.set_results(job.channel, result.amplitude, result.time, result.pedestal, chi2min, 0, result.status);
+
+      if (chi2min > _chi2threshold && (result.pedestal < _bfr_highpedestalthreshold || job.pedestal < _bfr_highpedestalthreshold) && (result.pedestal > _bfr_lowpedestalthreshold || job.pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery)
+      {
+        std::vector<float> rv(v, v + size1);  // temporary recovered waveform
+        unsigned int bits[3] = {8192, 4096, 2048};
+        for (auto bit : bits)
+        {
+          for (int i = 0; i < size1; i++)
+          {
+            if (((unsigned int) rv.at(i) & bit) && ((unsigned int) rv.at(i) % bit > _bfr_lowpedestalthreshold))
+            {
+              rv.at(i) = rv.at(i) - bit;
+            }
+          }
+        }
+
+        const CaloTemplateFitter::Result recover = m_template_fitter.fit(rv.data(), nullptr, size1, -1 * m_peakTimeTemp, size1 - m_peakTimeTemp);
+        const double recover_chi2min = recover.chi2 / (size1 - 3);  // divide by the number of dof
+        if (recover_chi2min < _chi2lowthreshold && recover.pedestal < _bfr_highpedestalthreshold && recover.pedestal > _bfr_lowpedestalthreshold)
+        {
+          batch.set_results(job.channel, recover.amplitude, recover.time, recover.pedestal, recover_chi2min, 1, recover.status);
+        }
+      }
+    }
+  };
+
+  std::vector<unsigned int> chunks((jobs.size() + chunk_size - 1) / chunk_size);
+  std::iota(chunks.begin(), chunks.end(), 0);
+  t->Foreach(func, chunks);
 }
 
 void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax)
@@ -386,26 +572,25 @@ void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float
   delete sp;
   return;
 }
-std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(const std::vector<std::vector<float>> &chnlvector)
+void CaloWaveformFitting::calo_processing_fast(CaloWaveformBatch &batch)
 {
-  std::vector<std::vector<float>> fit_values;
-  int nchnls = chnlvector.size();
+  int nchnls = batch.size();
   for (int m = 0; m < nchnls; m++)
   {
-    const std::vector<float> &v = chnlvector.at(m);
-    int nsamples = v.size();
+    const float *v = batch.get_samples(m);
+    int nsamples = batch.get_nsamples(m);
 
-    double maxy = v.at(0);
+    double maxy = v[0];
     float amp = 0;
     float time = 0;
     float ped = 0;
     float chi2 = std::numeric_limits<float>::quiet_NaN();
     if (nsamples == 2)
     {
-      amp = v.at(1);
+      amp = v[1];
       time = std::numeric_limits<float>::quiet_NaN();
-      ped = v.at(0);
-      if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
+      ped = v[0];
+      if (v[0] != 0 && v[1] == 0)  // check if post-sample is 0, if so set high chi2
       {
         chi2 = 1000000;
       }
@@ -417,11 +602,11 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(const
       {
         if (i < 3)
         {
-          ped += v.at(i);
+          ped += v[i];
         }
-        if (v.at(i) > maxy)
+        if (v[i] > maxy)
         {
-          maxy = v.at(i);
+          maxy = v[i];
           maxx = i;
         }
       }
@@ -429,7 +614,7 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(const
       // if maxx <=5 nsample >=10 use the last two sample for pedestal(for HCal TP)
       if (maxx <= 5 && nsamples >= 10)
       {
-        ped = 0.5 * (v.at(nsamples - 2) + v.at(nsamples - 1));
+        ped = 0.5 * (v[nsamples - 2] + v[nsamples - 1]);
       }
       if (maxx == 0 || maxx == nsamples - 1)
       {
@@ -438,48 +623,41 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(const
       }
       else
       {
-        FastMax(maxx - 1, maxx, maxx + 1, v.at(maxx - 1), v.at(maxx), v.at(maxx + 1), time, amp);
+        FastMax(maxx - 1, maxx, maxx + 1, v[maxx - 1], v[maxx], v[maxx + 1], time, amp);
       }
     }
     amp -= ped;
-    std::vector<float> val = {amp, time, ped, chi2, 0, 0};
-    fit_values.push_back(val);
-    val.clear();
+    batch.set_results(m, amp, time, ped, chi2, 0, 0);
   }
-  return fit_values;
 }
 
-std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_nyquist(const std::vector<std::vector<float>> &chnlvector)
+void CaloWaveformFitting::calo_processing_nyquist(CaloWaveformBatch &batch)
 {
-  std::vector<std::vector<float>> fit_values;
-  int nchnls = chnlvector.size();
+  int nchnls = batch.size();
   for (int m = 0; m < nchnls; m++)
   {
-    std::vector<float> v = chnlvector.at(m);
-    int nsamples = (int) v.size();
+    const float *v = batch.get_samples(m);
+    int nsamples = batch.get_nsamples(m);
 
     if (nsamples == 2)
     {
       float chi2 = std::numeric_limits<float>::quiet_NaN();
-      if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
+      if (v[0] != 0 && v[1] == 0)  // check if post-sample is 0, if so set high chi2
       {
         chi2 = 1000000;
       }
-      fit_values.push_back({v.at(1) - v.at(0), std::numeric_limits<float>::quiet_NaN(), v.at(0), chi2, 0, 0});
+      batch.set_results(m, v[1] - v[0], std::numeric_limits<float>::quiet_NaN(), v[0], chi2, 0, 0);
       continue;
     }
 
-    std::vector<float> result = NyquistInterpolation(v);
-    fit_values.push_back(result);
+    batch.set_results(m, NyquistInterpolation(v, nsamples));
   }
-  return fit_values;
 }
 // mabye I can find a way to make it thread safe
-std::vector<float> CaloWaveformFitting::NyquistInterpolation(std::vector<float> &vec_signal_samples)
+std::vector<float> CaloWaveformFitting::NyquistInterpolation(const float *vec_signal_samples, int N)
 {
-  // int N = (int) vec_signal_samples.size();
-  auto max_elem_iter = std::max_element(vec_signal_samples.begin(), vec_signal_samples.end());
-  int maxx = std::distance(vec_signal_samples.begin(), max_elem_iter);
+  const float *max_elem_iter = std::max_element(vec_signal_samples, vec_signal_samples + N);
+  int maxx = std::distance(vec_signal_samples, max_elem_iter);
   float max = *max_elem_iter;
 
   float maxpos = maxx;
@@ -496,7 +674,7 @@ std::vector<float> CaloWaveformFitting::NyquistInterpolation(std::vector<float>
       float yval = max;
       if (i != maxpos)
       {
-        yval = psinc(i, vec_signal_samples);
+        yval = psinc(i, vec_signal_samples, N);
       }
       if (yval > max)
       {
@@ -527,14 +705,14 @@ std::vector<float> CaloWaveformFitting::NyquistInterpolation(std::vector<float>
     pedestal = max;
     for (float i = maxpos - 5; i < maxpos; i += 0.1)
     {
-      float yval = psinc(i, vec_signal_samples);
+      float yval = psinc(i, vec_signal_samples, N);
       pedestal = std::min(yval, pedestal);
     }
   }
   // calculate chi2 using the tempalte
   float chi2 = 0;
   double par[3] = {max - pedestal, maxpos - m_peakTimeTemp, pedestal};
-  for (int i = 0; i < (int) vec_signal_samples.size(); i++)
+  for (int i = 0; i < N; i++)
   {
     double xval[1] = {(double) i};
     float diff = vec_signal_samples[i] - template_function(xval, par);
@@ -571,9 +749,8 @@ double CaloWaveformFitting::Dkernel(double x, int N)
   return sum;
 }
 
-float CaloWaveformFitting::stablepsinc(float time, std::vector<float> &vec_signal_samples)
+float CaloWaveformFitting::stablepsinc(float time, const float *vec_signal_samples, int N)
 {
-  int N = (int) vec_signal_samples.size();
   float sum = 0;
   if (N % 2 == 0)
   {
@@ -592,18 +769,17 @@ float CaloWaveformFitting::stablepsinc(float time, std::vector<float> &vec_signa
   return sum;
 }
 
-float CaloWaveformFitting::psinc(float time, std::vector<float> &vec_signal_samples)
+float CaloWaveformFitting::psinc(float time, const float *vec_signal_samples, int N)
 {
-  int N = (int) vec_signal_samples.size();
 
   if (std::abs(std::round(time) - time) < 1e-6)
   {
     if (time < 0 || time >= N)
     {
-      return stablepsinc(time, vec_signal_samples);
+      return stablepsinc(time, vec_signal_samples, N);
     }
 
-    return vec_signal_samples.at(std::round(time));
+    return vec_signal_samples[(int) std::round(time)];
   }
 
   float sum = 0;
@@ -703,15 +879,14 @@ double CaloWaveformFitting::SignalShape_FermiExp(double *x, double *par) //NOLIN
 }
 
 
-std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_funcfit(const std::vector<std::vector<float>> &chnlvector)
+void CaloWaveformFitting::calo_processing_funcfit(CaloWaveformBatch &batch)
 {
-  std::vector<std::vector<float>> fit_values;
-  int nchnls = chnlvector.size();
+  int nchnls = batch.size();
 
   for (int m = 0; m < nchnls; m++)
   {
-    const std::vector<float> &v = chnlvector.at(m);
-    int nsamples = v.size();
+    const float *v = batch.get_samples(m);
+    int nsamples = batch.get_nsamples(m);
 
     float amp = 0;
     float time = 0;
@@ -721,14 +896,14 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_funcfit(con
     // Handle zero-suppressed samples (2-sample case)
     if (nsamples == _nzerosuppresssamples)
     {
-      amp = v.at(1) - v.at(0);
+      amp = v[1] - v[0];
       time = std::numeric_limits<float>::quiet_NaN();
-      ped = v.at(0);
-      if (v.at(0) != 0 && v.at(1) == 0)
+      ped = v[0];
+      if (v[0] != 0 && v[1] == 0)
       {
         chi2 = 1000000;
       }
-      fit_values.push_back({amp, time, ped, chi2, 0, 0});
+      batch.set_results(m, amp, time, ped, chi2, 0, 0);
       continue;
     }
 
@@ -737,9 +912,9 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_funcfit(con
     int maxbin = 0;
     for (int i = 0; i < nsamples; i++)
     {
-      if (v.at(i) > maxheight)
+      if (v[i] > maxheight)
       {
-        maxheight = v.at(i);
+        maxheight = v[i];
         maxbin = i;
       }
     }
@@ -747,29 +922,29 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_funcfit(con
     float pedestal = 1500;
     if (maxbin > 4)
     {
-      pedestal = 0.5 * (v.at(maxbin - 4) + v.at(maxbin - 5));
+      pedestal = 0.5 * (v[maxbin - 4] + v[maxbin - 5]);
     }
     else if (maxbin > 3)
     {
-      pedestal = v.at(maxbin - 4);
+      pedestal = v[maxbin - 4];
     }
     else
     {
-      pedestal = 0.5 * (v.at(nsamples - 3) + v.at(nsamples - 2));
+      pedestal = 0.5 * (v[nsamples - 3] + v[nsamples - 2]);
     }
 
     // Software zero suppression check
-    if ((_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) ||
+    if ((_bdosoftwarezerosuppression && v[6] - v[0] < _nsoftwarezerosuppression) ||
         (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
     {
-      amp = v.at(6) - v.at(0);
+      amp = v[6] - v[0];
       time = std::numeric_limits<float>::quiet_NaN();
-      ped = v.at(0);
-      if (v.at(0) != 0 && v.at(1) == 0)
+      ped = v[0];
+      if (v[0] != 0 && v[1] == 0)
       {
         chi2 = 1000000;
       }
-      fit_values.push_back({amp, time, ped, chi2, 0, 0});
+      batch.set_results(m, amp, time, ped, chi2, 0, 0);
       continue;
     }
 
@@ -778,11 +953,11 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_funcfit(con
     int ndata = 0;
     for (int i = 0; i < nsamples; ++i)
     {
-      if ((v.at(i) == 16383) && _handleSaturation)
+      if ((v[i] == 16383) && _handleSaturation)
       {
         continue;
       }
-      h.SetBinContent(i + 1, v.at(i));
+      h.SetBinContent(i + 1, v[i]);
       h.SetBinError(i + 1, 1);
       ndata++;
     }
@@ -793,7 +968,7 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_funcfit(con
       ndata = nsamples;
       for (int i = 0; i < nsamples; ++i)
       {
-        h.SetBinContent(i + 1, v.at(i));
+        h.SetBinContent(i + 1, v[i]);
         h.SetBinError(i + 1, 1);
       }
     }
@@ -950,9 +1125,6 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_funcfit(con
       chi2val = std::numeric_limits<double>::quiet_NaN();
     }
 
-    fit_values.push_back({static_cast<float>(fit_amp), static_cast<float>(fit_time),
-                          static_cast<float>(fit_ped), static_cast<float>(chi2val), 0, static_cast<float>(validfit)});
+    batch.set_results(m, fit_amp, fit_time, fit_ped, chi2val, 0, validfit);
   }
-
-  return fit_values;
 }
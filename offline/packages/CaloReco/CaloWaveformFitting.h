@@ -1,6 +1,9 @@
 #ifndef CALORECO_CALOWAVEFORMFITTING_H
 #define CALORECO_CALOWAVEFORMFITTING_H
 
+#include "CaloTemplateFitter.h"
+#include "CaloWaveformBatch.h"
+
 #include <string>
 #include <vector>
 
@@ -64,12 +67,28 @@ class CaloWaveformFitting
     _handleSaturation = handleSaturation;
   }
 
+  // processing of all waveforms of a batch, results are stored in the batch result columns
+  void calo_processing_templatefit(CaloWaveformBatch &batch);
+  // same outputs as calo_processing_templatefit, using CaloTemplateFitter instead of Minuit
+  void calo_processing_templatefit_fast(CaloWaveformBatch &batch);
+  static void calo_processing_fast(CaloWaveformBatch &batch);
+  void calo_processing_nyquist(CaloWaveformBatch &batch);
+  void calo_processing_funcfit(CaloWaveformBatch &batch);
+
+  // vector interfaces, one row of results per waveform. These copy the waveforms to a batch
   std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
+  // input waveforms have the channel index appended
   std::vector<std::vector<float>> calo_processing_templatefit(std::vector<std::vector<float>> chnlvector);
+  std::vector<std::vector<float>> calo_processing_templatefit_fast(const std::vector<std::vector<float>> &chnlvector);
   static std::vector<std::vector<float>> calo_processing_fast(const std::vector<std::vector<float>> &chnlvector);
   std::vector<std::vector<float>> calo_processing_nyquist(const std::vector<std::vector<float>> &chnlvector);
   std::vector<std::vector<float>> calo_processing_funcfit(const std::vector<std::vector<float>> &chnlvector);
 
+  // copy waveforms to a batch, dropping the appended channel index if has_index is set
+  static void fill_batch(CaloWaveformBatch &batch, const std::vector<std::vector<float>> &chnlvector, bool has_index);
+  // results of a batch, one row per waveform
+  static std::vector<std::vector<float>> batch_results(const CaloWaveformBatch &batch);
+
   void initialize_processing(const std::string &templatefile);
 
   // Power-law fit function: amplitude * (x-t0)^power * exp(-(x-t0)*decay) + pedestal
@@ -99,16 +118,17 @@ class CaloWaveformFitting
 
  private:
   static void FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax);
-  std::vector<float> NyquistInterpolation(std::vector<float> &vec_signal_samples);
+  std::vector<float> NyquistInterpolation(const float *vec_signal_samples, int N);
   static double Dkernelodd(double x, int N);
   static double Dkernel(double x, int N);
 
-  static float stablepsinc(float t, std::vector<float> &vec_signal_samples);
+  static float stablepsinc(float t, const float *vec_signal_samples, int N);
 
-  static float psinc(float t, std::vector<float> &vec_signal_samples);
+  static float psinc(float t, const float *vec_signal_samples, int N);
   double template_function(double *x, double *par);
 
   TProfile *h_template{nullptr};
+  CaloTemplateFitter m_template_fitter;
   double m_peakTimeTemp{0};
   int _nthreads{1};
   int _nzerosuppresssamples{2};
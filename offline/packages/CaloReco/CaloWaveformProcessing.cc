@@ -1,4 +1,5 @@
 #include "CaloWaveformProcessing.h"
+#include "CaloWaveformBatch.h"
 #include "CaloWaveformFitting.h"
 
 #include <ffamodules/CDBInterface.h>
@@ -27,13 +28,14 @@ void CaloWaveformProcessing::initialize_processing()
 {
   char *calibrationsroot = getenv("CALIBRATIONROOT");
   assert(calibrationsroot);
-  if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT)
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT ||
+      m_processingtype == CaloWaveformProcessing::TEMPLATE_FAST || m_processingtype == CaloWaveformProcessing::TEMPLATE_FAST_NOSAT)
   {
     std::string calibrations_repo_template = std::string(calibrationsroot) + "/WaveformProcessing/templates/" + m_template_input_file;
     url_template = CDBInterface::instance()->getUrl(m_template_name, calibrations_repo_template);
     m_Fitter = new CaloWaveformFitting();
     m_Fitter->initialize_processing(url_template);
-    if (m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT)
+    if (m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT || m_processingtype == CaloWaveformProcessing::TEMPLATE_FAST_NOSAT)
     {
       m_Fitter->set_handleSaturation(false);
     }
@@ -82,51 +84,64 @@ void CaloWaveformProcessing::initialize_processing()
 
 std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::vector<std::vector<float>> waveformvector)
 {
-  unsigned int size1 = waveformvector.size();
-  std::vector<std::vector<float>> fitresults;
+  CaloWaveformBatch batch;
+  CaloWaveformFitting::fill_batch(batch, waveformvector, false);
+  process_waveform(batch);
+  return CaloWaveformFitting::batch_results(batch);
+}
+
+void CaloWaveformProcessing::process_waveform(CaloWaveformBatch &batch)
+{
   if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT)
   {
-    for (unsigned int i = 0; i < size1; i++)
-    {
-      waveformvector.at(i).push_back((float) i);
-    }
-    fitresults = m_Fitter->calo_processing_templatefit(waveformvector);
+    m_Fitter->calo_processing_templatefit(batch);
+  }
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE_FAST || m_processingtype == CaloWaveformProcessing::TEMPLATE_FAST_NOSAT)
+  {
+    m_Fitter->calo_processing_templatefit_fast(batch);
   }
   if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
-    fitresults = CaloWaveformProcessing::calo_processing_ONNX(waveformvector);
+    calo_processing_ONNX(batch);
   }
   if (m_processingtype == CaloWaveformProcessing::FAST)
   {
-    fitresults = CaloWaveformFitting::calo_processing_fast(waveformvector);
+    CaloWaveformFitting::calo_processing_fast(batch);
   }
   if (m_processingtype == CaloWaveformProcessing::NYQUIST)
   {
-    fitresults = m_Fitter->calo_processing_nyquist(waveformvector);
+    m_Fitter->calo_processing_nyquist(batch);
   }
   if (m_processingtype == CaloWaveformProcessing::FUNCFIT)
   {
-    fitresults = m_Fitter->calo_processing_funcfit(waveformvector);
+    m_Fitter->calo_processing_funcfit(batch);
   }
-  return fitresults;
 }
 
 std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector)
 {
-  std::vector<std::vector<float>> fit_values;
+  CaloWaveformBatch batch;
+  CaloWaveformFitting::fill_batch(batch, chnlvector, false);
+  calo_processing_ONNX(batch);
+  return CaloWaveformFitting::batch_results(batch);
+}
+
+void CaloWaveformProcessing::calo_processing_ONNX(CaloWaveformBatch &batch)
+{
   std::vector<float> val;  // single row to return
-  unsigned int nchnls = chnlvector.size();
+  std::vector<float> vtmp;
+  unsigned int nchnls = batch.size();
   for (unsigned int m = 0; m < nchnls; m++)
   {
     val.clear();
-    const std::vector<float> &v = chnlvector.at(m);
-    int size1 = v.size();
+    const float *v = batch.get_samples(m);
+    int size1 = batch.get_nsamples(m);
     if (size1 == _nzerosuppresssamples)
     {
-      val.push_back(v.at(1) - v.at(0));
+      val.push_back(v[1] - v[0]);
       val.push_back(std::numeric_limits<float>::quiet_NaN());
-      val.push_back(v.at(0));
-      if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
+      val.push_back(v[0]);
+      if (v[0] != 0 && v[1] == 0)  // check if post-sample is 0, if so set high chi2
       {
         val.push_back(1000000);
       }
@@ -136,7 +151,7 @@ std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(con
       }
       val.push_back(0);
       val.push_back(0);
-      fit_values.push_back(val);
+      batch.set_results(m, val);
     }
     else
     {
@@ -144,32 +159,32 @@ std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(con
       int maxbin = 0;
       for (int i = 0; i < size1; i++)
       {
-        if (v.at(i) > maxheight)
+        if (v[i] > maxheight)
         {
-          maxheight = v.at(i);
+          maxheight = v[i];
           maxbin = i;
         }
       }
       float pedestal = 1500;
       if (maxbin > 4)
       {
-        pedestal = 0.5 * (v.at(maxbin - 4) + v.at(maxbin - 5));
+        pedestal = 0.5 * (v[maxbin - 4] + v[maxbin - 5]);
       }
       else if (maxbin > 3)
       {
-        pedestal = (v.at(maxbin - 4));
+        pedestal = (v[maxbin - 4]);
       }
       else
       {
-        pedestal = 0.5 * (v.at(size1 - 3) + v.at(size1 - 2));
+        pedestal = 0.5 * (v[size1 - 3] + v[size1 - 2]);
       }
 
-      if ((_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+      if ((_bdosoftwarezerosuppression && v[6] - v[0] < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
       {
-        val.push_back(v.at(6) - v.at(0));
+        val.push_back(v[6] - v[0]);
         val.push_back(std::numeric_limits<float>::quiet_NaN());
-        val.push_back(v.at(0));
-        if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
+        val.push_back(v[0]);
+        if (v[0] != 0 && v[1] == 0)  // check if post-sample is 0, if so set high chi2
         {
           val.push_back(1000000);
         }
@@ -179,16 +194,15 @@ std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(con
         }
         val.push_back(0);
         val.push_back(0);
-        fit_values.push_back(val);
+        batch.set_results(m, val);
       }
       else
       {
-        unsigned int nsamples = v.size();
-        if (nsamples == 12)
+        if (size1 == 12)
         {
           // downstream onnx does not have a static input vector API,
           // so we need to make a copy
-          std::vector<float> vtmp(v);  // NOLINT(performance-unnecessary-copy-initialization)
+          vtmp.assign(v, v + size1);
           val = onnxInference(onnxmodule, vtmp, 1, onnxlib::n_input, onnxlib::n_output);
           unsigned int nvals = val.size();
           for (unsigned int i = 0; i < nvals; i++)
@@ -198,18 +212,16 @@ std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(con
           val.push_back(2000);
           val.push_back(0);
           val.push_back(0);
-          fit_values.push_back(val);
+          batch.set_results(m, val);
         }
         else
         {
           float v_diff = v[1] - v[0];
-          std::vector<float> val1{v_diff, std::numeric_limits<float>::quiet_NaN(), v[1], std::numeric_limits<float>::quiet_NaN(), 0, 0};
-          fit_values.push_back(val1);
+          batch.set_results(m, v_diff, std::numeric_limits<float>::quiet_NaN(), v[1], std::numeric_limits<float>::quiet_NaN(), 0, 0);
         }
       }
     }
   }
-  return fit_values;
 }
 
 int CaloWaveformProcessing::get_nthreads()
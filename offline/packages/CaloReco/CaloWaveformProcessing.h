@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 
+class CaloWaveformBatch;
 class CaloWaveformFitting;
 
 class CaloWaveformProcessing : public SubsysReco
@@ -21,6 +22,8 @@ class CaloWaveformProcessing : public SubsysReco
     NYQUIST = 4,
     TEMPLATE_NOSAT = 5,
     FUNCFIT = 6,
+    TEMPLATE_FAST = 7,
+    TEMPLATE_FAST_NOSAT = 8,
   };
 
   CaloWaveformProcessing() = default;
@@ -96,6 +99,11 @@ class CaloWaveformProcessing : public SubsysReco
     _doubleexp_ratio = ratio;
   }
 
+  // process all waveforms of a batch in place, results are stored in the batch result columns
+  void process_waveform(CaloWaveformBatch &batch);
+  void calo_processing_ONNX(CaloWaveformBatch &batch);
+
+  // vector interfaces, one row of results per waveform. These copy the waveforms to a batch
   std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
   std::vector<std::vector<float>> calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector);
 
@@ -1,6 +1,8 @@
 #ifndef PHFIELD_PHFIELD_H
 #define PHFIELD_PHFIELD_H
 
+#include <cstddef>
+
 // units of this class. To convert internal value to Geant4/CLHEP units for fast access
 
 //! \brief transient object for field storage and access
@@ -30,6 +32,20 @@ class PHField
       double *Bfield) const
   { return GetFieldValue( Point, Bfield ); }
 
+  //! access field values for many points at once
+  //! @param[in]  npoints  number of points
+  //! @param[in]  Points   space time coordinates, 4 consecutive values per point as in GetFieldValue
+  //! @param[out] Bfield   field values, 3 consecutive values per point
+  /* By default, calls GetFieldValue for each point */
+  virtual void GetFieldValues(
+      std::size_t npoints,
+      const double *Points,
+      double *Bfield) const
+  {
+    for (std::size_t i = 0; i < npoints; ++i)
+    { GetFieldValue( Points + 4 * i, Bfield + 3 * i ); }
+  }
+
   //! verbosity
   void Verbosity(const int i) { m_Verbosity = i; }
 
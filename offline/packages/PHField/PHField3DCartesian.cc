@@ -1,4 +1,5 @@
 #include "PHField3DCartesian.h"
+#include "PHFieldBinaryCache.h"
 
 #include <phool/phool.h>
 
@@ -11,6 +12,8 @@
 
 #include <boost/stacktrace.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -19,29 +22,73 @@
 #include <set>
 #include <utility>
 
+namespace
+{
+  //! number of field components per grid point
+  constexpr unsigned int ncomponents = 3;
+
+  //! one entry of the field map ntuple
+  struct entry_t
+  {
+    float x = 0;
+    float y = 0;
+    float z = 0;
+    float bx = 0;
+    float by = 0;
+    float bz = 0;
+  };
+
+  //! index of a value in a sorted axis
+  std::size_t axis_index(const std::vector<double> &axis, double value)
+  {
+    return std::distance(axis.begin(), std::lower_bound(axis.begin(), axis.end(), value));
+  }
+}  // namespace
+
 PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
   : filename(fname)
 {
   std::cout << "PHField3DCartesian::PHField3DCartesian" << std::endl;
 
-  for (int i = 0; i < 2; i++) // NOLINT (modernize-loop-convert)
-  {
-    for (int j = 0; j < 2; j++)
-    {
-      for (int k = 0; k < 2; k++)
-      {
-        for (int l = 0; l < 3; l++)
-        {
-          bf[i][j][k][l] = {std::numeric_limits<double>::quiet_NaN()};
-        }
-      }
-    }
-  }
   std::cout << "\n================ Begin Construct Mag Field =====================" << std::endl;
   std::cout << "\n-----------------------------------------------------------"
             << "\n      Magnetic field Module - Verbosity:"
             << "\n-----------------------------------------------------------";
 
+  // try binary cache first
+  m_cache = std::make_unique<PHFieldBinaryCache>(filename, "PHField3DCartesian", std::vector<double>{magfield_rescale, innerradius, outerradius, size_z});
+  std::array<std::vector<double>, 3> axes;
+  if (m_cache->load() &&
+      m_cache->get_ncomponents() == ncomponents &&
+      m_cache->get_field_size() == m_cache->get_axes()[0].size() * m_cache->get_axes()[1].size() * m_cache->get_axes()[2].size() * ncomponents)
+  {
+    std::cout << "\n ---> "
+                 "Reading the field grid from cache "
+              << m_cache->get_filename() << " ... " << std::endl;
+    axes = m_cache->get_axes();
+    m_field = m_cache->get_field();
+  }
+  else
+  {
+    read_map(axes, magfield_rescale, innerradius, outerradius, size_z);
+    if (m_cache->enabled() && m_cache->save(axes, m_field_storage, ncomponents))
+    {
+      std::cout << " ---> Field grid cached to " << m_cache->get_filename() << std::endl;
+    }
+    m_cache.reset();
+    m_field = m_field_storage.data();
+  }
+
+  set_grid(axes);
+
+  std::cout << "\n================= End Construct Mag Field ======================\n"
+            << std::endl;
+}
+
+PHField3DCartesian::~PHField3DCartesian() = default;
+
+void PHField3DCartesian::read_map(std::array<std::vector<double>, 3> &axes, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
+{
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -76,26 +123,71 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
   field_map->SetBranchAddress("bx", &ROOT_BX);
   field_map->SetBranchAddress("by", &ROOT_BY);
   field_map->SetBranchAddress("bz", &ROOT_BZ);
+
+  // grid coordinates include all points, field values only those passing the radius cuts
+  std::set<float> xvals;
+  std::set<float> yvals;
+  std::set<float> zvals;
+  std::vector<entry_t> entries;
+  entries.reserve(field_map->GetEntries());
   for (int i = 0; i < field_map->GetEntries(); i++)
   {
     field_map->GetEntry(i);
-    trio coord_key(ROOT_X * cm, ROOT_Y * cm, ROOT_Z * cm);
-    trio field_val(ROOT_BX * tesla * magfield_rescale, ROOT_BY * tesla * magfield_rescale, ROOT_BZ * tesla * magfield_rescale);
-    xvals.insert(ROOT_X * cm);
-    yvals.insert(ROOT_Y * cm);
-    zvals.insert(ROOT_Z * cm);
+    const entry_t entry = {
+        static_cast<float>(ROOT_X * cm), static_cast<float>(ROOT_Y * cm), static_cast<float>(ROOT_Z * cm),
+        static_cast<float>(ROOT_BX * tesla * magfield_rescale), static_cast<float>(ROOT_BY * tesla * magfield_rescale), static_cast<float>(ROOT_BZ * tesla * magfield_rescale)};
+    xvals.insert(entry.x);
+    yvals.insert(entry.y);
+    zvals.insert(entry.z);
     if ((std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) >= innerradius &&
          std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
         std::abs(ROOT_Z * cm) > size_z)
     {
-      fieldmap[coord_key] = field_val;
+      entries.push_back(entry);
+    }
+  }
+  delete field_map;
+  delete rootinput;
+
+  axes[0].assign(xvals.begin(), xvals.end());
+  axes[1].assign(yvals.begin(), yvals.end());
+  axes[2].assign(zvals.begin(), zvals.end());
+
+  // dense grid, x major, z minor. Missing points are left as NaN
+  const std::size_t nx = axes[0].size();
+  const std::size_t ny = axes[1].size();
+  const std::size_t nz = axes[2].size();
+  m_field_storage.assign(nx * ny * nz * ncomponents, std::numeric_limits<float>::quiet_NaN());
+  for (const auto &entry : entries)
+  {
+    const std::size_t ix = axis_index(axes[0], entry.x);
+    const std::size_t iy = axis_index(axes[1], entry.y);
+    const std::size_t iz = axis_index(axes[2], entry.z);
+    float *b = &m_field_storage[((ix * ny + iy) * nz + iz) * ncomponents];
+    b[0] = entry.bx;
+    b[1] = entry.by;
+    b[2] = entry.bz;
+  }
+}
+
+void PHField3DCartesian::set_grid(const std::array<std::vector<double>, 3> &axes)
+{
+  for (std::size_t i = 0; i < axes.size(); ++i)
+  {
+    if (axes[i].size() < 2)
+    {
+      std::cout << PHWHERE << " field map " << filename << " needs at least two grid points along each axis, exiting now" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
     }
+    m_npoints[i] = axes[i].size();
   }
-  xmin = *(xvals.begin());
-  xmax = *(xvals.rbegin());
 
-  ymin = *(yvals.begin());
-  ymax = *(yvals.rbegin());
+  xmin = axes[0].front();
+  xmax = axes[0].back();
+
+  ymin = axes[1].front();
+  ymax = axes[1].back();
   if (ymin != xmin || ymax != xmax)
   {
     std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
@@ -103,47 +195,111 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
     exit(1);
   }
 
-  zmin = *(zvals.begin());
-  zmax = *(zvals.rbegin());
+  zmin = axes[2].front();
+  zmax = axes[2].back();
 
-  xstepsize = (xmax - xmin) / (xvals.size() - 1);
-  ystepsize = (ymax - ymin) / (yvals.size() - 1);
-  zstepsize = (zmax - zmin) / (zvals.size() - 1);
+  xstepsize = (xmax - xmin) / (m_npoints[0] - 1);
+  ystepsize = (ymax - ymin) / (m_npoints[1] - 1);
+  zstepsize = (zmax - zmin) / (m_npoints[2] - 1);
+  m_inverse_step = {1. / xstepsize, 1. / ystepsize, 1. / zstepsize};
 
-  delete field_map;
-  delete rootinput;
-  std::cout << "\n================= End Construct Mag Field ======================\n"
-            << std::endl;
+  // interpolation uses direct index arithmetic, which requires a regular grid.
+  // Any other grid would silently return wrong fields
+  const std::array<double, 3> steps = {xstepsize, ystepsize, zstepsize};
+  for (std::size_t i = 0; i < axes.size(); ++i)
+  {
+    for (std::size_t j = 0; j < axes[i].size(); ++j)
+    {
+      if (std::abs(axes[i][j] - (axes[i].front() + j * steps[i])) > 1e-3 * steps[i])
+      {
+        std::cout << PHWHERE << " field map " << filename << " is not on a regular grid along axis " << i
+                  << ": " << axes[i][j] / cm << " expected " << (axes[i].front() + j * steps[i]) / cm
+                  << ", exiting now" << std::endl;
+        gSystem->Exit(1);
+        exit(1);
+      }
+    }
+  }
 }
 
-PHField3DCartesian::~PHField3DCartesian()
+bool PHField3DCartesian::interpolate(const double point[4], double *Bfield) const
 {
-  if (Verbosity() > 0)
+  const double &x = point[0];
+  const double &y = point[1];
+  const double &z = point[2];
+
+  Bfield[0] = 0.0;
+  Bfield[1] = 0.0;
+  Bfield[2] = 0.0;
+
+  // also rejects non finite coordinates
+  if (!(x >= xmin && x <= xmax &&
+        y >= ymin && y <= ymax &&
+        z >= zmin && z <= zmax))
   {
-    std::cout << "PHField3DCartesian: cache hits: " << cache_hits
-              << " cache misses: " << cache_misses
-              << std::endl;
+    return true;
+  }
+
+  // lower grid point and normalized distance to it.
+  // A point on a grid node belongs to the cell below, as in the original std::set::lower_bound lookup
+  const double fx = (x - xmin) * m_inverse_step[0];
+  const double fy = (y - ymin) * m_inverse_step[1];
+  const double fz = (z - zmin) * m_inverse_step[2];
+  const std::size_t ix = std::clamp<long>(std::ceil(fx) - 1, 0, m_npoints[0] - 2);
+  const std::size_t iy = std::clamp<long>(std::ceil(fy) - 1, 0, m_npoints[1] - 2);
+  const std::size_t iz = std::clamp<long>(std::ceil(fz) - 1, 0, m_npoints[2] - 2);
+  const double fractionx = fx - ix;
+  const double fractiony = fy - iy;
+  const double fractionz = fz - iz;
+
+  // strides
+  const std::size_t dz = ncomponents;
+  const std::size_t dy = m_npoints[2] * dz;
+  const std::size_t dx = m_npoints[1] * dy;
+  const float *b = m_field + ix * dx + iy * dy + iz * dz;
+
+  // trilinear interpolation, along z, then y, then x
+  for (unsigned int i = 0; i < ncomponents; i++)
+  {
+    const double b00 = b[i] * (1. - fractionz) + b[dz + i] * fractionz;
+    const double b01 = b[dy + i] * (1. - fractionz) + b[dy + dz + i] * fractionz;
+    const double b10 = b[dx + i] * (1. - fractionz) + b[dx + dz + i] * fractionz;
+    const double b11 = b[dx + dy + i] * (1. - fractionz) + b[dx + dy + dz + i] * fractionz;
+    const double b0 = b00 * (1. - fractiony) + b01 * fractiony;
+    const double b1 = b10 * (1. - fractiony) + b11 * fractiony;
+    Bfield[i] = b0 * (1. - fractionx) + b1 * fractionx;
+  }
+
+  // missing grid points are stored as NaN
+  if (std::isnan(Bfield[0] + Bfield[1] + Bfield[2]))
+  {
+    Bfield[0] = 0.0;
+    Bfield[1] = 0.0;
+    Bfield[2] = 0.0;
+    return false;
   }
+
+  return true;
 }
 
 void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) const
 {
+  // previous point, for diagnostics
+  thread_local double xsav = -1000000.;
+  thread_local double ysav = -1000000.;
+  thread_local double zsav = -1000000.;
 
-  static double xsav = -1000000.;
-  static double ysav = -1000000.;
-  static double zsav = -1000000.;
-
-  const double& x = point[0];
-  const double& y = point[1];
-  const double& z = point[2];
+  const double &x = point[0];
+  const double &y = point[1];
+  const double &z = point[2];
 
-  Bfield[0] = 0.0;
-  Bfield[1] = 0.0;
-  Bfield[2] = 0.0;
   if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
   {
-    static int ifirst = 0;
-    if (ifirst < 10)
+    Bfield[0] = 0.0;
+    Bfield[1] = 0.0;
+    Bfield[2] = 0.0;
+    static std::atomic<int> ifirst = 0;
+    if (ifirst++ < 10)
     {
       std::cout << "PHField3DCartesian::GetFieldValue: "
         << "Invalid coordinates: "
@@ -160,7 +316,6 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
       std::cout << "Here is the stacktrace: " << std::endl;
       std::cout << boost::stacktrace::stacktrace();
       std::cout << "This is not a segfault. Check the stacktrace for the guilty party (typically #2)" << std::endl;
-      ifirst++;
     }
     return;
   }
@@ -169,313 +324,33 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   ysav = y;
   zsav = z;
 
-  if (point[0] < xmin || point[0] > xmax ||
-      point[1] < ymin || point[1] > ymax ||
-      point[2] < zmin || point[2] > zmax)
-  {
-    return;
-  }
+  GetFieldValue_nocache(point, Bfield);
 
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    xkey[1] = *it;
-  }
-
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    zkey[1] = *it;
-  }
-
-  if (xkey_save != xkey[0] ||
-      ykey_save != ykey[0] ||
-      zkey_save != zkey[0])
-  {
-    cache_misses++;
-    xkey_save = xkey[0];
-    ykey_save = ykey[0];
-    zkey_save = zkey[0];
-
-    std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-    trio key;
-    for (int i = 0; i < 2; i++)
-    {
-      for (int j = 0; j < 2; j++)
-      {
-        for (int k = 0; k < 2; k++)
-        {
-          key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-          magval = fieldmap.find(key);
-          if (magval == fieldmap.end())
-          {
-            std::cout << PHWHERE << " could not locate key in " << filename
-                      << " value: x: " << xkey[i] / cm
-                      << ", y: " << ykey[j] / cm
-                      << ", z: " << zkey[k] / cm << std::endl;
-            return;
-          }
-          bf[i][j][k][0] = std::get<0>(magval->second);
-          bf[i][j][k][1] = std::get<1>(magval->second);
-          bf[i][j][k][2] = std::get<2>(magval->second);
-          if (Verbosity() > 0)
-          {
-            const double x_loc = std::get<0>(magval->first);
-            const double y_loc = std::get<1>(magval->first);
-            const double z_loc = std::get<2>(magval->first);
-
-            std::cout << "read x/y/z: " << x_loc / cm << "/"
-              << y_loc / cm << "/"
-              << z_loc / cm << " bx/by/bz: "
-              << bf[i][j][k][0] / tesla << "/"
-              << bf[i][j][k][1] / tesla << "/"
-              << bf[i][j][k][2] / tesla << std::endl;
-          }
-        }
-      }
-    }
-  }
-  else
-  {
-    cache_hits++;
-  }
-
-  // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
-  // normalize distance to step size
-  double fractionx = xinblock / xstepsize;
-  double fractiony = yinblock / ystepsize;
-  double fractionz = zinblock / zstepsize;
   if (Verbosity() > 0)
   {
-    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
-    std::cout << "x/y/z inblock: " << xinblock / cm << "/" << yinblock / cm << "/" << zinblock / cm << std::endl;
-    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
-  }
-
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
-
-  for (int i = 0; i < 3; i++)
-  {
-    Bfield[i] = bf[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
+    std::cout << "PHField3DCartesian::GetFieldValue - x/y/z: " << x / cm << "/" << y / cm << "/" << z / cm
+              << " bx/by/bz: " << Bfield[0] / tesla << "/" << Bfield[1] / tesla << "/" << Bfield[2] / tesla
+              << std::endl;
   }
-
-  return;
 }
 
 //_____________________________________________________________
 void PHField3DCartesian::GetFieldValue_nocache(const double point[4], double *Bfield) const
 {
-
-  const double& x = point[0];
-  const double& y = point[1];
-  const double& z = point[2];
-
-  Bfield[0] = 0.0;
-  Bfield[1] = 0.0;
-  Bfield[2] = 0.0;
-  if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
-  { return; }
-
-  if (point[0] < xmin || point[0] > xmax ||
-      point[1] < ymin || point[1] > ymax ||
-      point[2] < zmin || point[2] > zmax)
-  { return; }
-
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    xkey[1] = *it;
-  }
-
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
+  if (!interpolate(point, Bfield))
   {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
+    std::cout << PHWHERE << " could not locate grid points in " << filename
+              << " around x: " << point[0] / cm
+              << ", y: " << point[1] / cm
+              << ", z: " << point[2] / cm << std::endl;
   }
-  else
-  {
-    --it;
-    zkey[1] = *it;
-  }
-
-  // local xyz and field
-  double bf_loc[2][2][2][3]{};
-
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-  trio key;
-  for (int i = 0; i < 2; i++)
-  {
-    for (int j = 0; j < 2; j++)
-    {
-      for (int k = 0; k < 2; k++)
-      {
-        key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-        magval = fieldmap.find(key);
-        if (magval == fieldmap.end())
-        {
-          std::cout << PHWHERE << " could not locate key in " << filename
-            << " value: x: " << xkey[i] / cm
-            << ", y: " << ykey[j] / cm
-            << ", z: " << zkey[k] / cm << std::endl;
-          return;
-        }
-
-        bf_loc[i][j][k][0] = std::get<0>(magval->second);
-        bf_loc[i][j][k][1] = std::get<1>(magval->second);
-        bf_loc[i][j][k][2] = std::get<2>(magval->second);
-        if (Verbosity() > 0)
-        {
-
-          const double x_loc = std::get<0>(magval->first);
-          const double y_loc = std::get<1>(magval->first);
-          const double z_loc = std::get<2>(magval->first);
-
-          std::cout << "read x/y/z: " << x_loc / cm << "/"
-            << y_loc / cm << "/"
-            << z_loc / cm << " bx/by/bz: "
-            << bf_loc[i][j][k][0] / tesla << "/"
-            << bf_loc[i][j][k][1] / tesla << "/"
-            << bf_loc[i][j][k][2] / tesla << std::endl;
-        }
-      }
-    }
-  }
-
-  // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
-  // normalize distance to step size
-  double fractionx = xinblock / xstepsize;
-  double fractiony = yinblock / ystepsize;
-  double fractionz = zinblock / zstepsize;
-  if (Verbosity() > 0)
-  {
-    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
-    std::cout << "x/y/z inblock: " << xinblock / cm << "/" << yinblock / cm << "/" << zinblock / cm << std::endl;
-    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
-  }
-
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
+}
 
-  for (int i = 0; i < 3; i++)
+//_____________________________________________________________
+void PHField3DCartesian::GetFieldValues(std::size_t npoints, const double *points, double *Bfield) const
+{
+  for (std::size_t i = 0; i < npoints; ++i)
   {
-    Bfield[i] = bf_loc[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf_loc[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf_loc[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf_loc[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf_loc[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf_loc[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf_loc[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf_loc[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
+    GetFieldValue_nocache(points + 4 * i, Bfield + 3 * i);
   }
-
-  return;
 }
@@ -3,12 +3,25 @@
 
 #include "PHField.h"
 
+#include <array>
+#include <cstddef>
 #include <limits>
-#include <map>
-#include <set>
+#include <memory>
 #include <string>
-#include <tuple>
+#include <vector>
 
+class PHFieldBinaryCache;
+
+//! 3D field map on a regular cartesian grid
+/*!
+ * The map is stored as one contiguous array of (Bx, By, Bz) triplets, x major, z minor,
+ * and trilinearly interpolated between the eight surrounding grid points.
+ * Grid points missing from the map file (e.g. removed by the radius cuts) are stored as NaN,
+ * and lookups requiring them return a zero field.
+ * Lookups do not modify any internal state and are thread-safe.
+ * The grid can be loaded from a memory mapped binary cache, see PHFieldBinaryCache.
+ * Maps which are not on a regular grid are rejected (exit)
+ */
 class PHField3DCartesian : public PHField
 {
  public:
@@ -27,7 +40,19 @@ class PHField3DCartesian : public PHField
 
   void GetFieldValue_nocache(const double Point[4], double *Bfield) const override;
 
+  void GetFieldValues(std::size_t npoints, const double *Points, double *Bfield) const override;
+
   private:
+
+  //! fill grid axes and field values from ROOT ntuple
+  void read_map(std::array<std::vector<double>, 3> &axes, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z);
+
+  //! setup grid boundaries and step sizes from axes
+  void set_grid(const std::array<std::vector<double>, 3> &axes);
+
+  //! interpolate field at a given point. Returns false if a grid point is missing
+  bool interpolate(const double point[4], double *Bfield) const;
+
   std::string filename;
   double xmin {1000000};
   double xmax {-1000000};
@@ -39,20 +64,16 @@ class PHField3DCartesian : public PHField
   double ystepsize {std::numeric_limits<double>::quiet_NaN()};
   double zstepsize {std::numeric_limits<double>::quiet_NaN()};
 
-  // these are updated in a const method
-  // to cache previous values
-  mutable double bf[2][2][2][3]{};
-  mutable double xkey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable double ykey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable double zkey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable int cache_hits {0};
-  mutable int cache_misses {0};
-
-  typedef std::tuple<float, float, float> trio;
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> > fieldmap;
-  std::set<float> xvals;
-  std::set<float> yvals;
-  std::set<float> zvals;
+  //! number of grid points along x, y and z
+  std::array<std::size_t, 3> m_npoints {};
+
+  //! inverse step sizes, for index calculation
+  std::array<double, 3> m_inverse_step {};
+
+  //! field values, in Geant4 units. Either owned (m_field_storage) or memory mapped (m_cache)
+  std::vector<float> m_field_storage;
+  std::unique_ptr<PHFieldBinaryCache> m_cache;
+  const float *m_field {nullptr};
 };
 
 #endif
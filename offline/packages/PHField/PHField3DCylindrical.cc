@@ -1,4 +1,5 @@
 #include "PHField3DCylindrical.h"
+#include "PHFieldBinaryCache.h"
 
 #include <TDirectory.h>  // for TDirectory, gDirectory
 #include <TFile.h>
@@ -15,6 +16,29 @@
 #include <set>
 #include <utility>
 
+namespace
+{
+  //! number of field components per grid point
+  constexpr unsigned int ncomponents = 3;
+
+  //! one entry of the field map ntuple, in Geant4 units
+  struct entry_t
+  {
+    float r = 0;
+    float phi = 0;
+    float z = 0;
+    float br = 0;
+    float bphi = 0;
+    float bz = 0;
+  };
+
+  //! index of a value in a sorted axis
+  int axis_index(const std::vector<float> &axis, float value)
+  {
+    return std::distance(axis.begin(), std::lower_bound(axis.begin(), axis.end(), value));
+  }
+}  // namespace
+
 PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const int verb, const float magfield_rescale)
   : PHField(verb)
 {
@@ -23,6 +47,54 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
             << "\n      Magnetic field Module - Verbosity:" << Verbosity()
             << "\n-----------------------------------------------------------";
 
+  // try binary cache first
+  m_cache = std::make_unique<PHFieldBinaryCache>(filename, "PHField3DCylindrical", std::vector<double>{magfield_rescale});
+  if (m_cache->load() &&
+      m_cache->get_ncomponents() == ncomponents &&
+      m_cache->get_field_size() == m_cache->get_axes()[0].size() * m_cache->get_axes()[1].size() * m_cache->get_axes()[2].size() * ncomponents)
+  {
+    std::cout << "\n ---> "
+                 "Reading the field grid from cache "
+              << m_cache->get_filename() << " ... " << std::endl;
+    const auto &axes = m_cache->get_axes();
+    r_map_.assign(axes[0].begin(), axes[0].end());
+    phi_map_.assign(axes[1].begin(), axes[1].end());
+    z_map_.assign(axes[2].begin(), axes[2].end());
+    m_field = m_cache->get_field();
+  }
+  else
+  {
+    read_map(filename, magfield_rescale);
+    const PHFieldBinaryCache::axes_t axes = {
+        std::vector<double>(r_map_.begin(), r_map_.end()),
+        std::vector<double>(phi_map_.begin(), phi_map_.end()),
+        std::vector<double>(z_map_.begin(), z_map_.end())};
+    if (m_cache->enabled() && m_cache->save(axes, m_field_storage, ncomponents))
+    {
+      std::cout << " ---> Field grid cached to " << m_cache->get_filename() << std::endl;
+    }
+    m_cache.reset();
+    m_field = m_field_storage.data();
+  }
+
+  // grab the minimum and maximum z values
+  minz_ = z_map_.front();
+  maxz_ = z_map_.back();
+
+  set_grid();
+
+  std::cout << "\n ---> ... read file successfully "
+            << "\n ---> Z Boundaries ~ zlow, zhigh: "
+            << minz_ / cm << "," << maxz_ / cm << " cm " << std::endl;
+
+  std::cout << "\n================= End Construct Mag Field ======================\n"
+            << std::endl;
+}
+
+PHField3DCylindrical::~PHField3DCylindrical() = default;
+
+void PHField3DCylindrical::read_map(const std::string &filename, const float magfield_rescale)
+{
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -50,25 +122,50 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
   field_map->SetBranchAddress("br", &ROOT_BR);
   field_map->SetBranchAddress("bphi", &ROOT_BPHI);
 
-  // get the number of entries in the tree
-  int nz;
-  int nr;
-  int nphi;
-  nz = field_map->GetEntries("z>-1e6");
-  nr = field_map->GetEntries("r>-1e6");
-  nphi = field_map->GetEntries("phi>-1e6");
-  static const int NENTRIES = field_map->GetEntries();
+  const int NENTRIES = field_map->GetEntries();
+  std::cout << " ---> The field grid contained " << NENTRIES << " entries" << std::endl;
+
+  // Keep track of the unique z, r, phi values in the grid using sets
+  std::set<float> z_set;
+  std::set<float> r_set;
+  std::set<float> phi_set;
+
+  // single pass over the ntuple. Entries need not be ordered
+  std::vector<entry_t> entries;
+  entries.reserve(NENTRIES);
+  for (int i = 0; i < NENTRIES; i++)
+  {
+    field_map->GetEntry(i);
+    const entry_t entry = {
+        static_cast<float>(ROOT_R * cm), static_cast<float>(ROOT_PHI * deg), static_cast<float>(ROOT_Z * cm),
+        static_cast<float>(ROOT_BR * gauss) * magfield_rescale, static_cast<float>(ROOT_BPHI * gauss) * magfield_rescale, static_cast<float>(ROOT_BZ * gauss) * magfield_rescale};
+    entries.push_back(entry);
+
+    r_set.insert(entry.r);
+    phi_set.insert(entry.phi);
+    z_set.insert(entry.z);
+  }
+  rootinput->Close();
+
+  if (entries.empty())
+  {
+    std::cout << "PHField3DCylindrical::read_map - no entries in " << filename << " exiting now" << std::endl;
+    exit(1);
+  }
+
+  r_map_.assign(r_set.begin(), r_set.end());
+  phi_map_.assign(phi_set.begin(), phi_set.end());
+  z_map_.assign(z_set.begin(), z_set.end());
 
   // run checks on entries
-  std::cout << " ---> The field grid contained " << NENTRIES << " entries" << std::endl;
   if (Verbosity() > 0)
   {
-    std::cout << "\n  NENTRIES should be the same as the following values:"
+    std::cout << "\n  NENTRIES should be the same as the product of the following values:"
               << "\n  [ Number of values r,phi,z: "
-              << nr << " " << nphi << " " << nz << " ]! " << std::endl;
+              << r_map_.size() << " " << phi_map_.size() << " " << z_map_.size() << " ]! " << std::endl;
   }
 
-  if (nz != nr || nz != nphi || nr != nphi)
+  if (r_map_.size() * phi_map_.size() * z_map_.size() != entries.size())
   {
     std::cout << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!"
               << "\n The file you entered is not a \"table\" of values"
@@ -76,148 +173,87 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
               << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!" << std::endl;
   }
 
-  // Keep track of the unique z, r, phi values in the grid using sets
-  std::set<float> z_set;
-  std::set<float> r_set;
-  std::set<float> phi_set;
-
-  // Sort the entries to get rid of any stupid ordering problems...
-
-  // We copy the TNtuple into a std::map (which is always sorted)
-  // using a 3-tuple of (z, r, phi) so it is sorted in z, then r, then
-  // phi.
   if (Verbosity() > 0)
   {
-    std::cout << "  --> Sorting Entries..." << std::endl;
-  }
-  std::map<trio, trio> sorted_map;
-  for (int i = 0; i < field_map->GetEntries(); i++)
-  {
-    field_map->GetEntry(i);
-    trio coord_key(ROOT_Z, ROOT_R, ROOT_PHI);
-    trio field_val(ROOT_BZ, ROOT_BR, ROOT_BPHI);
-    sorted_map[coord_key] = field_val;
-
-    z_set.insert(ROOT_Z * cm);
-    r_set.insert(ROOT_R * cm);
-    phi_set.insert(ROOT_PHI * deg);
+    std::cout << "  --> Putting entries into containers... " << std::endl;
   }
 
-  // std::couts for assurance
-  if (Verbosity() > 4)
+  // interleaved (r,phi,z)->(Br,Bphi,Bz). Missing grid points are left at zero
+  m_field_storage.assign(r_map_.size() * phi_map_.size() * z_map_.size() * ncomponents, 0);
+  for (const auto &entry : entries)
   {
-    std::map<trio, trio>::iterator it = sorted_map.begin();
-    print_map(it);
-    float last_z = std::get<0>(it->first);
-    for (it = sorted_map.begin(); it != sorted_map.end(); ++it)
+    const int ir = axis_index(r_map_, entry.r);
+    const int iphi = axis_index(phi_map_, entry.phi);
+    const int iz = axis_index(z_map_, entry.z);
+    float *b = &m_field_storage[((static_cast<std::size_t>(ir) * phi_map_.size() + iphi) * z_map_.size() + iz) * ncomponents];
+    b[0] = entry.br;
+    b[1] = entry.bphi;
+    b[2] = entry.bz;
+
+    // you can change this to check table values for correctness
+    if (std::fabs(entry.z) < 10 && ir < 10 && Verbosity() > 3)
     {
-      if (std::get<0>(it->first) != last_z)
-      {
-        last_z = std::get<0>(it->first);
-        print_map(it);
-      }
+      std::cout << " B("
+                << r_map_[ir] << ", "
+                << phi_map_[iphi] << ", "
+                << z_map_[iz] << "):  ("
+                << b[0] << ", "
+                << b[1] << ", "
+                << b[2] << ")" << std::endl;
     }
   }
+}
 
-  if (Verbosity() > 0)
+void PHField3DCylindrical::set_grid()
+{
+  // direct index arithmetic for uniform axes, binary search otherwise
+  const std::array<const std::vector<float> *, 3> axes = {&r_map_, &phi_map_, &z_map_};
+  for (std::size_t i = 0; i < axes.size(); ++i)
   {
-    std::cout << "  --> Putting entries into containers... " << std::endl;
-  }
+    const auto &axis = *axes[i];
+    m_inverse_step[i] = 0;
+    if (axis.size() < 2)
+    {
+      continue;
+    }
 
-  // grab the minimum and maximum z values
-  minz_ = *(z_set.begin());
-  std::set<float>::iterator ziter = z_set.end();
-  --ziter;
-  maxz_ = *ziter;
-
-  // initialize maps
-  nz = z_set.size();
-  nr = r_set.size();
-  nphi = phi_set.size();
-  r_map_.resize(nr, 0);
-  z_map_.resize(nz, 0);
-  phi_map_.resize(nphi, 0);
-
-  std::copy(z_set.begin(), z_set.end(), z_map_.begin());
-  std::copy(phi_set.begin(), phi_set.end(), phi_map_.begin());
-  std::copy(r_set.begin(), r_set.end(), r_map_.begin());
-
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldPHI_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldZ_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-
-  // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
-  unsigned int ir = 0;
-  unsigned int iphi = 0;
-  unsigned int iz = 0;  // useful indexes to keep track of
-  std::map<trio, trio>::iterator iter = sorted_map.begin();
-  for (; iter != sorted_map.end(); ++iter)
-  {
-    // equivalent to ->GetEntry(iter)
-    float z = std::get<0>(iter->first) * cm;
-    float r = std::get<1>(iter->first) * cm;
-    float phi = std::get<2>(iter->first) * deg;
-    float Bz = std::get<0>(iter->second) * gauss;
-    float Br = std::get<1>(iter->second) * gauss;
-    float Bphi = std::get<2>(iter->second) * gauss;
-
-    maxz_ = std::max(z, maxz_);
-    minz_ = std::min(z, minz_);
-
-    // check for change in z value, when z changes we have a ton of updates to do
-    if (z != z_map_[iz])
+    const double step = (static_cast<double>(axis.back()) - axis.front()) / (axis.size() - 1);
+    bool uniform = step > 0;
+    for (std::size_t j = 0; uniform && j < axis.size(); ++j)
     {
-      ++iz;
-      ir = 0;
-      iphi = 0;  // reset indices
+      uniform = std::abs(axis[j] - (axis.front() + j * step)) < 1e-4 * step;
     }
-    else if (r != r_map_[ir])
-    {  // check for change in r value
-      ++ir;
-      iphi = 0;
+
+    if (uniform)
+    {
+      m_inverse_step[i] = 1. / step;
     }
-    else if (phi != phi_map_[iphi])
-    {  // change in phi value? (should be every time)
-      ++iphi;
+    else if (Verbosity() > 0)
+    {
+      std::cout << "PHField3DCylindrical::set_grid - axis " << i << " is not uniform, using binary search" << std::endl;
     }
+  }
+}
 
-    // shouldn't happen
-    if (iz > 0 && z < z_map_[iz - 1])
+int PHField3DCylindrical::find_index(const std::vector<float> &axis, double inverse_step, float value) const
+{
+  if (inverse_step > 0 && std::isfinite(value))
+  {
+    // direct index arithmetic, corrected by one bin for rounding so that the result matches upper_bound exactly
+    const int size = axis.size();
+    int index = std::clamp<double>(std::floor((value - axis.front()) * inverse_step), -1, size - 1);
+    if (index + 1 < size && axis[index + 1] <= value)
     {
-      std::cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << std::endl;
+      ++index;
     }
-
-    BFieldR_[iz][ir][iphi] = Br * magfield_rescale;
-    BFieldPHI_[iz][ir][iphi] = Bphi * magfield_rescale;
-    BFieldZ_[iz][ir][iphi] = Bz * magfield_rescale;
-
-    // you can change this to check table values for correctness
-    // print_map prints the values in the root table, and the
-    // std::couts print the values entered into the vectors
-    if (std::fabs(z) < 10 && ir < 10 /*&& iphi==2*/ && Verbosity() > 3)
+    else if (index >= 0 && axis[index] > value)
     {
-      print_map(iter);
-
-      std::cout << " B("
-                << r_map_[ir] << ", "
-                << phi_map_[iphi] << ", "
-                << z_map_[iz] << "):  ("
-                << BFieldR_[iz][ir][iphi] << ", "
-                << BFieldPHI_[iz][ir][iphi] << ", "
-                << BFieldZ_[iz][ir][iphi] << ")" << std::endl;
+      --index;
     }
+    return index;
+  }
 
-  }  // end loop over root field map file
-
-  rootinput->Close();
-
-  std::cout << "\n ---> ... read file successfully "
-            << "\n ---> Z Boundaries ~ zlow, zhigh: "
-            << minz_ / cm << "," << maxz_ / cm << " cm " << std::endl;
-
-  std::cout << "\n================= End Construct Mag Field ======================\n"
-            << std::endl;
+  return std::distance(axis.begin(), std::upper_bound(axis.begin(), axis.end(), value)) - 1;
 }
 
 void PHField3DCylindrical::GetFieldValue(const double point[4], double *Bfield) const
@@ -325,8 +361,7 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
     return;
   }
 
-  std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-  int z_index0 = distance(z_map_.begin(), ziter) - 1;
+  int z_index0 = find_index(z_map_, m_inverse_step[2], z);
   int z_index1 = z_index0 + 1;
 
   assert(z_index0 >= 0);
@@ -334,8 +369,7 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   assert(z_index0 < (int) z_map_.size());
   assert(z_index1 < (int) z_map_.size());
 
-  std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-  int r_index0 = distance(r_map_.begin(), riter) - 1;
+  int r_index0 = find_index(r_map_, m_inverse_step[0], r);
   if (r_index0 >= (int) r_map_.size())
   {
     if (Verbosity() > 2)
@@ -358,8 +392,7 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   assert(r_index0 >= 0);
   assert(r_index1 >= 0);
 
-  std::vector<float>::const_iterator phiiter = upper_bound(phi_map_.begin(), phi_map_.end(), phi);
-  int phi_index0 = distance(phi_map_.begin(), phiiter) - 1;
+  int phi_index0 = find_index(phi_map_, m_inverse_step[1], phi);
   int phi_index1 = phi_index0 + 1;
   if (phi_index1 >= (int) phi_map_.size())
   {
@@ -370,32 +403,42 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   assert(phi_index0 < (int) phi_map_.size());
   assert(phi_index1 >= 0);
 
-  double Br000 = BFieldR_[z_index0][r_index0][phi_index0];
-  double Br001 = BFieldR_[z_index0][r_index0][phi_index1];
-  double Br010 = BFieldR_[z_index0][r_index1][phi_index0];
-  double Br011 = BFieldR_[z_index0][r_index1][phi_index1];
-  double Br100 = BFieldR_[z_index1][r_index0][phi_index0];
-  double Br101 = BFieldR_[z_index1][r_index0][phi_index1];
-  double Br110 = BFieldR_[z_index1][r_index1][phi_index0];
-  double Br111 = BFieldR_[z_index1][r_index1][phi_index1];
-
-  double Bphi000 = BFieldPHI_[z_index0][r_index0][phi_index0];
-  double Bphi001 = BFieldPHI_[z_index0][r_index0][phi_index1];
-  double Bphi010 = BFieldPHI_[z_index0][r_index1][phi_index0];
-  double Bphi011 = BFieldPHI_[z_index0][r_index1][phi_index1];
-  double Bphi100 = BFieldPHI_[z_index1][r_index0][phi_index0];
-  double Bphi101 = BFieldPHI_[z_index1][r_index0][phi_index1];
-  double Bphi110 = BFieldPHI_[z_index1][r_index1][phi_index0];
-  double Bphi111 = BFieldPHI_[z_index1][r_index1][phi_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0][phi_index0];
-  double Bz001 = BFieldZ_[z_index0][r_index0][phi_index1];
-  double Bz100 = BFieldZ_[z_index1][r_index0][phi_index0];
-  double Bz101 = BFieldZ_[z_index1][r_index0][phi_index1];
-  double Bz010 = BFieldZ_[z_index0][r_index1][phi_index0];
-  double Bz110 = BFieldZ_[z_index1][r_index1][phi_index0];
-  double Bz011 = BFieldZ_[z_index0][r_index1][phi_index1];
-  double Bz111 = BFieldZ_[z_index1][r_index1][phi_index1];
+  // the eight surrounding grid points, as (Br, Bphi, Bz)
+  const float *b000 = field(r_index0, phi_index0, z_index0);
+  const float *b001 = field(r_index0, phi_index1, z_index0);
+  const float *b010 = field(r_index1, phi_index0, z_index0);
+  const float *b011 = field(r_index1, phi_index1, z_index0);
+  const float *b100 = field(r_index0, phi_index0, z_index1);
+  const float *b101 = field(r_index0, phi_index1, z_index1);
+  const float *b110 = field(r_index1, phi_index0, z_index1);
+  const float *b111 = field(r_index1, phi_index1, z_index1);
+
+  double Br000 = b000[0];
+  double Br001 = b001[0];
+  double Br010 = b010[0];
+  double Br011 = b011[0];
+  double Br100 = b100[0];
+  double Br101 = b101[0];
+  double Br110 = b110[0];
+  double Br111 = b111[0];
+
+  double Bphi000 = b000[1];
+  double Bphi001 = b001[1];
+  double Bphi010 = b010[1];
+  double Bphi011 = b011[1];
+  double Bphi100 = b100[1];
+  double Bphi101 = b101[1];
+  double Bphi110 = b110[1];
+  double Bphi111 = b111[1];
+
+  double Bz000 = b000[2];
+  double Bz001 = b001[2];
+  double Bz100 = b100[2];
+  double Bz101 = b101[2];
+  double Bz010 = b010[2];
+  double Bz110 = b110[2];
+  double Bz011 = b011[2];
+  double Bz111 = b111[2];
 
   double zweight = z - z_map_[z_index0];
   double zspacing = z_map_[z_index1] - z_map_[z_index0];
@@ -454,44 +497,3 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
 
   return;
 }
-
-// a binary search algorithm that puts the location that "key" would be, into index...
-// it returns true if key was found, and false if not.
-bool PHField3DCylindrical::bin_search(const std::vector<float> &vec, unsigned start, unsigned end, const float &key, unsigned &index) const
-{
-  // Termination condition: start index greater than end index
-  if (start > end)
-  {
-    index = start;
-    return false;
-  }
-
-  // Find the middle element of the vector and use that for splitting
-  // the array into two pieces.
-  unsigned middle = start + ((end - start) / 2);
-
-  if (vec[middle] == key)
-  {
-    index = middle;
-    return true;
-  }
-  if (vec[middle] > key)
-  {
-    return bin_search(vec, start, middle - 1, key, index);
-  }
-  return bin_search(vec, middle + 1, end, key, index);
-}
-
-// debug function to print key/value pairs in map
-void PHField3DCylindrical::print_map(std::map<trio, trio>::iterator &it) const
-{
-  std::cout << "    Key: <"
-            << std::get<0>(it->first) * cm << ","
-            << std::get<1>(it->first) * cm << ","
-            << std::get<2>(it->first) * deg << ">"
-
-            << " Value: <"
-            << std::get<0>(it->second) * gauss << ","
-            << std::get<1>(it->second) * gauss << ","
-            << std::get<2>(it->second) * gauss << ">" << std::endl;
-}
@@ -22,27 +22,23 @@
 
 #include "PHField.h"
 
-#include <map>
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <string>
-#include <tuple>
 #include <vector>
 
+class PHFieldBinaryCache;
+
 class PHField3DCylindrical : public PHField
 {
-  typedef std::tuple<float, float, float> trio;
-
  public:
   PHField3DCylindrical(const std::string& filename, int verb = 0, const float magfield_rescale = 1.0);
-  ~PHField3DCylindrical() override {}
+  ~PHField3DCylindrical() override;
   void GetFieldValue(const double Point[4], double* Bfield) const override;
   void GetFieldCyl(const double CylPoint[4], double* Bfield) const;
 
  protected:
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<std::vector<float> > > BFieldZ_;
-  std::vector<std::vector<std::vector<float> > > BFieldR_;
-  std::vector<std::vector<std::vector<float> > > BFieldPHI_;
-
   // maps indices to values z_map[i] = z_value that corresponds to ith index
   std::vector<float> z_map_;    // < i >
   std::vector<float> r_map_;    // < j >
@@ -51,8 +47,28 @@ class PHField3DCylindrical : public PHField
   float maxz_, minz_;  // boundaries of magnetic field map cyl
 
  private:
-  bool bin_search(const std::vector<float>& vec, unsigned start, unsigned end, const float& key, unsigned& index) const;
-  void print_map(std::map<trio, trio>::iterator& it) const;
+  //! fill axes and field values from ROOT ntuple
+  void read_map(const std::string& filename, const float magfield_rescale);
+
+  //! setup index calculation from axes
+  void set_grid();
+
+  //! index of the last axis value smaller or equal to value, -1 if none (same as upper_bound - 1)
+  int find_index(const std::vector<float>& axis, double inverse_step, float value) const;
+
+  //! field value at a given grid point
+  const float* field(int ir, int iphi, int iz) const
+  {
+    return m_field + ((static_cast<std::size_t>(ir) * phi_map_.size() + iphi) * z_map_.size() + iz) * 3;
+  }
+
+  //! inverse step size for r, phi and z axes, zero if the axis is not uniform
+  std::array<double, 3> m_inverse_step{};
+
+  //! interleaved (r,phi,z)->(Br,Bphi,Bz) field values. Either owned (m_field_storage) or memory mapped (m_cache)
+  std::vector<float> m_field_storage;
+  std::unique_ptr<PHFieldBinaryCache> m_cache;
+  const float* m_field = nullptr;
 };
 
 #endif
@@ -0,0 +1,276 @@
+#include "PHFieldBinaryCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>  // for std::rename, std::remove
+#include <cstdlib>  // for getenv
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+  //! cache file format version. Increment on any change of the layout
+  constexpr uint32_t cache_version = 1;
+
+  //! maximum number of construction parameters
+  constexpr std::size_t max_parameters = 8;
+
+  //! file header, followed by the axes values (double) and the field values (float)
+  struct header_t
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t ncomponents;
+    uint64_t source_size;
+    int64_t source_mtime;
+    char type[32];
+    uint64_t nparameters;
+    double parameters[max_parameters];
+    uint64_t naxis[3];
+    uint64_t nfield;
+  };
+
+  constexpr char cache_magic[8] = {'P', 'H', 'F', 'I', 'E', 'L', 'D', 'C'};
+
+  //! shared cache directory, initialized from environment
+  std::string& cache_directory()
+  {
+    static std::string directory = []()
+    {
+      const char* env = getenv("PHFIELD_CACHE_DIR");
+      return env ? std::string(env) : std::string();
+    }();
+    return directory;
+  }
+
+  //! fill header from source file and parameters. Returns false if source cannot be accessed
+  bool make_header(header_t& header, const std::string& source, const std::string& type, const std::vector<double>& parameters)
+  {
+    struct stat source_stat
+    {
+    };
+    if (stat(source.c_str(), &source_stat) != 0)
+    {
+      return false;
+    }
+
+    std::memset(&header, 0, sizeof(header_t));
+    std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+    header.version = cache_version;
+    header.source_size = source_stat.st_size;
+    header.source_mtime = source_stat.st_mtime;
+    std::strncpy(header.type, type.c_str(), sizeof(header.type) - 1);
+    header.nparameters = std::min(parameters.size(), max_parameters);
+    std::copy_n(parameters.begin(), header.nparameters, header.parameters);
+    return true;
+  }
+
+  //! true if two headers describe the same source and parameters
+  bool same_source(const header_t& lhs, const header_t& rhs)
+  {
+    return std::memcmp(lhs.magic, rhs.magic, sizeof(lhs.magic)) == 0 &&
+           lhs.version == rhs.version &&
+           lhs.source_size == rhs.source_size &&
+           lhs.source_mtime == rhs.source_mtime &&
+           std::strncmp(lhs.type, rhs.type, sizeof(lhs.type)) == 0 &&
+           lhs.nparameters == rhs.nparameters &&
+           std::equal(lhs.parameters, lhs.parameters + lhs.nparameters, rhs.parameters);
+  }
+}  // namespace
+
+//_____________________________________________________________
+PHFieldBinaryCache::PHFieldBinaryCache(const std::string& source, const std::string& type, const std::vector<double>& parameters)
+  : m_source(source)
+  , m_type(type)
+  , m_parameters(parameters)
+{
+  if (m_parameters.size() > max_parameters)
+  {
+    std::cout << "PHFieldBinaryCache::PHFieldBinaryCache - too many parameters: " << m_parameters.size()
+              << " for " << type << ", cache disabled" << std::endl;
+    return;
+  }
+
+  const auto& directory = get_directory();
+  if (directory.empty())
+  {
+    return;
+  }
+
+  // file name from source base name, type, and a hash of the full source path and parameters
+  std::ostringstream key;
+  key << source;
+  for (const auto& parameter : parameters)
+  {
+    key << ":" << std::setprecision(17) << parameter;
+  }
+
+  const auto base = source.substr(source.find_last_of('/') + 1);
+  std::ostringstream filename;
+  filename << directory << "/" << base << "." << type << "."
+           << std::hex << std::hash<std::string>{}(key.str()) << ".bin";
+  m_filename = filename.str();
+}
+
+//_____________________________________________________________
+PHFieldBinaryCache::~PHFieldBinaryCache()
+{
+  unmap();
+}
+
+//_____________________________________________________________
+void PHFieldBinaryCache::set_directory(const std::string& directory)
+{
+  cache_directory() = directory;
+}
+
+const std::string& PHFieldBinaryCache::get_directory()
+{
+  return cache_directory();
+}
+
+//_____________________________________________________________
+bool PHFieldBinaryCache::load()
+{
+  unmap();
+  if (!enabled())
+  {
+    return false;
+  }
+
+  header_t expected{};
+  if (!make_header(expected, m_source, m_type, m_parameters))
+  {
+    return false;
+  }
+
+  const int fd = open(m_filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  struct stat cache_stat
+  {
+  };
+  if (fstat(fd, &cache_stat) != 0 || static_cast<std::size_t>(cache_stat.st_size) < sizeof(header_t))
+  {
+    close(fd);
+    return false;
+  }
+
+  m_mapped_size = cache_stat.st_size;
+  m_mapped = mmap(nullptr, m_mapped_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (m_mapped == MAP_FAILED)
+  {
+    m_mapped = nullptr;
+    m_mapped_size = 0;
+    return false;
+  }
+
+  const auto* header = static_cast<const header_t*>(m_mapped);
+  const std::size_t naxes = header->naxis[0] + header->naxis[1] + header->naxis[2];
+  const std::size_t expected_size = sizeof(header_t) + naxes * sizeof(double) + header->nfield * sizeof(float);
+  if (!same_source(*header, expected) || m_mapped_size != expected_size)
+  {
+    std::cout << "PHFieldBinaryCache::load - " << m_filename << " does not match " << m_source << ", ignored" << std::endl;
+    unmap();
+    return false;
+  }
+
+  const auto* axes = reinterpret_cast<const double*>(static_cast<const char*>(m_mapped) + sizeof(header_t));
+  for (int i = 0; i < 3; ++i)
+  {
+    m_axes[i].assign(axes, axes + header->naxis[i]);
+    axes += header->naxis[i];
+  }
+
+  m_field = reinterpret_cast<const float*>(axes);
+  m_field_size = header->nfield;
+  m_ncomponents = header->ncomponents;
+  return true;
+}
+
+//_____________________________________________________________
+bool PHFieldBinaryCache::save(const axes_t& axes, const std::vector<float>& field, unsigned int ncomponents) const
+{
+  if (!enabled())
+  {
+    return false;
+  }
+
+  header_t header{};
+  if (!make_header(header, m_source, m_type, m_parameters))
+  {
+    return false;
+  }
+
+  header.ncomponents = ncomponents;
+  for (int i = 0; i < 3; ++i)
+  {
+    header.naxis[i] = axes[i].size();
+  }
+  header.nfield = field.size();
+
+  // write to a temporary file first, then rename
+  const std::string tmpname = m_filename + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+      std::cout << "PHFieldBinaryCache::save - could not open " << tmpname << std::endl;
+      return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header_t));
+    for (const auto& axis : axes)
+    {
+      out.write(reinterpret_cast<const char*>(axis.data()), axis.size() * sizeof(double));
+    }
+    out.write(reinterpret_cast<const char*>(field.data()), field.size() * sizeof(float));
+    if (!out)
+    {
+      std::cout << "PHFieldBinaryCache::save - failed writing " << tmpname << std::endl;
+      std::remove(tmpname.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tmpname.c_str(), m_filename.c_str()) != 0)
+  {
+    std::cout << "PHFieldBinaryCache::save - could not rename " << tmpname << " to " << m_filename << std::endl;
+    std::remove(tmpname.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+//_____________________________________________________________
+void PHFieldBinaryCache::unmap()
+{
+  if (m_mapped)
+  {
+    munmap(m_mapped, m_mapped_size);
+  }
+
+  m_mapped = nullptr;
+  m_mapped_size = 0;
+  m_field = nullptr;
+  m_field_size = 0;
+  m_ncomponents = 0;
+  for (auto& axis : m_axes)
+  {
+    axis.clear();
+  }
+}
@@ -0,0 +1,94 @@
+#ifndef PHFIELD_PHFIELDBINARYCACHE_H
+#define PHFIELD_PHFIELDBINARYCACHE_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//! \brief memory mapped binary cache for gridded field maps
+/*!
+ * Field maps are parsed from ROOT ntuples on every job start. When a cache directory is set,
+ * the first job writes the parsed grid (axes and interleaved field components) to a flat binary file,
+ * and later jobs map it in memory instead of parsing the ntuple again.
+ *
+ * A cache file is only used if it matches the source map file (path, size and modification time),
+ * the field map type and the construction parameters (e.g. rescale factor). Otherwise it is rewritten.
+ * Files are written to a temporary name and renamed, so that concurrent jobs never read a partial file.
+ *
+ * The cache directory is taken from the PHFIELD_CACHE_DIR environment variable, or set with set_directory().
+ * An empty directory disables the cache.
+ */
+class PHFieldBinaryCache
+{
+ public:
+  //! grid axes
+  using axes_t = std::array<std::vector<double>, 3>;
+
+  //! constructor
+  /*!
+   * @param source      field map file the cache is built from
+   * @param type        field map type, e.g. the class name
+   * @param parameters  construction parameters the cached values depend on
+   */
+  PHFieldBinaryCache(const std::string& source, const std::string& type, const std::vector<double>& parameters);
+
+  //! destructor. Unmaps the file if mapped
+  ~PHFieldBinaryCache();
+
+  // not copyable
+  PHFieldBinaryCache(const PHFieldBinaryCache&) = delete;
+  PHFieldBinaryCache& operator=(const PHFieldBinaryCache&) = delete;
+
+  //! cache directory, shared by all field maps
+  static void set_directory(const std::string& directory);
+  static const std::string& get_directory();
+
+  //! true if a cache directory is set
+  bool enabled() const { return !m_filename.empty(); }
+
+  //! cache file name
+  const std::string& get_filename() const { return m_filename; }
+
+  //! map existing cache file. Returns false if missing or inconsistent with source
+  bool load();
+
+  //! write cache file from axes and field values, with ncomponents interleaved values per grid point
+  bool save(const axes_t& axes, const std::vector<float>& field, unsigned int ncomponents) const;
+
+  //!@name accessors, valid after a successful load
+  //@{
+  const axes_t& get_axes() const { return m_axes; }
+  const float* get_field() const { return m_field; }
+  std::size_t get_field_size() const { return m_field_size; }
+  unsigned int get_ncomponents() const { return m_ncomponents; }
+  //@}
+
+ private:
+  //! unmap file
+  void unmap();
+
+  //! source file
+  std::string m_source;
+
+  //! field map type
+  std::string m_type;
+
+  //! construction parameters
+  std::vector<double> m_parameters;
+
+  //! cache file name, empty if cache is disabled
+  std::string m_filename;
+
+  //! mapped region
+  void* m_mapped = nullptr;
+  std::size_t m_mapped_size = 0;
+
+  //! content
+  axes_t m_axes;
+  const float* m_field = nullptr;
+  std::size_t m_field_size = 0;
+  unsigned int m_ncomponents = 0;
+};
+
+#endif
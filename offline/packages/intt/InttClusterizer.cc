@@ -5,6 +5,7 @@
 #include <trackbase/TrkrClusterContainerv4.h>
 #include <trackbase/TrkrClusterCrossingAssocv1.h>
 #include <trackbase/TrkrClusterHitAssocv3.h>
+#include <trackbase/TrkrClusterLabeling.h>
 #include <trackbase/TrkrClusterv5.h>
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
@@ -29,9 +30,6 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -52,52 +50,6 @@ namespace
   }
 }  // namespace
 
-bool InttClusterizer::ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*>& lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*>& rhs, const int layer) const
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) <= 1)
-    {
-      if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) == 0)
-  {
-    if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-bool InttClusterizer::ladder_are_adjacent(RawHit* lhs, RawHit* rhs, const int layer) const
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs((int) (lhs->getPhiBin()) - (int) (rhs->getPhiBin())) <= 1)  // col
-    {
-      if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) <= 1)  // Row
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs((int) (lhs->getPhiBin()) - (int)(rhs->getPhiBin())) <= 1)
-  {
-    if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) == 0)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 InttClusterizer::InttClusterizer(const std::string& name,
                                  unsigned int /*min_layer*/,
                                  unsigned int /*max_layer*/)
@@ -401,29 +353,17 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // Find adjacent strips: same column (or neighbor columns, with z clustering) and neighbor rows
+    std::vector<TrkrClusterLabeling::coordinate_t> coordinates;
+    coordinates.reserve(hitvec.size());
+    for (const auto& hit : hitvec)
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
+      coordinates.emplace_back(InttDefs::getCol(hit.first), InttDefs::getRow(hit.first));
     }
 
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, component.data());
+    // connected strips are labeled in order of first appearance, same as boost::connected_components
+    std::vector<int> component;
+    TrkrClusterLabeling::label_connected_hits(coordinates, get_z_clustering(layer), component);
 
     // Loop over the components(hit cells) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -670,29 +610,17 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // Find adjacent strips: same time bin (or neighbor time bins, with z clustering) and neighbor phi bins
+    std::vector<TrkrClusterLabeling::coordinate_t> coordinates;
+    coordinates.reserve(hitvec.size());
+    for (auto* hit : hitvec)
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
+      coordinates.emplace_back(hit->getTBin(), hit->getPhiBin());
     }
 
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, component.data());
+    // connected strips are labeled in order of first appearance, same as boost::connected_components
+    std::vector<int> component;
+    TrkrClusterLabeling::label_connected_hits(coordinates, get_z_clustering(layer), component);
 
     // Loop over the components(hit cells) compiling a list of the
     // unique connected groups (ie. clusters).
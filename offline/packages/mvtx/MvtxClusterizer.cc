@@ -14,6 +14,7 @@
 #include <trackbase/MvtxDefs.h>
 #include <trackbase/TrkrClusterContainerv4.h>
 #include <trackbase/TrkrClusterHitAssocv3.h>
+#include <trackbase/TrkrClusterLabeling.h>
 #include <trackbase/TrkrClusterv3.h>
 #include <trackbase/TrkrClusterv4.h>
 #include <trackbase/TrkrClusterv5.h>
@@ -42,13 +43,6 @@
 #include <TMatrixTUtils.h>  // for TMatrixTRow
 #include <TVector3.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#include <boost/graph/adjacency_list.hpp>
-#pragma GCC diagnostic pop
-
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <cstdlib>  // for exit
@@ -69,49 +63,6 @@ namespace
   }
 }  // namespace
 
-bool MvtxClusterizer::are_adjacent(
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs,
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs) const
-{
-  if (GetZClustering())
-  {
-    return
-
-        // column adjacent
-        ((MvtxDefs::getCol(lhs.first) > MvtxDefs::getCol(rhs.first)) ? MvtxDefs::getCol(lhs.first) <= MvtxDefs::getCol(rhs.first) + 1 : MvtxDefs::getCol(rhs.first) <= MvtxDefs::getCol(lhs.first) + 1) &&
-
-        // row adjacent
-        ((MvtxDefs::getRow(lhs.first) > MvtxDefs::getRow(rhs.first)) ? MvtxDefs::getRow(lhs.first) <= MvtxDefs::getRow(rhs.first) + 1 : MvtxDefs::getRow(rhs.first) <= MvtxDefs::getRow(lhs.first) + 1);
-  }
-  return
-      // column identical
-      MvtxDefs::getCol(rhs.first) == MvtxDefs::getCol(lhs.first) &&
-
-      // row adjacent
-      ((MvtxDefs::getRow(lhs.first) > MvtxDefs::getRow(rhs.first)) ? MvtxDefs::getRow(lhs.first) <= MvtxDefs::getRow(rhs.first) + 1 : MvtxDefs::getRow(rhs.first) <= MvtxDefs::getRow(lhs.first) + 1);
-}
-
-bool MvtxClusterizer::are_adjacent(RawHit *lhs, RawHit *rhs) const
-{
-  if (GetZClustering())
-  {
-    return
-
-        // phi adjacent (== column)
-        ((lhs->getPhiBin() > rhs->getPhiBin()) ? lhs->getPhiBin() <= rhs->getPhiBin() + 1 : rhs->getPhiBin() <= lhs->getPhiBin() + 1) &&
-
-        // time adjacent (== row)
-        ((lhs->getTBin() > rhs->getTBin()) ? lhs->getTBin() <= rhs->getTBin() + 1 : rhs->getTBin() <= lhs->getTBin() + 1);
-  }
-  return
-
-      // phi identical (== column)
-      lhs->getPhiBin() == rhs->getPhiBin() &&
-
-      // time adjacent (== row)
-      ((lhs->getTBin() > rhs->getTBin()) ? lhs->getTBin() <= rhs->getTBin() + 1 : rhs->getTBin() <= lhs->getTBin() + 1);
-}
-
 MvtxClusterizer::MvtxClusterizer(const std::string &name)
   : SubsysReco(name)
 {
@@ -353,28 +304,17 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
     }
 
     // do the clustering
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // hits are adjacent if they share a column (or neighbor columns, with z clustering) and have neighbor rows
+    std::vector<TrkrClusterLabeling::coordinate_t> coordinates;
+    coordinates.reserve(hitvec.size());
+    for (const auto &hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      coordinates.emplace_back(MvtxDefs::getCol(hit.first), MvtxDefs::getRow(hit.first));
     }
 
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    boost::connected_components(G, component.data());
+    // connected hits are labeled in order of first appearance, same as boost::connected_components
+    std::vector<int> component;
+    TrkrClusterLabeling::label_connected_hits(coordinates, GetZClustering(), component);
 
     // Loop over the components(hits) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -655,28 +595,17 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
     }
 
     // do the clustering
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // phi bin and time bin play the role of column and row
+    std::vector<TrkrClusterLabeling::coordinate_t> coordinates;
+    coordinates.reserve(hitvec.size());
+    for (auto *hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      coordinates.emplace_back(hit->getPhiBin(), hit->getTBin());
     }
 
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    boost::connected_components(G, component.data());
+    // connected hits are labeled in order of first appearance, same as boost::connected_components
+    std::vector<int> component;
+    TrkrClusterLabeling::label_connected_hits(coordinates, GetZClustering(), component);
 
     // Loop over the components(hits) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -63,10 +63,7 @@ class MvtxClusterizer : public SubsysReco
   ClusHitsVerbose *mClusHitsVerbose{nullptr};
 
  private:
-  // bool are_adjacent(const pixel lhs, const pixel rhs);
   bool record_ClusHitsVerbose{false};
-  bool are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs) const;
-  bool are_adjacent(RawHit *lhs, RawHit *rhs) const;
 
   void ClusterMvtx(PHCompositeNode *topNode);
   void ClusterMvtxRaw(PHCompositeNode *topNode);
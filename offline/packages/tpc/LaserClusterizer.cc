@@ -11,6 +11,7 @@
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
+#include <trackbase/TrkrThreadPool.h>
 #include <trackbase/alignmentTransformationContainer.h>
 
 #include <ffaobjects/EventHeader.h>
@@ -95,7 +96,8 @@ namespace
     bool doFitting = false;
   };
 
-  pthread_mutex_t mythreadlock;
+  // serializes ROOT fitting and the global alignment flag between sector tasks
+  pthread_mutex_t mythreadlock = PTHREAD_MUTEX_INITIALIZER;
 
   const std::vector<point> neighborOffsets = {
       point(1, 0, 0), point(-1, 0, 0),
@@ -1003,13 +1005,6 @@ namespace
       remove_hits(clusHits, rtree, adcMap);
     }
   }
-
-  void *ProcessModule(void *threadarg)
-  {
-    auto *my_data = static_cast<thread_data *>(threadarg);
-    ProcessModuleData(my_data);
-    pthread_exit(nullptr);
-  }
 }  // namespace
 
 LaserClusterizer::LaserClusterizer(const std::string &name)
@@ -1021,6 +1016,9 @@ int LaserClusterizer::InitRun(PHCompositeNode *topNode)
 {
   TH1::AddDirectory(kFALSE);
 
+  // start the shared module processing workers
+  TrkrThreadPool::instance().reserve_threads(m_num_threads);
+
   PHNodeIterator iter(topNode);
 
   // Looking for the DST node
@@ -1143,25 +1141,9 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 
   TrkrHitSetContainer::ConstRange hitsetrange = m_hits->getHitSets(TrkrDefs::TrkrId::tpcId);
 
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  std::vector<thread_pair_t> threads;
-  threads.reserve(72);
-
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    std::cout << std::endl
-              << " mutex init failed" << std::endl;
-    return 1;
-  }
+  // one task per side, sector and module
+  std::vector<thread_data> tasks;
+  tasks.reserve(72);
 
   for (unsigned int sec = 0; sec < 12; sec++)
   {
@@ -1171,10 +1153,10 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
       {
         if (Verbosity() > 2)
         {
-          std::cout << "making thread for side: " << s << "   sector: " << sec << "   module: " << mod << std::endl;
+          std::cout << "making task for side: " << s << "   sector: " << sec << "   module: " << mod << std::endl;
         }
 
-        thread_pair_t &thread_pair = threads.emplace_back();
+        thread_data &data = tasks.emplace_back();
 
         std::vector<TrkrHitSet *> hitsets;
         std::vector<unsigned int> layers;
@@ -1204,81 +1186,46 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
           layers.push_back(layer);
         }
 
-        thread_pair.data.geom_container = m_geom_container;
-        thread_pair.data.tGeometry = m_tGeometry;
-        thread_pair.data.hitsets = hitsets;
-        thread_pair.data.layers = layers;
-        thread_pair.data.side = (bool) s;
-        thread_pair.data.sector = sec;
-        thread_pair.data.module = mod;
-        thread_pair.data.cluster_vector = cluster_vector;
-        thread_pair.data.cluster_key_vector = cluster_key_vector;
-        thread_pair.data.adc_threshold = m_adc_threshold;
-        thread_pair.data.peakTimeBin = m_laserEventInfo->getPeakSample(s);
-        thread_pair.data.layerMin = 3;
-        thread_pair.data.layerMax = 3;
-        thread_pair.data.tdriftmax = m_tdriftmax;
-        thread_pair.data.eventNum = m_event;
-        thread_pair.data.Verbosity = Verbosity();
-        thread_pair.data.hitHist = nullptr;
-        thread_pair.data.doFitting = m_do_fitting;
-
-        int rc;
-        rc = pthread_create(&thread_pair.thread, &attr, ProcessModule, (void *) &thread_pair.data);
-
-        if (rc)
-        {
-          std::cout << "Error:unable to create thread," << rc << std::endl;
-        }
-
-        if (m_do_sequential)
-        {
-          // wait for termination of thread
-          int rc2 = pthread_join(thread_pair.thread, nullptr);
-          if (rc2)
-          {
-            std::cout << "Error:unable to join," << rc2 << std::endl;
-          }
-
-          // add clusters from thread to laserClusterContainer
-          const auto &data(thread_pair.data);
-          for (int index = 0; index < (int) data.cluster_vector.size(); ++index)
-          {
-            auto *cluster = data.cluster_vector[index];
-            const auto ckey = data.cluster_key_vector[index];
-
-            m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-          }
-        }
+        data.geom_container = m_geom_container;
+        data.tGeometry = m_tGeometry;
+        data.hitsets = hitsets;
+        data.layers = layers;
+        data.side = (bool) s;
+        data.sector = sec;
+        data.module = mod;
+        data.cluster_vector = cluster_vector;
+        data.cluster_key_vector = cluster_key_vector;
+        data.adc_threshold = m_adc_threshold;
+        data.peakTimeBin = m_laserEventInfo->getPeakSample(s);
+        data.layerMin = 3;
+        data.layerMax = 3;
+        data.tdriftmax = m_tdriftmax;
+        data.eventNum = m_event;
+        data.Verbosity = Verbosity();
+        data.hitHist = nullptr;
+        data.doFitting = m_do_fitting;
       }
     }
   }
 
-  pthread_attr_destroy(&attr);
+  TrkrThreadPool::instance().parallel_for(
+      tasks.size(), [&tasks](std::size_t index, unsigned int /*worker*/)
+      { ProcessModuleData(&tasks[index]); },
+      m_do_sequential);
 
-  if (!m_do_sequential)
+  // add clusters from all tasks to laserClusterContainer
+  for (const auto &data : tasks)
   {
-    for (const auto &thread_pair : threads)
+    for (int index = 0; index < (int) data.cluster_vector.size(); ++index)
     {
-      int rc2 = pthread_join(thread_pair.thread, nullptr);
-      if (rc2)
-      {
-        std::cout << "Error:unable to join," << rc2 << std::endl;
-      }
-
-      // const auto &data(thread_pair.data);
+      auto *cluster = data.cluster_vector[index];
+      const auto ckey = data.cluster_key_vector[index];
 
-      for (int index = 0; index < (int) thread_pair.data.cluster_vector.size(); ++index)
-      {
-        auto *cluster = thread_pair.data.cluster_vector[index];
-        const auto ckey = thread_pair.data.cluster_key_vector[index];
-
-        m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-      }
+      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
     }
   }
 
-  threads.clear();
+  tasks.clear();
 
   if (Verbosity() > 1)
   {
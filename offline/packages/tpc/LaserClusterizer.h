@@ -16,6 +16,7 @@
 
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 class EventHeader;
@@ -46,6 +47,7 @@ class LaserClusterizer : public SubsysReco
   void set_max_time_samples(int val) { m_time_samples_max = val; }
   void set_lamination(bool val) { m_lamination = val; }
   void set_do_sequential(bool val) { m_do_sequential = val; }
+  void set_num_threads(unsigned int val) { m_num_threads = val; }
   void set_do_fitting(bool val) { m_do_fitting = val; }
 
  private:
@@ -68,6 +70,9 @@ class LaserClusterizer : public SubsysReco
 
   bool m_do_sequential {false};
 
+  //! number of workers in the shared tracking thread pool
+  unsigned int m_num_threads {std::thread::hardware_concurrency()};
+
   bool m_do_fitting {true};
   
   double m_tdriftmax {0};
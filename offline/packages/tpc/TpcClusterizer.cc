@@ -20,6 +20,8 @@
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
+#include <trackbase/TrkrHitSetv2.h>
+#include <trackbase/TrkrThreadPool.h>
 #include <trackbase/alignmentTransformationContainer.h>
 
 #include <trackbase/RawHit.h>
@@ -63,8 +65,6 @@
 #include <utility>  // for pair
 #include <vector>
 #include <unordered_set>
-// Terra incognita....
-#include <pthread.h>
 
 namespace
 {
@@ -139,8 +139,6 @@ namespace
     vec_dVerbose zvec_ClusHitsVerbose;    // only fill if fillClusHitsVerbose
   };
 
-  pthread_mutex_t mythreadlock;
-
   void remove_hit(double adc, int phibin, int tbin, int edge, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
   {
     using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
@@ -884,44 +882,39 @@ namespace
 
     if (my_data->hitset != nullptr)
     {
-      TrkrHitSet *hitset = my_data->hitset;
-      TrkrHitSet::ConstRange hitrangei = hitset->getHits();
-
-      for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-           hitr != hitrangei.second;
-           ++hitr)
+      auto process_hit = [&](TrkrDefs::hitkey hitkey, unsigned int hitadc)
       {
-        if (TpcDefs::getPad(hitr->first) - phioffset < 0)
+        if (TpcDefs::getPad(hitkey) - phioffset < 0)
         {
-          // std::cout << "WARNING phibin out of range: " << TpcDefs::getPad(hitr->first) - phioffset << " | " << phibins << std::endl;
-          continue;
+          // std::cout << "WARNING phibin out of range: " << TpcDefs::getPad(hitkey) - phioffset << " | " << phibins << std::endl;
+          return;
         }
-        if (TpcDefs::getTBin(hitr->first) - toffset < 0)
+        if (TpcDefs::getTBin(hitkey) - toffset < 0)
         {
-          // std::cout << "WARNING tbin out of range: " << TpcDefs::getTBin(hitr->first) - toffset  << " | " << tbins <<std::endl;
+          // std::cout << "WARNING tbin out of range: " << TpcDefs::getTBin(hitkey) - toffset  << " | " << tbins <<std::endl;
         }
-        unsigned short phibin = TpcDefs::getPad(hitr->first) - phioffset;
-        unsigned short tbin = TpcDefs::getTBin(hitr->first) - toffset;
-        unsigned short tbinorg = TpcDefs::getTBin(hitr->first);
+        unsigned short phibin = TpcDefs::getPad(hitkey) - phioffset;
+        unsigned short tbin = TpcDefs::getTBin(hitkey) - toffset;
+        unsigned short tbinorg = TpcDefs::getTBin(hitkey);
         if (phibin >= phibins)
         {
           // std::cout << "WARNING phibin out of range: " << phibin << " | " << phibins << std::endl;
-          continue;
+          return;
         }
         if (tbin >= tbins)
         {
           // std::cout << "WARNING z bin out of range: " << tbin << " | " << tbins << std::endl;
-          continue;
+          return;
         }
         if (tbinorg > tbinmax || tbinorg < tbinmin)
         {
-          continue;
+          return;
         }
 	if (is_pad_masked(phibin + phioffset))
 	{
-	  continue;
+	  return;
 	}
-        double_t fadc = (hitr->second->getAdc()) - pedestal;  // proper int rounding +0.5
+        double_t fadc = hitadc - pedestal;  // proper int rounding +0.5
         unsigned short adc = 0;
         if (fadc > 0)
         {
@@ -944,6 +937,24 @@ namespace
             adcval[phibin][tbin] = adc;
           }
         }
+      };
+
+      if (auto *flat_hitset = dynamic_cast<TrkrHitSetv2 *>(my_data->hitset))
+      {
+        // iterate over keys and adc values, without creating TrkrHit objects
+        flat_hitset->forEachHit(process_hit);
+      }
+      else
+      {
+        TrkrHitSet *hitset = my_data->hitset;
+        TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+
+        for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+             hitr != hitrangei.second;
+             ++hitr)
+        {
+          process_hit(hitr->first, hitr->second->getAdc());
+        }
       }
     }
     else if (my_data->rawhitset != nullptr)
@@ -1132,15 +1143,8 @@ namespace
                 << std::endl;
     }
     */
-    // pthread_exit(nullptr);
   }
 
-  void *ProcessSector(void *threadarg)
-  {
-    auto *my_data = static_cast<thread_data *>(threadarg);
-    ProcessSectorData(my_data);
-    pthread_exit(nullptr);
-  }
 }  // namespace
 
 TpcClusterizer::TpcClusterizer(const std::string &name)
@@ -1182,6 +1186,9 @@ bool TpcClusterizer::is_in_sector_boundary(int phibin, int sector, PHG4TpcGeom *
 
 int TpcClusterizer::InitRun(PHCompositeNode *topNode)
 {
+  // start the shared sector processing workers
+  TrkrThreadPool::instance().reserve_threads(m_num_threads);
+
   PHNodeIterator iter(topNode);
 
   // Looking for the DST node
@@ -1441,27 +1448,10 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       rawhitsetrange = m_rawhits->getHitSets(TrkrDefs::TrkrId::tpcId);
       num_hitsets = std::distance(rawhitsetrange.first, rawhitsetrange.second);
     }
-  // create structure to store given thread and associated data
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  // create vector of thread pairs and reserve the right size upfront to avoid reallocation
-  std::vector<thread_pair_t> threads;
-  threads.reserve(num_hitsets);
-
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    std::cout << std::endl
-              << " mutex init failed" << std::endl;
-    return 1;
-  }
+  // create vector of per-sector task data and reserve the right size upfront to avoid reallocation
+  // each task only writes to its own data, which is merged into the node tree once all tasks are done
+  std::vector<thread_data> tasks;
+  tasks.reserve(num_hitsets);
 //  int count = 0;
 
   if (!do_read_raw)
@@ -1477,40 +1467,40 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
+      // instanciate new task data, at the end of task vector
+      thread_data &data = tasks.emplace_back();
       if (mClusHitsVerbose)
       {
-        thread_pair.data.fillClusHitsVerbose = true;
+        data.fillClusHitsVerbose = true;
       };
 
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = hitset;
-      thread_pair.data.rawhitset = nullptr;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.seed_threshold = seed_threshold;
-      thread_pair.data.edge_threshold = edge_threshold;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.do_singles = do_singles;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.verbosity = Verbosity();
-      thread_pair.data.do_split = do_split;
-      thread_pair.data.FixedWindow = do_fixed_window;
-      thread_pair.data.min_err_squared = min_err_squared;
-      thread_pair.data.min_clus_size = min_clus_size;
-      thread_pair.data.min_adc_sum = min_adc_sum;
+      data.layergeom = layergeom;
+      data.hitset = hitset;
+      data.rawhitset = nullptr;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.seed_threshold = seed_threshold;
+      data.edge_threshold = edge_threshold;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.do_singles = do_singles;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.verbosity = Verbosity();
+      data.do_split = do_split;
+      data.FixedWindow = do_fixed_window;
+      data.min_err_squared = min_err_squared;
+      data.min_clus_size = min_clus_size;
+      data.min_adc_sum = min_adc_sum;
 
       // --- pass dead/hot map info ---
-      thread_pair.data.deadMap  = &m_deadChannelMap;
-      thread_pair.data.hotMap   = &m_hotChannelMap;
-      thread_pair.data.maskDead = m_maskDeadChannels;
-      thread_pair.data.maskHot  = m_maskHotChannels;
+      data.deadMap  = &m_deadChannelMap;
+      data.hotMap   = &m_hotChannelMap;
+      data.maskDead = m_maskDeadChannels;
+      data.maskHot  = m_maskHotChannels;
 
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -1530,72 +1520,17 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
 
       m_tdriftmax = layergeom->get_max_driftlength() / m_tGeometry->get_drift_velocity(); 
       //  std::cout << "     m_tdriftmax " << m_tdriftmax << " drift velocity reco " << m_tGeometry->get_drift_velocity() << std::endl;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
-
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
-
-      thread_pair.data.radius = layergeom->get_radius();
-      thread_pair.data.drift_velocity = m_tGeometry->get_drift_velocity();
-      thread_pair.data.pads_per_sector = 0;
-      thread_pair.data.phistep = 0;
-      int rc;
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto *cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-
-          if (mClusHitsVerbose)
-          {
-            for (const auto &hit : data.phivec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addPhiHit(hit.first, hit.second);
-            }
-            for (const auto &hit : data.zvec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addZHit(hit.first, hit.second);
-            }
-            mClusHitsVerbose->push_hits(ckey);
-          }
-        }
+      data.m_tdriftmax = m_tdriftmax;
 
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
 
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
+      data.radius = layergeom->get_radius();
+      data.drift_velocity = m_tGeometry->get_drift_velocity();
+      data.pads_per_sector = 0;
+      data.phistep = 0;
 //      count++;
     }
   }
@@ -1615,28 +1550,28 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
-
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = nullptr;
-      thread_pair.data.rawhitset = hitset;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.verbosity = Verbosity();
+      // instanciate new task data, at the end of task vector
+      thread_data &data = tasks.emplace_back();
+
+      data.layergeom = layergeom;
+      data.hitset = nullptr;
+      data.rawhitset = hitset;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.verbosity = Verbosity();
 
       // --- pass dead/hot map info ---
-      thread_pair.data.deadMap  = &m_deadChannelMap;
-      thread_pair.data.hotMap   = &m_hotChannelMap;
-      thread_pair.data.maskDead = m_maskDeadChannels;
-      thread_pair.data.maskHot  = m_maskHotChannels;
+      data.deadMap  = &m_deadChannelMap;
+      data.hotMap   = &m_hotChannelMap;
+      data.maskDead = m_maskDeadChannels;
+      data.maskHot  = m_maskHotChannels;
 
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -1648,12 +1583,12 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
 
       m_tdriftmax = layergeom->get_max_driftlength() / m_tGeometry->get_drift_velocity(); 
       //      std::cout << "     m_tdriftmax " << m_tdriftmax << " drift velocity reco " << m_tGeometry->get_drift_velocity() << std::endl;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
+      data.m_tdriftmax = m_tdriftmax;
 
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
       
       /*
       PHG4TpcGeom *testlayergeom = geom_container->GetLayerCellGeom(32);
@@ -1678,118 +1613,65 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       }
       continue;
       */
-      int rc = 0;
-      //      if(layer==32)
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-      //      else
-      // continue;
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto *cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
 //      count++;
     }
   }
 
-  pthread_attr_destroy(&attr);
-//  count = 0;
-  // wait for completion of all threads
-  if (!do_sequential)
-  {
-    for (const auto &thread_pair : threads)
-    {
-      int rc2 = pthread_join(thread_pair.thread, nullptr);
-      if (rc2)
-      {
-        std::cout << "Error:unable to join," << rc2 << std::endl;
-      }
+  // process all sectors on the shared thread pool
+  TrkrThreadPool::instance().parallel_for(
+      tasks.size(), [&tasks](std::size_t index, unsigned int /*worker*/)
+      { ProcessSectorData(&tasks[index]); },
+      do_sequential);
 
-      // get the hitsetkey from thread data
-      const auto &data(thread_pair.data);
-      const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
+  // merge task outputs, in hitset order
+  for (auto &data : tasks)
+  {
+    // get the hitsetkey from thread data
+    const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
 
-      // copy clusters to map
-      for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy clusters to map
+    for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // get cluster
-        auto *cluster = data.cluster_vector[index];
+      // get cluster
+      auto *cluster = data.cluster_vector[index];
 
-        // insert in map
-        // std::cout << "X: " << cluster->getLocalX() << "Y: " << cluster->getLocalY() << std::endl;
-        m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+      // insert in map
+      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
 
-        if (mClusHitsVerbose)
+      if (mClusHitsVerbose && data.fillClusHitsVerbose)
+      {
+        for (const auto &hit : data.phivec_ClusHitsVerbose[index])
         {
-          for (const auto &hit : data.phivec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addPhiHit(hit.first, (double) hit.second);
-          }
-          for (const auto &hit : data.zvec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addZHit(hit.first, (double) hit.second);
-          }
-          mClusHitsVerbose->push_hits(ckey);
+          mClusHitsVerbose->addPhiHit(hit.first, (double) hit.second);
+        }
+        for (const auto &hit : data.zvec_ClusHitsVerbose[index])
+        {
+          mClusHitsVerbose->addZHit(hit.first, (double) hit.second);
         }
+        mClusHitsVerbose->push_hits(ckey);
       }
+    }
 
-      // copy hit associations to map
-      for (const auto &[index, hkey] : thread_pair.data.association_vector)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy hit associations to map
+    for (const auto &[index, hkey] : data.association_vector)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // add to association table
-        m_clusterhitassoc->addAssoc(ckey, hkey);
-      }
+      // add to association table
+      m_clusterhitassoc->addAssoc(ckey, hkey);
+    }
 
-      for (auto *v_hit : thread_pair.data.v_hits)
+    for (auto *v_hit : data.v_hits)
+    {
+      if (_store_hits)
       {
-        if (_store_hits)
-        {
-          m_training->v_hits.emplace_back(*v_hit);
-        }
-        delete v_hit;
+        m_training->v_hits.emplace_back(*v_hit);
       }
+      delete v_hit;
     }
   }
 
@@ -8,6 +8,7 @@
 
 #include <map>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
 typedef std::map<TrkrDefs::hitsetkey, std::unordered_set<TrkrDefs::hitkey>> hitMaskTpcSet;
@@ -42,6 +43,8 @@ public:
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_do_wedge_emulation(bool do_wedge) { do_wedge_emulation = do_wedge; }
   void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
+  /// number of workers in the shared tracking thread pool used to process sectors
+  void set_num_threads(unsigned int nthreads) { m_num_threads = nthreads; }
   void set_do_split(bool split) { do_split = split; }
   void set_fixed_window(int fixed) { do_fixed_window = fixed; }
   void set_pedestal(double val) { pedestal = val; }
@@ -109,6 +112,7 @@ public:
   bool do_wedge_emulation = false;
   bool do_read_raw = false;
   bool do_sequential = false;
+  unsigned int m_num_threads = std::thread::hardware_concurrency();
   bool do_singles = true;
   bool do_split = false;
   bool is_reco = false;
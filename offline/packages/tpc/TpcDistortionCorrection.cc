@@ -8,8 +8,10 @@
 #include "TpcDistortionCorrectionContainer.h"
 
 #include <TH1.h>
-#include <cmath>
 
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <iostream>
 
 namespace
@@ -42,6 +44,135 @@ namespace
     return check_boundaries(h->GetXaxis(), r) && check_boundaries(h->GetYaxis(), phi);
   }
 
+  using Grid = TpcDistortionCorrectionContainer::Grid;
+
+  // find lower interpolation bin (zero-based) and fraction along a grid axis
+  /* same bin finding and boundary check as for histograms, and same interpolation points as TH3::Interpolate */
+  inline bool locate(const Grid& grid, int axis, double value, int& lower, double& fraction)
+  {
+    const int nbins = grid.nbins[axis];
+    const double xmin = grid.min[axis];
+    const double xmax = grid.max[axis];
+    if (!(value >= xmin && value < xmax))
+    {
+      return false;
+    }
+
+    // same as TAxis::FindFixBin
+    int bin = 1 + int(nbins * (value - xmin) / (xmax - xmin));
+    if (bin < 2 || bin >= nbins)
+    {
+      return false;
+    }
+
+    // same as TAxis::GetBinCenter
+    const double width = (xmax - xmin) / nbins;
+    if (value < xmin + (bin - 1) * width + 0.5 * width)
+    {
+      --bin;
+    }
+    const double lower_center = xmin + (bin - 1) * width + 0.5 * width;
+    const double upper_center = xmin + bin * width + 0.5 * width;
+    fraction = (value - lower_center) / (upper_center - lower_center);
+    lower = bin - 1;
+    return true;
+  }
+
+  // interpolate dphi, dr and dz from grid. Returns false if point is outside of the grid boundaries
+  inline bool interpolate(const Grid& grid, int dimensions, double phi, double r, double z, std::array<double, 3>& delta)
+  {
+    int iphi = 0;
+    int ir = 0;
+    int iz = 0;
+    double fphi = 0;
+    double fr = 0;
+    double fz = 0;
+    if (!locate(grid, 0, phi, iphi, fphi) || !locate(grid, 1, r, ir, fr) ||
+        (dimensions == 3 && !locate(grid, 2, z, iz, fz)))
+    {
+      return false;
+    }
+
+    // offsets to the next bin along each axis
+    const std::size_t nz = grid.nbins[2];
+    const std::size_t step_z = (dimensions == 3) ? 3 : 0;
+    const std::size_t step_r = 3 * nz;
+    const std::size_t step_phi = step_r * grid.nbins[1];
+    const float* v = &grid.values[(iphi * grid.nbins[1] + ir) * step_r + iz * 3];
+
+    // same interpolation order as TH3::Interpolate
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      const double i1 = v[i] * (1 - fz) + v[i + step_z] * fz;
+      const double i2 = v[i + step_r] * (1 - fz) + v[i + step_r + step_z] * fz;
+      const double j1 = v[i + step_phi] * (1 - fz) + v[i + step_phi + step_z] * fz;
+      const double j2 = v[i + step_phi + step_r] * (1 - fz) + v[i + step_phi + step_r + step_z] * fz;
+      const double w1 = i1 * (1 - fr) + i2 * fr;
+      const double w2 = j1 * (1 - fr) + j2 * fr;
+      delta[i] = w1 * (1 - fphi) + w2 * fphi;
+    }
+    return true;
+  }
+
+  // interpolate a histogram, if present and within boundaries
+  inline double interpolate(const TH1* h, int dimensions, double phi, double r, double z)
+  {
+    if (!h)
+    {
+      return 0;
+    }
+
+    if (dimensions == 3)
+    {
+      return check_boundaries(h, phi, r, z) ? h->Interpolate(phi, r, z) : 0;
+    }
+    else if (dimensions == 2)
+    {
+      return check_boundaries(h, phi, r) ? h->Interpolate(phi, r) : 0;
+    }
+    return 0;
+  }
+
+  // interpolate dphi, dr and dz from histograms, for coordinates in mask
+  inline std::array<double, 3> interpolate(const TpcDistortionCorrectionContainer* dcc, int index, double phi, double r, double z, unsigned int mask)
+  {
+    std::array<double, 3> delta = {{0, 0, 0}};
+    if (mask & TpcDistortionCorrection::COORD_PHI)
+    {
+      delta[0] = interpolate(dcc->m_hDPint[index], dcc->m_dimensions, phi, r, z);
+    }
+    if (mask & TpcDistortionCorrection::COORD_R)
+    {
+      delta[1] = interpolate(dcc->m_hDRint[index], dcc->m_dimensions, phi, r, z);
+    }
+    if (mask & TpcDistortionCorrection::COORD_Z)
+    {
+      delta[2] = interpolate(dcc->m_hDZint[index], dcc->m_dimensions, phi, r, z);
+    }
+    return delta;
+  }
+
+  // compare grid to histogram corrections, and print the first differences found
+  void validate(const TpcDistortionCorrectionContainer* dcc, int index, double phi, double r, double z, unsigned int mask, const std::array<double, 3>& delta)
+  {
+    // grid values are stored as float
+    static constexpr double tolerance = 1e-5;
+    static constexpr unsigned int max_warnings = 10;
+    static std::atomic<unsigned int> warnings(0);
+
+    const auto reference = interpolate(dcc, index, phi, r, z, mask);
+    for (int i = 0; i < 3; ++i)
+    {
+      if (std::abs(delta[i] - reference[i]) > tolerance * (1 + std::abs(reference[i])) && warnings++ < max_warnings)
+      {
+        std::cout << "TpcDistortionCorrection::get_corrected_position - grid mismatch."
+                  << " phi: " << phi << " r: " << r << " z: " << z
+                  << " coordinate: " << i << " grid: " << delta[i] << " histogram: " << reference[i]
+                  << std::endl;
+      }
+    }
+  }
+
 }  // namespace
 
 //________________________________________________________
@@ -72,54 +203,51 @@ Acts::Vector3 TpcDistortionCorrection::get_corrected_position(const Acts::Vector
     divisor = 1.0;
   }
 
-  //set our default corrections to be zero:
-  //first inherit the same type
-  auto dphi=phi;
-  auto dr=r;
-  auto dz=z;
-  //then set them to zero:
-  dphi=0;
-  dr=0;
-  dz=0;
-  
-  //get the corrections from the histograms
-  if (dcc->m_dimensions == 3)
+  // get the corrections, from the grid if available, from the histograms otherwise
+  std::array<double, 3> delta = {{0, 0, 0}};
+  const auto& grid = dcc->m_grid[index];
+  if (dcc->m_use_grid && grid.valid())
   {
-    if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r, z))
+    if (interpolate(grid, dcc->m_dimensions, phi, r, z, delta))
     {
-      dphi=dcc->m_hDPint[index]->Interpolate(phi, r, z) / divisor;
+      if (!(mask & COORD_PHI))
+      {
+        delta[0] = 0;
+      }
+      if (!(mask & COORD_R))
+      {
+        delta[1] = 0;
+      }
+      if (!(mask & COORD_Z))
+      {
+        delta[2] = 0;
+      }
     }
-    if (dcc->m_hDRint[index] && (mask & COORD_R) && check_boundaries(dcc->m_hDRint[index], phi, r, z))
-    {
-      dr=dcc->m_hDRint[index]->Interpolate(phi, r, z);
-    }
-    if (dcc->m_hDZint[index] && (mask & COORD_Z) && check_boundaries(dcc->m_hDZint[index], phi, r, z))
+
+    if (dcc->m_validate_grid)
     {
-      dz=dcc->m_hDZint[index]->Interpolate(phi, r, z);
+      validate(dcc, index, phi, r, z, mask, delta);
     }
   }
-  else if (dcc->m_dimensions == 2)
+  else
   {
-    double zterm = 1.0;
+    delta = interpolate(dcc, index, phi, r, z, mask);
+  }
 
-    if (dcc->m_interpolate_z){
-      zterm=(1. - std::abs(z) / 102.605);
-    }
-    if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r))
-    {
-      dphi=dcc->m_hDPint[index]->Interpolate(phi, r) * zterm / divisor;
-    }
-    if (dcc->m_hDRint[index] && (mask & COORD_R) && check_boundaries(dcc->m_hDRint[index], phi, r))
-    {
-      dr=dcc->m_hDRint[index]->Interpolate(phi, r) * zterm;
-    }
-    if (dcc->m_hDZint[index] && (mask & COORD_Z) && check_boundaries(dcc->m_hDZint[index], phi, r))
+  if (dcc->m_dimensions == 2 && dcc->m_interpolate_z)
+  {
+    const double zterm = (1. - std::abs(z) / 102.605);
+    for (auto& d : delta)
     {
-      dz=dcc->m_hDZint[index]->Interpolate(phi, r) * zterm;
+      d *= zterm;
     }
-    
   }
 
+  // no division for missing corrections, to avoid nan at r = 0
+  auto dphi = (delta[0] == 0) ? 0 : delta[0] / divisor;
+  auto dr = delta[1];
+  auto dz = delta[2];
+
 //if we are scaling, apply the scale factor to each correction
 if(dcc->m_use_scalefactor)
   {
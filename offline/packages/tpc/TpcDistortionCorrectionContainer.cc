@@ -0,0 +1,86 @@
+/*!
+ * \file TpcDistortionCorrectionContainer.cc
+ * \brief stores distortion correction histograms on the node tree
+ * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
+ */
+
+#include "TpcDistortionCorrectionContainer.h"
+
+#include <TAxis.h>
+#include <TH1.h>
+
+namespace
+{
+  // true if axes have the same fixed size binning
+  bool same_binning(const TAxis* first, const TAxis* second)
+  {
+    return !first->IsVariableBinSize() && !second->IsVariableBinSize() &&
+           first->GetNbins() == second->GetNbins() &&
+           first->GetXmin() == second->GetXmin() &&
+           first->GetXmax() == second->GetXmax();
+  }
+
+  // true if histograms have the same fixed size binning on the relevant axes
+  bool same_binning(const TH1* first, const TH1* second, int dimensions)
+  {
+    return same_binning(first->GetXaxis(), second->GetXaxis()) &&
+           same_binning(first->GetYaxis(), second->GetYaxis()) &&
+           (dimensions == 2 || same_binning(first->GetZaxis(), second->GetZaxis()));
+  }
+}  // namespace
+
+//________________________________________________________
+void TpcDistortionCorrectionContainer::build_grids()
+{
+  for (int index = 0; index < 2; ++index)
+  {
+    auto& grid = m_grid[index];
+    grid = Grid();
+
+    const std::array<const TH1*, 3> histograms = {{m_hDPint[index], m_hDRint[index], m_hDZint[index]}};
+    if (!histograms[0] || !histograms[1] || !histograms[2])
+    {
+      continue;
+    }
+
+    if (!(m_dimensions == 2 || m_dimensions == 3) ||
+        !same_binning(histograms[0], histograms[0], m_dimensions) ||
+        !same_binning(histograms[0], histograms[1], m_dimensions) ||
+        !same_binning(histograms[0], histograms[2], m_dimensions))
+    {
+      continue;
+    }
+
+    // axes: phi, r and z
+    const std::array<const TAxis*, 3> axes = {{histograms[0]->GetXaxis(), histograms[0]->GetYaxis(), histograms[0]->GetZaxis()}};
+    for (int i = 0; i < 3; ++i)
+    {
+      if (i < m_dimensions)
+      {
+        grid.nbins[i] = axes[i]->GetNbins();
+        grid.min[i] = axes[i]->GetXmin();
+        grid.max[i] = axes[i]->GetXmax();
+      }
+      else
+      {
+        grid.nbins[i] = 1;
+      }
+    }
+
+    grid.values.resize(3UL * grid.nbins[0] * grid.nbins[1] * grid.nbins[2]);
+    auto value = grid.values.begin();
+    for (int iphi = 0; iphi < grid.nbins[0]; ++iphi)
+    {
+      for (int ir = 0; ir < grid.nbins[1]; ++ir)
+      {
+        for (int iz = 0; iz < grid.nbins[2]; ++iz)
+        {
+          for (const auto& h : histograms)
+          {
+            *(value++) = (m_dimensions == 3) ? h->GetBinContent(iphi + 1, ir + 1, iz + 1) : h->GetBinContent(iphi + 1, ir + 1);
+          }
+        }
+      }
+    }
+  }
+}
@@ -8,6 +8,7 @@
  */
 
 #include <array>
+#include <vector>
 
 class TH1;
 
@@ -41,6 +42,39 @@ class TpcDistortionCorrectionContainer
    */
   std::array<TH1*, 2> m_hentries = {{nullptr, nullptr}};
   //@}
+
+  //! correction values from the three histograms of one side, packed on a regular grid
+  struct Grid
+  {
+    //! number of bins, axis lower and upper edges along phi, r and z. For 2D corrections there is one bin in z
+    std::array<int, 3> nbins = {{0, 0, 0}};
+    std::array<double, 3> min = {{0, 0, 0}};
+    std::array<double, 3> max = {{0, 0, 0}};
+
+    //! interleaved (dphi, dr, dz) at bin centers, phi major, z minor
+    std::vector<float> values;
+
+    //! true if grid is filled
+    bool valid() const { return !values.empty(); }
+  };
+
+  //!@name packed correction grids, filled from the histograms by build_grids
+  //@{
+  std::array<Grid, 2> m_grid;
+
+  //! use grids rather than histograms when available
+  bool m_use_grid = true;
+
+  //! compare grid to histogram corrections for each lookup, and report differences
+  bool m_validate_grid = false;
+  //@}
+
+  //! fill grids from histograms. Must be called again whenever the histograms are modified
+  /*!
+   * grids are left empty, and histograms are used, when any of the three histograms is missing,
+   * has variable bin size, or when their binning differ
+   */
+  void build_grids();
 };
 
 #endif
@@ -118,6 +118,16 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
     distortion_correction_object->m_use_scalefactor = m_use_scalefactor[i];
     distortion_correction_object->m_scalefactor = m_scalefactor[i];
 
+    // pack histograms on regular grids for faster lookup
+    distortion_correction_object->m_use_grid = m_use_grid;
+    distortion_correction_object->m_validate_grid = m_validate_grid;
+    distortion_correction_object->build_grids();
+    if (Verbosity())
+    {
+      std::cout << "TpcLoadDistortionCorrection::InitRun - grids: "
+                << distortion_correction_object->m_grid[0].valid() << ", "
+                << distortion_correction_object->m_grid[1].valid() << std::endl;
+    }
 
     if (Verbosity())
     {
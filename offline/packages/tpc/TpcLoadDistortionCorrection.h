@@ -75,6 +75,18 @@ class TpcLoadDistortionCorrection : public SubsysReco
     m_interpolate_z[i] = flag;
   }
 
+  //! use regular grids built from the histograms rather than histogram interpolation, when binning allows
+  void set_use_grid(bool flag)
+  {
+    m_use_grid = flag;
+  }
+
+  //! compare grid to histogram corrections for each lookup, and report differences
+  void set_validate_grid(bool flag)
+  {
+    m_validate_grid = flag;
+  }
+
   //! node name
   void set_node_name(const std::string& value)
   {
@@ -105,6 +117,12 @@ class TpcLoadDistortionCorrection : public SubsysReco
   //! z interpolation
   std::array<bool,nDistortionTypes> m_interpolate_z = {true,true,true,true};
 
+  //! grid lookup
+  bool m_use_grid = true;
+
+  //! grid validation
+  bool m_validate_grid = false;
+
   //! distortion object node name
   std::array<std::string,nDistortionTypes> m_node_name = {"TpcDistortionCorrectionContainerStatic", "TpcDistortionCorrectionContainerAverage", "TpcDistortionCorrectionContainerFluctuation","TpcDistortionCorrectionContainerModuleEdge"};
 };
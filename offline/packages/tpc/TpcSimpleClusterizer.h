@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 class PHCompositeNode;
@@ -34,6 +35,7 @@ class TpcSimpleClusterizer : public SubsysReco
 
   void set_sector_fiducial_cut(const double cut) { SectorFiducialCut = cut; }
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
+  void set_num_threads(unsigned int nthreads) { m_num_threads = nthreads; }
 
  private:
   bool is_in_sector_boundary(int phibin, int sector, PHG4TpcGeom *layergeom) const;
@@ -44,6 +46,7 @@ class TpcSimpleClusterizer : public SubsysReco
   ActsGeometry *m_tGeometry = nullptr;
 
   bool do_hit_assoc = true;
+  unsigned int m_num_threads = std::thread::hardware_concurrency();
   double pedestal = 74.4;
   double SectorFiducialCut = 0.5;
 
@@ -0,0 +1,124 @@
+#include "TrkrClusterLabeling.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+namespace
+{
+  //! minimal union-find, with path halving. The smallest index is kept as root
+  class union_find
+  {
+   public:
+    explicit union_find(std::size_t size)
+      : m_parent(size)
+    {
+      std::iota(m_parent.begin(), m_parent.end(), 0);
+    }
+
+    int find(int i)
+    {
+      while (m_parent[i] != i)
+      {
+        m_parent[i] = m_parent[m_parent[i]];
+        i = m_parent[i];
+      }
+      return i;
+    }
+
+    void merge(int i, int j)
+    {
+      i = find(i);
+      j = find(j);
+      if (i < j)
+      {
+        m_parent[j] = i;
+      }
+      else if (j < i)
+      {
+        m_parent[i] = j;
+      }
+    }
+
+   private:
+    std::vector<int> m_parent;
+  };
+}  // namespace
+
+int TrkrClusterLabeling::label_connected_hits(const std::vector<coordinate_t>& coordinates, bool diagonal, std::vector<int>& component)
+{
+  const int nhits = coordinates.size();
+  component.assign(nhits, -1);
+  if (nhits == 0)
+  {
+    return 0;
+  }
+
+  // sort hit indices by coordinates. Hits from hitsets are usually already sorted
+  std::vector<int> order(nhits);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&coordinates](int lhs, int rhs)
+            { return coordinates[lhs] < coordinates[rhs]; });
+
+  union_find sets(nhits);
+
+  // previous and current groups of hits with same first coordinate, as [begin,end) in order
+  int previous_begin = 0;
+  int previous_end = 0;
+  int current_begin = 0;
+  while (current_begin < nhits)
+  {
+    const int first = coordinates[order[current_begin]].first;
+    int current_end = current_begin + 1;
+    while (current_end < nhits && coordinates[order[current_end]].first == first)
+    {
+      ++current_end;
+    }
+
+    // same first coordinate: consecutive hits in sorted order are the only candidates
+    for (int i = current_begin + 1; i < current_end; ++i)
+    {
+      if (coordinates[order[i]].second - coordinates[order[i - 1]].second <= 1)
+      {
+        sets.merge(order[i], order[i - 1]);
+      }
+    }
+
+    // neighboring first coordinate: sweep both sorted groups
+    if (diagonal && previous_end > previous_begin && coordinates[order[previous_begin]].first == first - 1)
+    {
+      int j = previous_begin;
+      for (int i = current_begin; i < current_end; ++i)
+      {
+        const int second = coordinates[order[i]].second;
+        while (j < previous_end && coordinates[order[j]].second < second - 1)
+        {
+          ++j;
+        }
+        for (int k = j; k < previous_end && coordinates[order[k]].second <= second + 1; ++k)
+        {
+          sets.merge(order[i], order[k]);
+        }
+      }
+    }
+
+    previous_begin = current_begin;
+    previous_end = current_end;
+    current_begin = current_end;
+  }
+
+  // assign labels by order of first appearance
+  std::vector<int> root_label(nhits, -1);
+  int nlabels = 0;
+  for (int i = 0; i < nhits; ++i)
+  {
+    auto& label = root_label[sets.find(i)];
+    if (label < 0)
+    {
+      label = nlabels++;
+    }
+    component[i] = label;
+  }
+
+  return nlabels;
+}
@@ -0,0 +1,31 @@
+#ifndef TRACKBASE_TRKRCLUSTERLABELING_H
+#define TRACKBASE_TRKRCLUSTERLABELING_H
+
+/**
+ * @file trackbase/TrkrClusterLabeling.h
+ * @brief connected component labeling of pixel and strip hits
+ */
+
+#include <utility>
+#include <vector>
+
+namespace TrkrClusterLabeling
+{
+  /// hit coordinates on a 2D grid. first is the "slow" (e.g. column) index, second the "fast" (e.g. row) index
+  using coordinate_t = std::pair<int, int>;
+
+  /**
+   * label connected groups of hits, in O(n log n) for sorting plus a linear union-find sweep.
+   * Two hits are adjacent if their second coordinates differ by at most one, and
+   * - their first coordinates are identical, if diagonal is false
+   * - their first coordinates differ by at most one, if diagonal is true
+   *
+   * component[i] receives the label of hit i. Labels are numbered from zero in order of
+   * first appearance in the input, which matches boost::connected_components on an
+   * adjacency graph whose vertices are the hits in input order.
+   * Returns the number of components.
+   */
+  int label_connected_hits(const std::vector<coordinate_t>& coordinates, bool diagonal, std::vector<int>& component);
+}  // namespace TrkrClusterLabeling
+
+#endif
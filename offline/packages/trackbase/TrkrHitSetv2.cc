@@ -0,0 +1,254 @@
+/**
+ * @file trackbase/TrkrHitSetv2.cc
+ * @brief Implementation of TrkrHitSetv2
+ */
+#include "TrkrHitSetv2.h"
+#include "TrkrHitv2.h"
+
+#include <TBuffer.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <utility>  // for pair
+
+namespace
+{
+  // clamp adc to storage range, consistently with TrkrHitv2::setAdc
+  unsigned short to_adc(unsigned int adc)
+  {
+    return adc > USHRT_MAX ? USHRT_MAX : static_cast<unsigned short>(adc);
+  }
+}  // namespace
+
+void TrkrHitSetv2::Streamer(TBuffer& buffer)
+{
+  if (buffer.IsReading())
+  {
+    clear_map();
+    buffer.ReadClassBuffer(TrkrHitSetv2::Class(), this);
+  }
+  else if (m_hits.empty())
+  {
+    buffer.WriteClassBuffer(TrkrHitSetv2::Class(), this);
+  }
+  else
+  {
+    // write the legacy map as sorted flat arrays, the map stays in use
+    m_keys.reserve(m_hits.size());
+    m_adcs.reserve(m_hits.size());
+    for (const auto& [key, hit] : m_hits)
+    {
+      m_keys.push_back(key);
+      m_adcs.push_back(to_adc(hit->getAdc()));
+    }
+    buffer.WriteClassBuffer(TrkrHitSetv2::Class(), this);
+    m_keys.clear();
+    m_adcs.clear();
+  }
+}
+
+void TrkrHitSetv2::Reset()
+{
+  m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+  clear_map();
+
+  // clear, but keep capacity for reuse in TClonesArray based containers
+  m_keys.clear();
+  m_adcs.clear();
+}
+
+void TrkrHitSetv2::identify(std::ostream& os) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(m_hitSetKey);
+  const unsigned int trkrid = TrkrDefs::getTrkrId(m_hitSetKey);
+  os
+      << "TrkrHitSetv2: "
+      << "       hitsetkey " << getHitSetKey()
+      << " TrkrId " << trkrid
+      << " layer " << layer
+      << " nhits: " << size()
+      << std::endl;
+
+  forEachHit([&os](TrkrDefs::hitkey key, unsigned int adc)
+             { os << " hitkey " << key << " adc " << adc << std::endl; });
+}
+
+void TrkrHitSetv2::reserve(std::size_t n)
+{
+  m_keys.reserve(n);
+  m_adcs.reserve(n);
+}
+
+void TrkrHitSetv2::appendHit(TrkrDefs::hitkey key, unsigned short adc)
+{
+  if (!m_hits.empty())
+  {
+    auto* hit = new TrkrHitv2;
+    hit->setAdc(adc);
+    if (!m_hits.insert(std::make_pair(key, hit)).second)
+    {
+      std::cout << "TrkrHitSetv2::appendHit - duplicate key: " << key << " in hitset " << m_hitSetKey << ", ignored" << std::endl;
+      delete hit;
+    }
+    return;
+  }
+
+  if (m_keys.empty() || key > m_keys.back())
+  {
+    m_keys.push_back(key);
+    m_adcs.push_back(adc);
+    return;
+  }
+
+  // out of order, insert at the sorted position
+  const auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+  if (*iter == key)
+  {
+    std::cout << "TrkrHitSetv2::appendHit - duplicate key: " << key << " in hitset " << m_hitSetKey << ", ignored" << std::endl;
+    return;
+  }
+  const auto index = std::distance(m_keys.begin(), iter);
+  m_keys.insert(iter, key);
+  m_adcs.insert(m_adcs.begin() + index, adc);
+}
+
+TrkrHitSetv2::ConstIterator
+TrkrHitSetv2::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  make_map();
+  const auto ret = m_hits.insert(std::make_pair(key, hit));
+  if (!ret.second)
+  {
+    std::cout << "TrkrHitSetv2::AddHitSpecificKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+  return ret.first;
+}
+
+void TrkrHitSetv2::removeHit(TrkrDefs::hitkey key)
+{
+  if (!m_hits.empty())
+  {
+    const auto iter = m_hits.find(key);
+    if (iter != m_hits.end())
+    {
+      delete iter->second;
+      m_hits.erase(iter);
+      return;
+    }
+  }
+  else if (const auto index = find(key); index != m_keys.size())
+  {
+    m_keys.erase(m_keys.begin() + index);
+    m_adcs.erase(m_adcs.begin() + index);
+    return;
+  }
+
+  identify();
+  std::cout << "TrkrHitSetv2::removeHit: deleting a nonexist key: " << key << " exiting now" << std::endl;
+  exit(1);
+}
+
+bool TrkrHitSetv2::setHitAdc(TrkrDefs::hitkey key, unsigned short adc)
+{
+  if (!m_hits.empty())
+  {
+    const auto iter = m_hits.find(key);
+    if (iter == m_hits.end())
+    {
+      return false;
+    }
+    iter->second->setAdc(adc);
+    return true;
+  }
+
+  const auto index = find(key);
+  if (index == m_keys.size())
+  {
+    return false;
+  }
+  m_adcs[index] = adc;
+  return true;
+}
+
+bool TrkrHitSetv2::getHitAdc(TrkrDefs::hitkey key, unsigned int& adc) const
+{
+  if (!m_hits.empty())
+  {
+    const auto iter = m_hits.find(key);
+    if (iter == m_hits.end())
+    {
+      return false;
+    }
+    adc = iter->second->getAdc();
+    return true;
+  }
+
+  const auto index = find(key);
+  if (index == m_keys.size())
+  {
+    return false;
+  }
+  adc = m_adcs[index];
+  return true;
+}
+
+TrkrHit*
+TrkrHitSetv2::getHit(const TrkrDefs::hitkey key) const
+{
+  // no need to create hit objects for a missing key
+  if (m_hits.empty() && find(key) == m_keys.size())
+  {
+    return nullptr;
+  }
+
+  make_map();
+  const auto iter = m_hits.find(key);
+  return iter == m_hits.end() ? nullptr : iter->second;
+}
+
+TrkrHitSetv2::ConstRange
+TrkrHitSetv2::getHits() const
+{
+  make_map();
+  return std::make_pair(m_hits.cbegin(), m_hits.cend());
+}
+
+void TrkrHitSetv2::make_map() const
+{
+  if (m_keys.empty())
+  {
+    return;
+  }
+
+  // keys are sorted, inserting at the end is constant time
+  for (std::size_t i = 0; i < m_keys.size(); ++i)
+  {
+    auto* hit = new TrkrHitv2;
+    hit->setAdc(m_adcs[i]);
+    m_hits.emplace_hint(m_hits.end(), m_keys[i], hit);
+  }
+  m_keys.clear();
+  m_adcs.clear();
+}
+
+std::size_t TrkrHitSetv2::find(TrkrDefs::hitkey key) const
+{
+  const auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+  if (iter == m_keys.end() || *iter != key)
+  {
+    return m_keys.size();
+  }
+  return std::distance(m_keys.begin(), iter);
+}
+
+void TrkrHitSetv2::clear_map()
+{
+  for (auto&& [key, hit] : m_hits)
+  {
+    delete hit;
+  }
+  m_hits.clear();
+}
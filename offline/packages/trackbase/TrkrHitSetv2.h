@@ -0,0 +1,141 @@
+#ifndef TRACKBASE_TRKRHITSETV2_H
+#define TRACKBASE_TRKRHITSETV2_H
+
+/**
+ * @file trackbase/TrkrHitSetv2.h
+ * @brief Flat container for storing TrkrHit's
+ */
+#include "TrkrDefs.h"
+#include "TrkrHit.h"
+#include "TrkrHitSet.h"
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief Flat storage for TrkrHit's
+ *
+ * Hits are written to the DST as two parallel contiguous arrays, sorted hit keys and adc values,
+ * instead of one heap allocated TrkrHit per map node as in TrkrHitSetv1.
+ *
+ * In memory the hits are held in one of two ways:
+ * - flat: sorted key and adc arrays. This is how hits are read back from a DST,
+ *   and how appendHit(key, adc) fills the hitset. appendHit is cheapest in increasing key order.
+ * - legacy: a map of owned TrkrHit's, as in TrkrHitSetv1. addHitSpecificKey switches to it,
+ *   so hits keep the TrkrHitSet ownership contract: the passed hit is the stored hit,
+ *   it can be updated through the caller's pointer and is deleted by removeHit or Reset.
+ *   getHit and getHits on a flat hitset switch to it too, creating the TrkrHitv2 objects once.
+ *   Hit pointers stay valid until the hit is removed or the hitset is Reset.
+ *
+ * forEachHit(function) and getHitAdc(key, adc) read either way without creating TrkrHit objects.
+ * The legacy map is copied to the flat arrays when the hitset is written out.
+ * As with TrkrHitSetv1, adding the same key twice through addHitSpecificKey is fatal.
+ * A hitset must not be accessed from several threads while switching to the legacy map.
+ */
+class TrkrHitSetv2 final : public TrkrHitSet
+{
+ public:
+  using KeyVector = std::vector<TrkrDefs::hitkey>;
+  using AdcVector = std::vector<unsigned short>;
+
+  TrkrHitSetv2() = default;
+
+  ~TrkrHitSetv2() override
+  {
+    TrkrHitSetv2::Reset();
+  }
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  //! For ROOT TClonesArray end of event Operation
+  void Clear(Option_t* /*option*/ = "") override { Reset(); }
+
+  void Reset() override;
+
+  void setHitSetKey(const TrkrDefs::hitsetkey key) override
+  {
+    m_hitSetKey = key;
+  }
+
+  TrkrDefs::hitsetkey getHitSetKey() const override
+  {
+    return m_hitSetKey;
+  }
+
+  ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
+
+  void removeHit(TrkrDefs::hitkey) override;
+
+  TrkrHit* getHit(const TrkrDefs::hitkey) const override;
+
+  ConstRange getHits() const override;
+
+  unsigned int size() const override
+  {
+    return m_hits.empty() ? m_keys.size() : m_hits.size();
+  }
+
+  //!@name flat storage interface
+  //@{
+
+  //! reserve flat storage for a given number of hits
+  void reserve(std::size_t);
+
+  //! add a hit from its key and adc. The first of duplicated keys is kept
+  void appendHit(TrkrDefs::hitkey, unsigned short adc);
+
+  //! set adc value for a given key. Returns false if the key is not found
+  bool setHitAdc(TrkrDefs::hitkey, unsigned short adc);
+
+  //! adc value for a given key. Returns false if the key is not found
+  bool getHitAdc(TrkrDefs::hitkey, unsigned int& adc) const;
+
+  //! call function(hitkey, adc) for all hits, in increasing key order
+  template <class Function>
+  void forEachHit(Function&& function) const
+  {
+    if (m_hits.empty())
+    {
+      for (std::size_t i = 0; i < m_keys.size(); ++i)
+      {
+        function(m_keys[i], static_cast<unsigned int>(m_adcs[i]));
+      }
+    }
+    else
+    {
+      for (const auto& [key, hit] : m_hits)
+      {
+        function(key, hit->getAdc());
+      }
+    }
+  }
+
+  //@}
+
+ private:
+  //! move flat storage to the legacy map
+  void make_map() const;
+
+  //! index of a given key in flat storage, m_keys.size() if not found
+  std::size_t find(TrkrDefs::hitkey) const;
+
+  //! delete the hits of the legacy map
+  void clear_map();
+
+  /// unique key for this object
+  TrkrDefs::hitsetkey m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  /// sorted hit keys, empty when the legacy map is used. Filled from the map when writing
+  mutable KeyVector m_keys;
+
+  /// adc values, parallel to m_keys
+  mutable AdcVector m_adcs;
+
+  /// legacy storage, owned hits. Empty when flat storage is used
+  mutable Map m_hits;  //!
+
+  ClassDefOverride(TrkrHitSetv2, 2);
+};
+
+#endif  // TRACKBASE_TRKRHITSETV2_H
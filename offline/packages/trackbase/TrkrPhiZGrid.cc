@@ -0,0 +1,91 @@
+#include "TrkrPhiZGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // maximum number of bins per cluster, and per axis
+  constexpr std::size_t max_bins_per_cluster = 4;
+  constexpr unsigned int max_bins_per_axis = 4096;
+
+  unsigned int nbins(float range, float bin_size)
+  {
+    if (bin_size <= 0)
+    {
+      return max_bins_per_axis;
+    }
+    return std::clamp<float>(std::ceil(range / bin_size), 1, max_bins_per_axis);
+  }
+}  // namespace
+
+//_________________________________________________________________
+void TrkrPhiZGrid::clear()
+{
+  m_added.clear();
+  m_entries.clear();
+  m_offsets.assign(2, 0);
+  m_nphi = 1;
+  m_nz = 1;
+}
+
+//_________________________________________________________________
+void TrkrPhiZGrid::build()
+{
+  m_entries.clear();
+  if (m_added.empty())
+  {
+    m_offsets.assign(2, 0);
+    m_nphi = 1;
+    m_nz = 1;
+    return;
+  }
+
+  // z range from the clusters
+  const auto [zmin, zmax] = std::minmax_element(m_added.begin(), m_added.end(),
+                                                [](const Entry& first, const Entry& second)
+                                                { return first.z < second.z; });
+  m_zmin = zmin->z;
+  m_zmax = zmax->z;
+
+  // bin counts, coarsened together when there are too many bins for the clusters
+  m_nphi = nbins(2 * M_PI, m_phi_bin_size);
+  m_nz = nbins(m_zmax - m_zmin, m_z_bin_size);
+  const std::size_t max_bins = max_bins_per_cluster * m_added.size() + 16;
+  if (static_cast<std::size_t>(m_nphi) * m_nz > max_bins)
+  {
+    const double scale = std::sqrt(static_cast<double>(m_nphi) * m_nz / max_bins);
+    m_nphi = std::max(1U, static_cast<unsigned int>(m_nphi / scale));
+    m_nz = std::max(1U, static_cast<unsigned int>(m_nz / scale));
+  }
+  m_phi_scale = m_nphi / (2 * M_PI);
+  m_z_scale = m_zmax > m_zmin ? m_nz / (m_zmax - m_zmin) : 0;
+
+  // counting sort, stable so that clusters stay in add() order within a bin
+  m_offsets.assign(static_cast<std::size_t>(m_nphi) * m_nz + 1, 0);
+  m_bins.resize(m_added.size());
+  for (std::size_t i = 0; i < m_added.size(); ++i)
+  {
+    const auto bin = phi_bin(m_added[i].phi) * m_nz + z_bin(m_added[i].z);
+    m_bins[i] = bin;
+    ++m_offsets[bin + 1];
+  }
+  for (std::size_t bin = 1; bin < m_offsets.size(); ++bin)
+  {
+    m_offsets[bin] += m_offsets[bin - 1];
+  }
+
+  // place the clusters, advancing the start of their bin
+  m_entries.resize(m_added.size());
+  for (std::size_t i = 0; i < m_added.size(); ++i)
+  {
+    m_entries[m_offsets[m_bins[i]]++] = m_added[i];
+  }
+
+  // placing the entries advanced every offset to the start of the next bin, shift them back
+  for (std::size_t bin = m_offsets.size() - 1; bin > 0; --bin)
+  {
+    m_offsets[bin] = m_offsets[bin - 1];
+  }
+  m_offsets[0] = 0;
+}
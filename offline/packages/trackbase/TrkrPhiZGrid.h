@@ -0,0 +1,171 @@
+#ifndef TRACKBASE_TRKRPHIZGRID_H
+#define TRACKBASE_TRKRPHIZGRID_H
+
+#include "TrkrDefs.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Binned (phi, z) index of the clusters of one layer, for window searches.
+ *
+ * Clusters are added with add() and binned with build(), which sorts them into
+ * a regular phi x z grid with one contiguous array per bin (counting sort,
+ * clusters keep their insertion order within a bin). query() visits the bins
+ * overlapping a (phi, z) window and reports the clusters inside it, boundaries
+ * included, which is the same selection as a boost rtree intersects query on
+ * a box with float coordinates. Windows extending below 0 or above 2 pi are
+ * wrapped around, like the seeders do with their rtrees. Results come in bin
+ * order, not in rtree order.
+ *
+ * Bin sizes should be of the order of the query window. The number of bins is
+ * limited to a few times the number of clusters, so that sparse layers do not
+ * pay for empty bins. Buffers are kept between events.
+ * query() is const and can be called from several threads once build() is done.
+ */
+class TrkrPhiZGrid
+{
+ public:
+  struct Entry
+  {
+    float phi = 0;
+    float z = 0;
+    TrkrDefs::cluskey key = 0;
+    /// position of the cluster in the add() sequence
+    uint32_t index = 0;
+  };
+
+  TrkrPhiZGrid() = default;
+
+  /// bin size in phi (rad) and z (cm). Non positive sizes use as many bins as the cluster count allows
+  TrkrPhiZGrid(float phi_bin_size, float z_bin_size)
+    : m_phi_bin_size(phi_bin_size)
+    , m_z_bin_size(z_bin_size)
+  {
+  }
+
+  void set_bin_size(float phi_bin_size, float z_bin_size)
+  {
+    m_phi_bin_size = phi_bin_size;
+    m_z_bin_size = z_bin_size;
+  }
+
+  /// remove all clusters, keep the buffers
+  void clear();
+
+  /// add a cluster at phi in [0, 2pi] and z. Not visible to queries before build()
+  void add(float phi, float z, TrkrDefs::cluskey key)
+  {
+    m_added.push_back({phi, z, key, static_cast<uint32_t>(m_added.size())});
+  }
+
+  /// bin the clusters added so far
+  void build();
+
+  /// number of clusters in the grid
+  std::size_t size() const { return m_entries.size(); }
+  bool empty() const { return m_entries.empty(); }
+
+  unsigned int nphibins() const { return m_nphi; }
+  unsigned int nzbins() const { return m_nz; }
+
+  /// call fcn(const Entry&) for all clusters with phimin <= phi <= phimax and zmin <= z <= zmax
+  template <class F>
+  void query(double phimin, double zmin, double phimax, double zmax, F&& fcn) const
+  {
+    bool query_both_ends = false;
+    if (phimin < 0)
+    {
+      query_both_ends = true;
+      phimin += 2 * M_PI;
+    }
+    if (phimax > 2 * M_PI)
+    {
+      query_both_ends = true;
+      phimax -= 2 * M_PI;
+    }
+    if (query_both_ends)
+    {
+      query_box(phimin, zmin, 2 * M_PI, zmax, fcn);
+      query_box(0., zmin, phimax, zmax, fcn);
+    }
+    else
+    {
+      query_box(phimin, zmin, phimax, zmax, fcn);
+    }
+  }
+
+ private:
+  unsigned int phi_bin(float phi) const
+  {
+    const float bin = phi * m_phi_scale;
+    return bin <= 0 ? 0 : std::min(m_nphi - 1, static_cast<unsigned int>(bin));
+  }
+
+  unsigned int z_bin(float z) const
+  {
+    const float bin = (z - m_zmin) * m_z_scale;
+    return bin <= 0 ? 0 : std::min(m_nz - 1, static_cast<unsigned int>(bin));
+  }
+
+  template <class F>
+  void query_box(double phimin_d, double zmin_d, double phimax_d, double zmax_d, F& fcn) const
+  {
+    // compare in float, as the rtree boxes do
+    const float phimin = phimin_d;
+    const float phimax = phimax_d;
+    const float zmin = zmin_d;
+    const float zmax = zmax_d;
+    if (m_entries.empty() || phimax < phimin || zmax < zmin || zmax < m_zmin || zmin > m_zmax)
+    {
+      return;
+    }
+
+    const unsigned int phi_first = phi_bin(phimin);
+    const unsigned int phi_last = phi_bin(phimax);
+    const unsigned int z_first = z_bin(zmin);
+    const unsigned int z_last = z_bin(zmax);
+    for (unsigned int iphi = phi_first; iphi <= phi_last; ++iphi)
+    {
+      // bins are ordered by phi then z, the z range of one phi row is contiguous
+      const unsigned int row = iphi * m_nz;
+      const auto first = m_offsets[row + z_first];
+      const auto last = m_offsets[row + z_last + 1];
+      for (auto i = first; i < last; ++i)
+      {
+        const Entry& entry = m_entries[i];
+        if (entry.phi >= phimin && entry.phi <= phimax && entry.z >= zmin && entry.z <= zmax)
+        {
+          fcn(entry);
+        }
+      }
+    }
+  }
+
+  float m_phi_bin_size = 0;
+  float m_z_bin_size = 0;
+
+  unsigned int m_nphi = 1;
+  unsigned int m_nz = 1;
+  float m_phi_scale = 0;
+  float m_z_scale = 0;
+  float m_zmin = 0;
+  float m_zmax = 0;
+
+  /// clusters in add() order
+  std::vector<Entry> m_added;
+
+  /// clusters sorted by bin
+  std::vector<Entry> m_entries;
+
+  /// first entry of each bin, plus the end of the last bin
+  std::vector<uint32_t> m_offsets;
+
+  /// bin of each added cluster, build() workspace
+  std::vector<uint32_t> m_bins;
+};
+
+#endif
@@ -0,0 +1,193 @@
+#include "TrkrThreadPool.h"
+
+//_________________________________________________________________
+TrkrThreadPool &TrkrThreadPool::instance()
+{
+  static TrkrThreadPool pool;
+  return pool;
+}
+
+//_________________________________________________________________
+TrkrThreadPool::~TrkrThreadPool()
+{
+  stop();
+}
+
+//_________________________________________________________________
+void TrkrThreadPool::reserve_threads(unsigned int nthreads)
+{
+  std::lock_guard<std::mutex> submit_lock(m_submit_mutex);
+  if (nthreads <= m_workers.size())
+  {
+    return;
+  }
+
+  // workers are idle between parallel_for calls, restart them with the new size
+  stop();
+
+  m_stop = false;
+  m_queues.clear();
+  for (unsigned int id = 0; id < nthreads; ++id)
+  {
+    m_queues.push_back(std::make_unique<queue_t>());
+  }
+
+  for (unsigned int id = 0; id < nthreads; ++id)
+  {
+    m_workers.emplace_back(&TrkrThreadPool::worker_loop, this, id);
+  }
+}
+
+//_________________________________________________________________
+void TrkrThreadPool::parallel_for(std::size_t ntasks, const task_t &task)
+{
+  parallel_for(ntasks, task, false);
+}
+
+//_________________________________________________________________
+void TrkrThreadPool::parallel_for(std::size_t ntasks, const task_t &task, bool sequential)
+{
+  if (ntasks == 0)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> submit_lock(m_submit_mutex);
+  if (sequential || m_workers.empty())
+  {
+    for (std::size_t i = 0; i < ntasks; ++i)
+    {
+      task(i, 0);
+    }
+    return;
+  }
+
+  // the task must be visible before any index is queued
+  m_task = &task;
+  m_exception = nullptr;
+  m_remaining = ntasks;
+
+  // distribute tasks round-robin. Load imbalance is handled by stealing
+  const auto nqueues = m_queues.size();
+  for (std::size_t i = 0; i < ntasks; ++i)
+  {
+    auto &queue = *m_queues[i % nqueues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(i);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_generation;
+  }
+  m_cv_work.notify_all();
+
+  // wait for completion
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv_done.wait(lock, [this]
+                   { return m_remaining.load() == 0; });
+    exception = m_exception;
+    m_exception = nullptr;
+  }
+
+  m_task = nullptr;
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+//_________________________________________________________________
+void TrkrThreadPool::worker_loop(unsigned int id)
+{
+  std::size_t generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv_work.wait(lock, [this, generation]
+                     { return m_stop || m_generation != generation; });
+      if (m_stop)
+      {
+        return;
+      }
+      generation = m_generation;
+    }
+
+    std::size_t task = 0;
+    while (pop_task(id, task))
+    {
+      try
+      {
+        (*m_task)(task, id);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_exception)
+        {
+          m_exception = std::current_exception();
+        }
+      }
+
+      if (m_remaining.fetch_sub(1) == 1)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cv_done.notify_all();
+      }
+    }
+  }
+}
+
+//_________________________________________________________________
+bool TrkrThreadPool::pop_task(unsigned int id, std::size_t &task)
+{
+  // own queue first, oldest task first
+  {
+    auto &queue = *m_queues[id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+
+  // steal from the back of the other queues
+  const auto nqueues = m_queues.size();
+  for (std::size_t offset = 1; offset < nqueues; ++offset)
+  {
+    auto &queue = *m_queues[(id + offset) % nqueues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//_________________________________________________________________
+void TrkrThreadPool::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv_work.notify_all();
+
+  for (auto &worker : m_workers)
+  {
+    if (worker.joinable())
+    {
+      worker.join();
+    }
+  }
+  m_workers.clear();
+}
@@ -0,0 +1,94 @@
+#ifndef TRACKBASE_TRKRTHREADPOOL_H
+#define TRACKBASE_TRKRTHREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Persistent work-stealing thread pool shared by the tracking reconstruction modules.
+ *
+ * Workers are created once and kept alive for the whole job, so modules which
+ * used to spawn one pthread per hitset (TpcClusterizer, LaserClusterizer, TpcSimpleClusterizer ...)
+ * can submit their per-sector tasks without paying for thread creation on every event.
+ * Each worker owns a task deque; idle workers steal from the back of the other deques,
+ * which balances busy inner sectors against sparse outer ones.
+ *
+ * parallel_for blocks until all tasks are done. The worker index passed to the task is in
+ * [0, nthreads()), and can be used to address per-thread output buffers that are merged
+ * by the caller afterwards. With zero threads, tasks are run in order on the calling thread.
+ * parallel_for is not reentrant: tasks must not submit to the pool themselves.
+ */
+class TrkrThreadPool
+{
+ public:
+  using task_t = std::function<void(std::size_t /*task*/, unsigned int /*worker*/)>;
+
+  /// shared instance
+  static TrkrThreadPool &instance();
+
+  ~TrkrThreadPool();
+
+  // no copy, no move
+  TrkrThreadPool(const TrkrThreadPool &) = delete;
+  TrkrThreadPool &operator=(const TrkrThreadPool &) = delete;
+
+  /// make sure at least nthreads workers are running. The pool never shrinks
+  void reserve_threads(unsigned int nthreads);
+
+  /// number of running workers
+  unsigned int nthreads() const { return m_workers.size(); }
+
+  /// number of per-thread buffers a caller needs to allocate to receive results
+  unsigned int nbuffers() const { return std::max(1U, nthreads()); }
+
+  /// run task(i, worker) for i in [0,ntasks) and wait for completion. Exceptions are rethrown to the caller
+  void parallel_for(std::size_t ntasks, const task_t &task);
+
+  /// same as above, forcing sequential processing on the calling thread when sequential is true
+  void parallel_for(std::size_t ntasks, const task_t &task, bool sequential);
+
+ private:
+  TrkrThreadPool() = default;
+
+  /// per-worker task queue
+  struct queue_t
+  {
+    std::mutex mutex;
+    std::deque<std::size_t> tasks;
+  };
+
+  void worker_loop(unsigned int id);
+
+  /// get next task, first from own queue, then stealing from the others
+  bool pop_task(unsigned int id, std::size_t &task);
+
+  void stop();
+
+  std::vector<std::thread> m_workers;
+  std::vector<std::unique_ptr<queue_t>> m_queues;
+
+  /// serializes calls to parallel_for and reserve_threads
+  std::mutex m_submit_mutex;
+
+  /// protects generation, stop flag and completion
+  std::mutex m_mutex;
+  std::condition_variable m_cv_work;
+  std::condition_variable m_cv_done;
+
+  const task_t *m_task = nullptr;
+  std::size_t m_generation = 0;
+  std::atomic<std::size_t> m_remaining{0};
+  std::exception_ptr m_exception;
+  bool m_stop = false;
+};
+
+#endif
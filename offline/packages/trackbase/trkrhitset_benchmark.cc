@@ -0,0 +1,159 @@
+// Compare fill, lookup and iteration times of TrkrHitSetv1 (map of heap allocated hits)
+// and TrkrHitSetv2 (flat sorted arrays), at configurable occupancy.
+// Default corresponds to a TPC hitset (one layer, one sector, one side)
+// in a central Au+Au event, at about 20% occupancy
+//
+// usage: trkrhitset_benchmark [npads] [ntbins] [occupancy] [nrepeat]
+
+#include "TpcDefs.h"
+#include "TrkrHitSetv1.h"
+#include "TrkrHitSetv2.h"
+#include "TrkrHitv2.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  using bench_clock = std::chrono::steady_clock;
+
+  double elapsed_ms(const bench_clock::time_point& start)
+  {
+    return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+  }
+
+  struct result_t
+  {
+    double fill = 0;
+    double lookup = 0;
+    double iterate = 0;
+    unsigned long checksum = 0;
+  };
+
+  void print(const std::string& name, const result_t& result, int nrepeat)
+  {
+    std::cout << name
+              << " fill: " << result.fill / nrepeat << " ms"
+              << " lookup: " << result.lookup / nrepeat << " ms"
+              << " iterate: " << result.iterate / nrepeat << " ms"
+              << " checksum: " << result.checksum
+              << std::endl;
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const int npads = argc > 1 ? std::atoi(argv[1]) : 128;
+  const int ntbins = argc > 2 ? std::atoi(argv[2]) : 425;
+  const double occupancy = argc > 3 ? std::atof(argv[3]) : 0.2;
+  const int nrepeat = argc > 4 ? std::atoi(argv[4]) : 100;
+
+  // generate hits, in digitizer order (pad by pad, increasing time bin), with random adc
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<double> flat(0, 1);
+  std::uniform_int_distribution<unsigned short> adc_distribution(0, 1023);
+  std::vector<std::pair<TrkrDefs::hitkey, unsigned short>> hits;
+  for (int pad = 0; pad < npads; ++pad)
+  {
+    for (int tbin = 0; tbin < ntbins; ++tbin)
+    {
+      if (flat(generator) < occupancy)
+      {
+        hits.emplace_back(TpcDefs::genHitKey(pad, tbin), adc_distribution(generator));
+      }
+    }
+  }
+
+  // lookup keys, half of which exist
+  std::vector<TrkrDefs::hitkey> lookup_keys;
+  std::uniform_int_distribution<int> pad_distribution(0, npads - 1);
+  std::uniform_int_distribution<int> tbin_distribution(0, ntbins - 1);
+  for (size_t i = 0; i < hits.size(); ++i)
+  {
+    lookup_keys.push_back((i % 2) ? hits[i].first : TpcDefs::genHitKey(pad_distribution(generator), tbin_distribution(generator)));
+  }
+  std::shuffle(lookup_keys.begin(), lookup_keys.end(), generator);
+
+  std::cout << "trkrhitset_benchmark - pads: " << npads << " time bins: " << ntbins
+            << " occupancy: " << occupancy << " hits: " << hits.size()
+            << " repeat: " << nrepeat << std::endl;
+
+  result_t result_v1;
+  result_t result_v2;
+  TrkrHitSetv1 hitset_v1;
+  TrkrHitSetv2 hitset_v2;
+
+  for (int irepeat = 0; irepeat < nrepeat; ++irepeat)
+  {
+    // v1
+    hitset_v1.Reset();
+    auto start = bench_clock::now();
+    for (const auto& [key, adc] : hits)
+    {
+      auto* hit = new TrkrHitv2;
+      hit->setAdc(adc);
+      hitset_v1.addHitSpecificKey(key, hit);
+    }
+    result_v1.fill += elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (const auto& key : lookup_keys)
+    {
+      if (auto* hit = hitset_v1.getHit(key))
+      {
+        result_v1.checksum += hit->getAdc();
+      }
+    }
+    result_v1.lookup += elapsed_ms(start);
+
+    start = bench_clock::now();
+    const auto range = hitset_v1.getHits();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      result_v1.checksum += iter->second->getAdc();
+    }
+    result_v1.iterate += elapsed_ms(start);
+
+    // v2
+    hitset_v2.Reset();
+    start = bench_clock::now();
+    hitset_v2.reserve(hits.size());
+    for (const auto& [key, adc] : hits)
+    {
+      hitset_v2.appendHit(key, adc);
+    }
+    result_v2.fill += elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (const auto& key : lookup_keys)
+    {
+      if (unsigned int adc = 0; hitset_v2.getHitAdc(key, adc))
+      {
+        result_v2.checksum += adc;
+      }
+    }
+    result_v2.lookup += elapsed_ms(start);
+
+    start = bench_clock::now();
+    hitset_v2.forEachHit([&result_v2](TrkrDefs::hitkey /*key*/, unsigned int adc)
+                         { result_v2.checksum += adc; });
+    result_v2.iterate += elapsed_ms(start);
+  }
+
+  print("TrkrHitSetv1", result_v1, nrepeat);
+  print("TrkrHitSetv2", result_v2, nrepeat);
+
+  // approximate heap usage per hit: map node plus TrkrHitv2 object, versus key and adc
+  std::cout << "approximate memory per hit - TrkrHitSetv1: "
+            << sizeof(TrkrHitv2) + 4 * sizeof(void*) + sizeof(TrkrHitSet::Map::value_type)
+            << " bytes, TrkrHitSetv2: " << sizeof(TrkrDefs::hitkey) + sizeof(unsigned short)
+            << " bytes" << std::endl;
+
+  return result_v1.checksum == result_v2.checksum ? 0 : 1;
+}
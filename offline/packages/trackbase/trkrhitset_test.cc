@@ -0,0 +1,154 @@
+// Unit tests for TrkrHitSetv2: add, get, update, iterate and write/read through the streamer,
+// in flat and legacy (TrkrHit map) storage.
+//
+// usage: trkrhitset_test, returns the number of failed checks
+
+#include "TrkrHitSetv2.h"
+#include "TrkrHitv2.h"
+
+#include <TBufferFile.h>
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  int nfailed = 0;
+
+  void check(bool condition, const char* what)
+  {
+    if (!condition)
+    {
+      std::cout << "trkrhitset_test - FAILED: " << what << std::endl;
+      ++nfailed;
+    }
+  }
+
+  using hit_list = std::vector<std::pair<TrkrDefs::hitkey, unsigned int>>;
+
+  hit_list flat_hits(const TrkrHitSetv2& hitset)
+  {
+    hit_list hits;
+    hitset.forEachHit([&hits](TrkrDefs::hitkey key, unsigned int adc)
+                      { hits.emplace_back(key, adc); });
+    return hits;
+  }
+
+  hit_list legacy_hits(const TrkrHitSetv2& hitset)
+  {
+    hit_list hits;
+    const auto range = hitset.getHits();
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      hits.emplace_back(iter->first, iter->second->getAdc());
+    }
+    return hits;
+  }
+
+  // write hitset through its streamer and read it back into a new hitset
+  void round_trip(TrkrHitSetv2& source, TrkrHitSetv2& destination)
+  {
+    TBufferFile buffer(TBuffer::kWrite);
+    source.Streamer(buffer);
+    buffer.SetReadMode();
+    buffer.SetBufferOffset(0);
+    destination.Streamer(buffer);
+  }
+
+  // digitizer pattern: add hits, keep the pointers, update them after other accesses
+  void test_legacy()
+  {
+    TrkrHitSetv2 hitset;
+    auto* hit10 = new TrkrHitv2;
+    hit10->setAdc(5);
+    hitset.addHitSpecificKey(10, hit10);
+    auto* hit4 = new TrkrHitv2;
+    hit4->setAdc(1);
+    const auto iter = hitset.addHitSpecificKey(4, hit4);
+    check(iter->first == 4 && iter->second == hit4, "addHitSpecificKey returns the inserted hit");
+
+    // reading other keys and iterating must keep the added hits
+    check(hitset.getHit(4) == hit4, "getHit returns the added hit");
+    check(hitset.getHit(7) == nullptr, "getHit of a missing key");
+    check(flat_hits(hitset) == hit_list({{4, 1}, {10, 5}}), "forEachHit after addHitSpecificKey");
+    hit10->setAdc(50);
+    hit4->addEnergy(1.);
+    check(hitset.getHit(10) == hit10 && hit10->getAdc() == 50, "update through the kept pointer");
+
+    // appendHit and setHitAdc on a map backed hitset
+    hitset.appendHit(7, 70);
+    hitset.appendHit(10, 99);  // duplicate, ignored
+    check(hitset.setHitAdc(4, 40), "setHitAdc of an existing key");
+    check(!hitset.setHitAdc(5, 1), "setHitAdc of a missing key");
+    check(hit4->getAdc() == 40, "setHitAdc updates the added hit");
+    check(legacy_hits(hitset) == hit_list({{4, 40}, {7, 70}, {10, 50}}), "getHits after appendHit");
+    check(hitset.size() == 3, "size");
+
+    // getHits returns the stored map
+    check(hitset.getHits().first == hitset.getHits().first, "getHits is stable");
+
+    // writing keeps the hits
+    TrkrHitSetv2 copy;
+    round_trip(hitset, copy);
+    check(hitset.getHit(10) == hit10, "hits are kept when writing");
+    check(flat_hits(copy) == hit_list({{4, 40}, {7, 70}, {10, 50}}), "written hits");
+
+    hitset.removeHit(7);
+    check(hitset.size() == 2 && hitset.getHit(7) == nullptr, "removeHit");
+
+    hitset.Reset();
+    check(hitset.size() == 0 && hitset.getHits().first == hitset.getHits().second, "Reset");
+  }
+
+  // unpacker pattern and hits read back from a DST
+  void test_flat()
+  {
+    TrkrHitSetv2 hitset;
+    hitset.setHitSetKey(1234);
+    hitset.reserve(4);
+    hitset.appendHit(3, 30);
+    hitset.appendHit(8, 80);
+    hitset.appendHit(1, 10);  // out of order
+    hitset.appendHit(8, 88);  // duplicate, ignored
+    check(flat_hits(hitset) == hit_list({{1, 10}, {3, 30}, {8, 80}}), "appendHit keeps keys sorted");
+
+    unsigned int adc = 0;
+    check(hitset.getHitAdc(3, adc) && adc == 30, "getHitAdc of an existing key");
+    check(!hitset.getHitAdc(4, adc), "getHitAdc of a missing key");
+    check(hitset.setHitAdc(3, 33), "setHitAdc of an existing key");
+
+    TrkrHitSetv2 copy;
+    round_trip(hitset, copy);
+    check(copy.getHitSetKey() == 1234, "written hitset key");
+    check(flat_hits(copy) == hit_list({{1, 10}, {3, 33}, {8, 80}}), "written flat hits");
+
+    // legacy access creates the hits once, updates are kept
+    TrkrHit* hit = copy.getHit(8);
+    check(hit != nullptr && hit->getAdc() == 80, "getHit on flat storage");
+    hit->setAdc(81);
+    check(copy.getHit(1) != nullptr, "getHit of another key");
+    check(copy.getHit(8) == hit, "getHit returns the same hit");
+    check(legacy_hits(copy) == hit_list({{1, 10}, {3, 33}, {8, 81}}), "getHits on flat storage");
+
+    auto* hit5 = new TrkrHitv2;
+    hit5->setAdc(5);
+    copy.addHitSpecificKey(5, hit5);
+    check(copy.getHit(8) == hit && copy.getHit(5) == hit5, "addHitSpecificKey keeps the other hits");
+
+    TrkrHitSetv2 copy2;
+    round_trip(copy, copy2);
+    check(flat_hits(copy2) == hit_list({{1, 10}, {3, 33}, {5, 5}, {8, 81}}), "written mixed hits");
+
+    copy2.removeHit(3);
+    check(flat_hits(copy2) == hit_list({{1, 10}, {5, 5}, {8, 81}}), "removeHit on flat storage");
+  }
+}  // namespace
+
+int main()
+{
+  test_legacy();
+  test_flat();
+  std::cout << "trkrhitset_test - " << (nfailed ? "failed" : "passed") << std::endl;
+  return nfailed;
+}
@@ -0,0 +1,198 @@
+// Compare build and query times of a boost rtree, as filled by the CA seeders,
+// and TrkrPhiZGrid, for clusters of one layer uniformly distributed in (phi, z).
+// Every cluster is used once as the center of a (phi, z) search window, as when
+// looking for links to the next layer. Windows crossing phi = 0 are wrapped around.
+// Without arguments, runs at pp (about 100 clusters per TPC layer, with pile up)
+// and central Au+Au (about 5000 clusters per TPC layer) occupancies
+//
+// usage: trkrphizgrid_benchmark [nclusters] [dphi window] [dz window] [nrepeat]
+
+#include "TrkrPhiZGrid.h"
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+  using bench_clock = std::chrono::steady_clock;
+  using point = bg::model::point<float, 2, bg::cs::cartesian>;
+  using box = bg::model::box<point>;
+  using pointKey = std::pair<point, TrkrDefs::cluskey>;
+  using rtree = bgi::rtree<pointKey, bgi::quadratic<16>>;
+
+  double elapsed_ms(const bench_clock::time_point& start)
+  {
+    return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+  }
+
+  struct result_t
+  {
+    double build = 0;
+    double query = 0;
+    unsigned long found = 0;
+    unsigned long checksum = 0;
+  };
+
+  struct cluster_t
+  {
+    float phi = 0;
+    float z = 0;
+    TrkrDefs::cluskey key = 0;
+  };
+
+  void print(const std::string& name, const result_t& result, int nrepeat)
+  {
+    std::cout << name
+              << " build: " << result.build / nrepeat << " ms"
+              << " query: " << result.query / nrepeat << " ms"
+              << " total: " << (result.build + result.query) / nrepeat << " ms"
+              << " found: " << result.found / nrepeat
+              << " checksum: " << result.checksum
+              << std::endl;
+  }
+
+  // same wraparound as the seeders QueryTree
+  void query_rtree(const rtree& tree, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values)
+  {
+    bool query_both_ends = false;
+    if (phimin < 0)
+    {
+      query_both_ends = true;
+      phimin += 2 * M_PI;
+    }
+    if (phimax > 2 * M_PI)
+    {
+      query_both_ends = true;
+      phimax -= 2 * M_PI;
+    }
+    if (query_both_ends)
+    {
+      tree.query(bgi::intersects(box(point(phimin, zmin), point(2 * M_PI, zmax))), std::back_inserter(returned_values));
+      tree.query(bgi::intersects(box(point(0., zmin), point(phimax, zmax))), std::back_inserter(returned_values));
+    }
+    else
+    {
+      tree.query(bgi::intersects(box(point(phimin, zmin), point(phimax, zmax))), std::back_inserter(returned_values));
+    }
+  }
+
+  // returns true if both indexes found the same clusters
+  bool run(int nclusters, double dphi, double dz, int nrepeat)
+  {
+    // clusters in the TPC acceptance
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> phi_distribution(0, 2 * M_PI);
+    std::uniform_real_distribution<float> z_distribution(-105, 105);
+    std::vector<cluster_t> clusters;
+    clusters.reserve(nclusters);
+    for (int i = 0; i < nclusters; ++i)
+    {
+      clusters.push_back({phi_distribution(generator), z_distribution(generator), static_cast<TrkrDefs::cluskey>(i)});
+    }
+
+    std::cout << "trkrphizgrid_benchmark - clusters: " << nclusters
+              << " dphi: " << dphi << " dz: " << dz
+              << " repeat: " << nrepeat << std::endl;
+
+    result_t result_rtree;
+    result_t result_grid;
+    rtree tree;
+    TrkrPhiZGrid grid;
+    std::vector<pointKey> returned_values;
+
+    for (int irepeat = 0; irepeat < nrepeat; ++irepeat)
+    {
+      // rtree, filled one cluster at a time as in FillTree
+      tree.clear();
+      auto start = bench_clock::now();
+      for (const auto& cluster : clusters)
+      {
+        tree.insert(std::make_pair(point(cluster.phi, cluster.z), cluster.key));
+      }
+      result_rtree.build += elapsed_ms(start);
+
+      start = bench_clock::now();
+      for (const auto& cluster : clusters)
+      {
+        returned_values.clear();
+        query_rtree(tree, cluster.phi - dphi, cluster.z - dz, cluster.phi + dphi, cluster.z + dz, returned_values);
+        result_rtree.found += returned_values.size();
+        for (const auto& [pt, key] : returned_values)
+        {
+          result_rtree.checksum += key;
+        }
+      }
+      result_rtree.query += elapsed_ms(start);
+
+      // grid, with bins twice the window half width as in the seeders
+      grid.clear();
+      start = bench_clock::now();
+      grid.set_bin_size(2 * dphi, 2 * dz);
+      for (const auto& cluster : clusters)
+      {
+        grid.add(cluster.phi, cluster.z, cluster.key);
+      }
+      grid.build();
+      result_grid.build += elapsed_ms(start);
+
+      start = bench_clock::now();
+      for (const auto& cluster : clusters)
+      {
+        returned_values.clear();
+        grid.query(cluster.phi - dphi, cluster.z - dz, cluster.phi + dphi, cluster.z + dz, [&returned_values](const TrkrPhiZGrid::Entry& entry)
+                   { returned_values.emplace_back(point(entry.phi, entry.z), entry.key); });
+        result_grid.found += returned_values.size();
+        for (const auto& [pt, key] : returned_values)
+        {
+          result_grid.checksum += key;
+        }
+      }
+      result_grid.query += elapsed_ms(start);
+    }
+
+    print("rtree       ", result_rtree, nrepeat);
+    print("TrkrPhiZGrid", result_grid, nrepeat);
+    std::cout << "grid bins - phi: " << grid.nphibins() << " z: " << grid.nzbins() << std::endl;
+
+    return result_rtree.found == result_grid.found && result_rtree.checksum == result_grid.checksum;
+  }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  const double dphi = argc > 2 ? std::atof(argv[2]) : 0.02;
+  const double dz = argc > 3 ? std::atof(argv[3]) : 2;
+  const int nrepeat = argc > 4 ? std::atoi(argv[4]) : 100;
+
+  bool same = true;
+  if (argc > 1)
+  {
+    same = run(std::atoi(argv[1]), dphi, dz, nrepeat);
+  }
+  else
+  {
+    // pp, then central Au+Au
+    same = run(100, dphi, dz, nrepeat) && same;
+    same = run(5000, dphi, dz, nrepeat) && same;
+  }
+
+  if (!same)
+  {
+    std::cout << "rtree and TrkrPhiZGrid results differ" << std::endl;
+  }
+  return same ? 0 : 1;
+}
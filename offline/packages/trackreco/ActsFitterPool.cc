@@ -0,0 +1,21 @@
+#include "ActsFitterPool.h"
+
+#include <utility>
+
+//_________________________________________________________________
+void ActsFitterPool::set_fitter(const Config& config, ConfigFactory factory)
+{
+  m_configs.clear();
+  m_configs.push_back(config);
+  m_factory = std::move(factory);
+}
+
+//_________________________________________________________________
+void ActsFitterPool::reserve_configs(unsigned int nworkers)
+{
+  // called from the submitting thread, before any worker uses its configuration
+  while (m_configs.size() < nworkers)
+  {
+    m_configs.push_back(m_factory());
+  }
+}
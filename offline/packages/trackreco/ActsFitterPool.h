@@ -0,0 +1,94 @@
+#ifndef TRACKRECO_ACTSFITTERPOOL_H
+#define TRACKRECO_ACTSFITTERPOOL_H
+
+#include <trackbase/ActsTrackFittingAlgorithm.h>
+#include <trackbase/TrkrThreadPool.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/*
+ * Helper class to run independent per-seed Acts track fits on the TrkrThreadPool.
+ *
+ * Every worker gets its own fitter functions: worker 0 uses the configuration passed to
+ * set_fitter, the others one made by the factory the first time they are needed.
+ * Calibrators, measurements and track containers are made by the caller for each fit,
+ * and Acts makes a new magnetic field cache for each propagation, so fits running on
+ * different workers share nothing mutable as long as they only write to their output.
+ *
+ * Fit outputs are merged by the caller in seed order, so that track ids and track map
+ * contents do not depend on the number of threads. In sequential mode, each seed is merged
+ * right after being fit, on the calling thread, which is what fitters with per-track side
+ * effects (evaluators, alignment states, transient transforms) need.
+ */
+class ActsFitterPool
+{
+ public:
+  using Config = ActsTrackFittingAlgorithm::Config;
+
+  /// makes a new fitter configuration, independent of the others
+  using ConfigFactory = std::function<Config()>;
+
+  /// fitter configuration used on the calling thread, and factory for the other workers
+  void set_fitter(const Config& config, ConfigFactory factory);
+
+  /**
+   * minimum number of threads requested from the pool. Zero means sequential fitting.
+   * The TrkrThreadPool is shared and never shrinks: if another module reserved more
+   * threads, fits run on all of them
+   */
+  void set_num_threads(unsigned int nthreads) { m_num_threads = nthreads; }
+  unsigned int num_threads() const { return m_num_threads; }
+
+  /// fitter configuration of a given worker
+  const Config& config(unsigned int worker) const { return m_configs[worker]; }
+
+  /**
+   * call fit(iseed, worker, output) for all seeds in [0, nseeds), then merge(iseed, output) in seed order.
+   * Output must be default constructible. Without threads, or when sequential is true,
+   * each seed is fit with worker 0 and merged before the next one is fit
+   */
+  template <class Output, class Fit, class Merge>
+  void run(std::size_t nseeds, bool sequential, Fit&& fit, Merge&& merge)
+  {
+    if (sequential || m_num_threads == 0 || nseeds < 2)
+    {
+      for (std::size_t iseed = 0; iseed < nseeds; ++iseed)
+      {
+        Output output;
+        fit(iseed, 0U, output);
+        merge(iseed, output);
+      }
+      return;
+    }
+
+    auto& pool = TrkrThreadPool::instance();
+    pool.reserve_threads(m_num_threads);
+    reserve_configs(pool.nbuffers());
+
+    std::vector<Output> outputs(nseeds);
+    pool.parallel_for(
+        nseeds,
+        [&fit, &outputs](std::size_t iseed, unsigned int worker)
+        { fit(iseed, worker, outputs[iseed]); });
+
+    for (std::size_t iseed = 0; iseed < nseeds; ++iseed)
+    {
+      merge(iseed, outputs[iseed]);
+    }
+  }
+
+ private:
+  /// make sure there is one fitter configuration per worker
+  void reserve_configs(unsigned int nworkers);
+
+  unsigned int m_num_threads = 0;
+
+  /// fitter configurations, indexed by worker
+  std::vector<Config> m_configs;
+
+  ConfigFactory m_factory;
+};
+
+#endif
@@ -10,6 +10,7 @@
 
 #include "ActsAlignmentStates.h"
 #include "ActsEvaluator.h"
+#include "ActsFitterPool.h"
 
 #include <fun4all/SubsysReco.h>
 
@@ -35,6 +36,7 @@
 class alignmentTransformationContainer;
 class ActsGeometry;
 class SvtxTrack;
+class SvtxTrack_v4;
 class SvtxTrackMap;
 class TrackSeed;
 class TrackSeedContainer;
@@ -145,7 +147,27 @@ class PHActsTrkFitter : public SubsysReco
   void setTrkrClusterContainerName(const std::string& name) { m_clusterContainerName = name; }
   void setDirectNavigation(bool flag) { m_directNavigation = flag; }
   void setClusterEdgeRejection(int edge ) { m_cluster_edge_rejection = edge; }
+
+  /// fit seeds on at least nthreads threads of the shared TrkrThreadPool (on all its
+  /// threads if another module reserved more). Results do not depend on the number of threads.
+  /// Fitting stays sequential with the evaluator, commissioning, outlier finder,
+  /// time analysis, transient transforms (no cluster mover) or non zero verbosity
+  void set_num_threads(unsigned int nthreads) { m_fitterPool.set_num_threads(nthreads); }
+
  private:
+  /// fit result of one seed, inserted in the track maps in seed order
+  struct SeedFitOutput
+  {
+    /// fitted track, if any
+    std::unique_ptr<SvtxTrack_v4> track;
+
+    /// true if the track goes to the directed track map
+    bool directed = false;
+
+    /// number of acts fits that returned an error
+    int nBadFits = 0;
+  };
+
   /// Get all the nodes
   int getNodes(PHCompositeNode* topNode);
 
@@ -154,6 +176,12 @@ class PHActsTrkFitter : public SubsysReco
 
   void loopTracks(Acts::Logging::Level logLevel);
 
+  /// fit one seed with a given fitter configuration. Can run on any worker thread
+  void fitSeed(TrackSeed* track, const ActsTrackFittingAlgorithm::Config& fitCfg, SeedFitOutput& output);
+
+  /// insert a seed fit result in the track maps, on the calling thread
+  void insertTrack(SeedFitOutput& output);
+
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(
       const std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
@@ -164,6 +192,7 @@ class PHActsTrkFitter : public SubsysReco
   /// Helper function to call either the regular navigation or direct
   /// navigation, depending on m_fitSiliconMMs
   ActsTrackFittingAlgorithm::TrackFitterResult fitTrack(
+    const ActsTrackFittingAlgorithm::Config& fitCfg,
     const std::vector<Acts::SourceLink>& sourceLinks,
     const ActsTrackFittingAlgorithm::TrackParameters& seed,
     const ActsTrackFittingAlgorithm::GeneralFitterOptions& kfOptions,
@@ -195,7 +224,10 @@ class PHActsTrkFitter : public SubsysReco
   ActsGeometry* m_tGeometry = nullptr;
 
   /// Configuration containing the fitting function instance
-  ActsTrackFittingAlgorithm::Config m_fitCfg;
+  ActsTrackFittingAlgorithm::Config m_fitCfg{};
+
+  /// per thread fitting function instances
+  ActsFitterPool m_fitterPool;
 
   /// TrackMap containing SvtxTracks
   alignmentTransformationContainer* m_alignmentTransformationMap = nullptr;  // added for testing purposes
@@ -31,6 +31,7 @@
 #include <trackbase/TrkrClusterHitAssoc.h>
 #include <trackbase/TrkrClusterIterationMapv1.h>
 #include <trackbase/TrkrDefs.h>  // for getLayer, clu...
+#include <trackbase/TrkrThreadPool.h>
 #include <trackbase_historic/TrackSeedContainer.h>
 
 // ROOT includes for debugging
@@ -114,6 +115,14 @@ namespace std
 // anonymous namespace for local functions
 namespace
 {
+  // the debugging ntuples are filled from the link finding and chain following
+  // tasks, they are run on the calling thread when the ntuples are written
+#if defined(_PHCASEEDING_CLUSTERLOG_TUPOUT_) || defined(_PHCASEEDING_CHAIN_FORKS_)
+  constexpr bool ntuple_output = true;
+#else
+  constexpr bool ntuple_output = false;
+#endif
+
   // square
   template <class T>
   inline constexpr T square(const T& x)
@@ -238,6 +247,19 @@ void PHCASeeding::QueryTree(const bgi::rtree<PHCASeeding::pointKey, bgi::quadrat
   }
 }
 
+void PHCASeeding::QueryLayer(int layer_index, double phimin, double z_min, double phimax, double z_max, std::vector<pointKey>& returned_values) const
+{
+  if (_use_grid_index)
+  {
+    _grids[layer_index].query(phimin, z_min, phimax, z_max, [&returned_values](const TrkrPhiZGrid::Entry& entry)
+                              { returned_values.emplace_back(point(entry.phi, entry.z), entry.key); });
+  }
+  else
+  {
+    QueryTree(_rtrees[layer_index], phimin, z_min, phimax, z_max, returned_values);
+  }
+}
+
 std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::FillGlobalPositions()
 {
   keyListPerLayer ckeys;
@@ -284,7 +306,7 @@ std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::F
   return std::make_pair(cachedPositions, ckeys);
 }
 
-std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer)
+std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer) const
 {
   // Fill _rtree with the clusters in ckeys; remove duplicates, and return a vector of the coordKeys
   // Note that layer is only used for a cout statement
@@ -310,9 +332,7 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
       continue;
     }
     coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
-    t_fill->restart();
     _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), ckey));
-    t_fill->stop();
   }
   if (Verbosity() > 5)
   {
@@ -320,7 +340,57 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
   }
   if (Verbosity() > 3)
   {
-    std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
+    std::cout << "number of duplicates : " << n_dupli << std::endl;
+  }
+  return coords;
+}
+
+std::vector<PHCASeeding::coordKey> PHCASeeding::FillGrid(TrkrPhiZGrid& grid, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer) const
+{
+  // Same as FillTree, for the grid: a cluster is a duplicate when a prior,
+  // non duplicate cluster of the layer is within the same tiny window
+  grid.clear();
+  std::vector<std::array<double, 2>> positions;
+  positions.reserve(ckeys.size());
+  for (const auto& ckey : ckeys)
+  {
+    const auto& globalpos_d = globalPositions.at(ckey);
+    positions.push_back({get_phi(globalpos_d), globalpos_d.z()});
+    grid.add(positions.back()[0], positions.back()[1], ckey);
+  }
+  grid.build();
+
+  int n_dupli = 0;
+  std::vector<coordKey> coords;
+  std::vector<char> is_duplicate(ckeys.size(), 0);
+  for (uint32_t index = 0; index < ckeys.size(); ++index)
+  {
+    const auto [clus_phi, clus_z] = positions[index];
+    bool duplicate = false;
+    grid.query(clus_phi - 0.00001, clus_z - 0.00001, clus_phi + 0.00001, clus_z + 0.00001, [&](const TrkrPhiZGrid::Entry& entry)
+               { duplicate |= (entry.index < index && !is_duplicate[entry.index]); });
+    if (duplicate)
+    {
+      is_duplicate[index] = 1;
+      ++n_dupli;
+      continue;
+    }
+    coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckeys[index]});
+  }
+
+  // rebin without the duplicates
+  if (n_dupli > 0)
+  {
+    grid.clear();
+    for (const auto& coord : coords)
+    {
+      grid.add(coord.first[0], coord.first[1], coord.second);
+    }
+    grid.build();
+  }
+  if (Verbosity() > 5)
+  {
+    std::cout << "nhits in layer(" << layer << "): " << coords.size() << std::endl;
   }
   if (Verbosity() > 3)
   {
@@ -387,15 +457,23 @@ int PHCASeeding::FindSeedsWithMerger(const PHCASeeding::PositionMap& globalPosit
 
   t_makeseeds->restart();
   keyLists trackSeedKeyLists = FollowBiLinks(trackSeedPairs, bodyLinks, globalPositions);
+  m_statistics.follow_bilinks_time += t_makeseeds->elapsed();
   PHCASEEDING_PRINT_TIME(t_makeseeds, "make seeds");
   if (Verbosity() > 0)
   {
     t_makeseeds->stop();
     std::cout << "Time to make seeds: " << t_makeseeds->elapsed() / 1000 << " s" << std::endl;
   }
+
+  PHTimer t_remove("t_remove");
+  t_remove.restart();
   std::vector<TrackSeed_v2> seeds = RemoveBadClusters(trackSeedKeyLists, globalPositions);
+  t_remove.stop();
+  m_statistics.remove_bad_clusters_time += t_remove.elapsed();
 
   publishSeeds(seeds);
+  ++m_statistics.nevents;
+  m_statistics.nseeds += seeds.size();
   return seeds.size();
 }
 
@@ -404,63 +482,74 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   keyLinks startLinks;        // bilinks at start of chains
   keyLinkPerLayer bodyLinks;  //  bilinks to build chains
                               //
-  double cluster_find_time = 0;
-  double rtree_query_time = 0;
-  double transform_time = 0;
-  double compute_best_angle_time = 0;
-  double set_insert_time = 0;
-
-  // there are three coord_array (only the current layer is used at a time,
-  // but it is filled the same time as the _rtrees, which are used two at
-  // a time -- the prior padplane row and the next padplain row
-  std::array<std::vector<coordKey>, 3> coord_arr;
-  std::array<std::unordered_set<keyLink>, 2> previous_downlinks_arr;
-  std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
-
   // iterate from outer to inner layers
   const int inner_index = _start_layer - _FIRST_LAYER_TPC + 1;
   const int outer_index = _end_layer - _FIRST_LAYER_TPC - 2;
-
-  // fill the current and prior row coord and ttrees for the first iteration
-  int _index_above = (outer_index + 1) % 3;
-  int _index_current = (outer_index) % 3;
-  coord_arr[_index_above] = FillTree(_rtrees[_index_above], ckeys[outer_index + 1], globalPositions, outer_index + 1);
-  coord_arr[_index_current] = FillTree(_rtrees[_index_current], ckeys[outer_index], globalPositions, outer_index);
-
-  for (int layer_index = outer_index; layer_index >= inner_index; --layer_index)
+  if (outer_index < inner_index)
   {
-    // these lines of code will rotates through all three _rtree's in the array,
-    // where the old lower becomes the new middle, the old middle the new upper,
-    // and the old upper drops out and that _rtree is filled with the new lower
-    const unsigned int LAYER = layer_index + _FIRST_LAYER_TPC;
-    int index_above = (layer_index + 1) % 3;
-    int index_current = (layer_index) % 3;
-    int index_below = (layer_index - 1) % 3;
-
-    coord_arr[index_below] = FillTree(_rtrees[index_below], ckeys[layer_index - 1], globalPositions, layer_index - 1);
-
-    // NO DUPLICATES FOUND IN COORD_ARR
+    return std::make_pair(startLinks, bodyLinks);
+  }
 
-    auto& _rtree_above = _rtrees[index_above];
-    const std::vector<coordKey>& coord = coord_arr[index_current];
-    auto& _rtree_below = _rtrees[index_below];
+  PHTimer t_links("t_links");
+  t_links.restart();
 
-    auto& curr_downlinks = previous_downlinks_arr[layer_index % 2];
-    auto& last_downlinks = previous_downlinks_arr[(layer_index + 1) % 2];
+  auto& pool = TrkrThreadPool::instance();
+  pool.reserve_threads(m_num_threads);
+  const bool sequential = ntuple_output || m_num_threads == 0;
 
-    auto& curr_bottom_of_bilink = bottom_of_bilink_arr[layer_index % 2];
-    auto& last_bottom_of_bilink = bottom_of_bilink_arr[(layer_index + 1) % 2];
+  // fill one rtree per layer, for the current layers and the one above and below them.
+  // The coord_arr of a layer holds its clusters, with duplicates removed
+  std::array<std::vector<coordKey>, _NLAYERS_TPC> coord_arr;
+  std::array<double, _NLAYERS_TPC> fill_time{};
+  pool.parallel_for(
+      outer_index - inner_index + 3, [&](std::size_t task, unsigned int /*worker*/)
+      {
+        const int layer_index = inner_index - 1 + task;
+        PHTimer timer("t_fill");
+        timer.restart();
+        if (_use_grid_index)
+        {
+          // bins of the size of the widest window used to search this layer
+          const int LAYER = layer_index + _FIRST_LAYER_TPC;
+          const int next = std::min(LAYER + 1, 54);
+          _grids[layer_index].set_bin_size(2 * std::max(dphi_per_layer[LAYER], dphi_per_layer[next]), 2 * std::max(dZ_per_layer[LAYER], dZ_per_layer[next]));
+          coord_arr[layer_index] = FillGrid(_grids[layer_index], ckeys[layer_index], globalPositions, layer_index);
+        }
+        else
+        {
+          coord_arr[layer_index] = FillTree(_rtrees[layer_index], ckeys[layer_index], globalPositions, layer_index);
+        }
+        timer.stop();
+        fill_time[layer_index] = timer.elapsed(); },
+      sequential);
 
-    curr_downlinks.clear();
-    curr_bottom_of_bilink.clear();
+  // links found from the clusters of one layer
+  struct layer_links_t
+  {
+    // links from a cluster of this layer to the layer below
+    std::unordered_set<keyLink> downlinks;
+    // links from the layer above to a cluster of this layer, in search order
+    keyLinks uplinks;
+    double cluster_find_time = 0;
+    double rtree_query_time = 0;
+    double transform_time = 0;
+    double compute_best_angle_time = 0;
+  };
+  std::array<layer_links_t, _NLAYERS_TPC> layer_links;
 
-    // For all the clusters in coord, find nearest neighbors in the
-    // above and below layers and make links
-    // Any link to an above node which matches the same clusters
-    // on the previous iteration (to a "below node") becomes a "bilink"
-    // Check if this bilink links to a prior bilink or not
+  // For all the clusters of a layer, find nearest neighbors in the
+  // above and below layers and make links. The layers only read the
+  // trees, so they are all processed at the same time
+  pool.parallel_for(
+      outer_index - inner_index + 1, [&](std::size_t task, unsigned int /*worker*/)
+      {
+    const int layer_index = outer_index - task;
+    const unsigned int LAYER = layer_index + _FIRST_LAYER_TPC;
+    const std::vector<coordKey>& coord = coord_arr[layer_index];
+    auto& links = layer_links[layer_index];
 
-    std::vector<keyLink> aboveLinks;
+    PHTimer timer("t_layer");
+    timer.restart();
     for (const auto& StartCluster : coord)
     {
       double StartPhi = StartCluster.first[0];
@@ -468,9 +557,9 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       double StartX = globalpos(0);
       double StartY = globalpos(1);
       double StartZ = globalpos(2);
-      t_seed->stop();
-      cluster_find_time += t_seed->elapsed();
-      t_seed->restart();
+      timer.stop();
+      links.cluster_find_time += timer.elapsed();
+      timer.restart();
       LogDebug(" starting cluster:" << std::endl);
       LogDebug(" z: " << StartZ << std::endl);
       LogDebug(" phi: " << StartPhi << std::endl);
@@ -478,25 +567,25 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       std::vector<pointKey> ClustersAbove;
       std::vector<pointKey> ClustersBelow;
 
-      QueryTree(_rtree_below,
-                StartPhi - dphi_per_layer[LAYER],
-                StartZ - dZ_per_layer[LAYER],
-                StartPhi + dphi_per_layer[LAYER],
-                StartZ + dZ_per_layer[LAYER],
-                ClustersBelow);
-
-      FillTupWinLink(_rtree_below, StartCluster, globalPositions);
-
-      QueryTree(_rtree_above,
-                StartPhi - dphi_per_layer[LAYER + 1],
-                StartZ - dZ_per_layer[LAYER + 1],
-                StartPhi + dphi_per_layer[LAYER + 1],
-                StartZ + dZ_per_layer[LAYER + 1],
-                ClustersAbove);
-
-      t_seed->stop();
-      rtree_query_time += t_seed->elapsed();
-      t_seed->restart();
+      QueryLayer(layer_index - 1,
+                 StartPhi - dphi_per_layer[LAYER],
+                 StartZ - dZ_per_layer[LAYER],
+                 StartPhi + dphi_per_layer[LAYER],
+                 StartZ + dZ_per_layer[LAYER],
+                 ClustersBelow);
+
+      FillTupWinLink(layer_index - 1, StartCluster, globalPositions);
+
+      QueryLayer(layer_index + 1,
+                 StartPhi - dphi_per_layer[LAYER + 1],
+                 StartZ - dZ_per_layer[LAYER + 1],
+                 StartPhi + dphi_per_layer[LAYER + 1],
+                 StartZ + dZ_per_layer[LAYER + 1],
+                 ClustersAbove);
+
+      timer.stop();
+      links.rtree_query_time += timer.elapsed();
+      timer.restart();
       LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
       LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
       std::vector<std::array<double, 3>> delta_below;
@@ -522,9 +611,9 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
           return std::array<double,3>{abovepos(0)-StartX,
           abovepos(1)-StartY,
           abovepos(2)-StartZ}; });
-      t_seed->stop();
-      transform_time += t_seed->elapsed();
-      t_seed->restart();
+      timer.stop();
+      links.transform_time += timer.elapsed();
+      timer.restart();
 
       // find the three clusters closest to a straight line
       // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
@@ -551,7 +640,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
           {
             // maxCosPlaneAngle = cos(angle);
             // minSumLengths = belowLength+aboveLength;
-            curr_downlinks.insert({StartCluster.second, ClustersBelow[iBelow].second});
+            links.downlinks.insert({StartCluster.second, ClustersBelow[iBelow].second});
             bestAboveClusters.insert(ClustersAbove[iAbove].second);
 
             // fill the tuples for plotting
@@ -565,14 +654,35 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       // There was some old commented-out code here for allowing layers to be skipped. This
       // may be useful in the future. This chunk of code has been moved towards the
       // end fo the file under the title: "---OLD CODE 0: SKIP_LAYERS---"
-      t_seed->stop();
-      compute_best_angle_time += t_seed->elapsed();
-      t_seed->restart();
-
       for (auto cluster : bestAboveClusters)
       {
-        keyLink uplink = std::make_pair(cluster, StartCluster.second);
-
+        links.uplinks.emplace_back(cluster, StartCluster.second);
+      }
+      timer.stop();
+      links.compute_best_angle_time += timer.elapsed();
+      timer.restart();
+    }  // end loop over start clusters
+    LogDebug(" max collinearity: " << maxCosPlaneAngle << std::endl); },
+      sequential);
+
+  // Any link to an above node which matches the same clusters
+  // on the previous (above) layer to a "below node" becomes a "bilink".
+  // Check if this bilink links to a prior bilink or not.
+  // Done from outer to inner layers, so that the links are in the same order
+  // whatever the number of threads
+  PHTimer t_insert("t_insert");
+  t_insert.restart();
+  std::unordered_set<TrkrDefs::cluskey> curr_bottom_of_bilink;
+  std::unordered_set<TrkrDefs::cluskey> last_bottom_of_bilink;
+  uint64_t nbilinks = 0;
+  for (int layer_index = outer_index; layer_index >= inner_index; --layer_index)
+  {
+    curr_bottom_of_bilink.clear();
+    if (layer_index < outer_index)
+    {
+      const auto& last_downlinks = layer_links[layer_index + 1].downlinks;
+      for (const auto& uplink : layer_links[layer_index].uplinks)
+      {
         if (last_downlinks.find(uplink) != last_downlinks.end())
         {
           // this is a bilink
@@ -581,6 +691,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
           curr_bottom_of_bilink.insert(key_bot);
           fill_tuple(_tupclus_bilinks, 0, key_top, globalPositions.at(key_top));
           fill_tuple(_tupclus_bilinks, 1, key_bot, globalPositions.at(key_bot));
+          ++nbilinks;
 
           if (last_bottom_of_bilink.find(key_top) == last_bottom_of_bilink.end())
           {
@@ -592,25 +703,46 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
           }
         }
       }  // end loop over all up-links
-    }    // end loop over start clusters
-
-    t_seed->stop();
-    set_insert_time += t_seed->elapsed();
-    t_seed->restart();
-    LogDebug(" max collinearity: " << maxCosPlaneAngle << std::endl);
+    }
+    std::swap(curr_bottom_of_bilink, last_bottom_of_bilink);
   }  // end loop over layers (to make links)
+  t_insert.stop();
+  t_links.stop();
+
+  // statistics
+  SeedingStatistics stats;
+  stats.set_insert_time = t_insert.elapsed();
+  for (int layer_index = inner_index - 1; layer_index <= outer_index + 1; ++layer_index)
+  {
+    stats.fill_time += fill_time[layer_index];
+  }
+  for (int layer_index = inner_index; layer_index <= outer_index; ++layer_index)
+  {
+    const auto& links = layer_links[layer_index];
+    stats.cluster_find_time += links.cluster_find_time;
+    stats.rtree_query_time += links.rtree_query_time;
+    stats.transform_time += links.transform_time;
+    stats.compute_best_angle_time += links.compute_best_angle_time;
+  }
+  m_statistics.fill_time += stats.fill_time;
+  m_statistics.cluster_find_time += stats.cluster_find_time;
+  m_statistics.rtree_query_time += stats.rtree_query_time;
+  m_statistics.transform_time += stats.transform_time;
+  m_statistics.compute_best_angle_time += stats.compute_best_angle_time;
+  m_statistics.set_insert_time += stats.set_insert_time;
+  m_statistics.create_bilinks_time += t_links.elapsed();
+  m_statistics.nbilinks += nbilinks;
 
-  t_seed->stop();
   if (Verbosity() > 0)
   {
-    std::cout << "triplet forming time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
-    std::cout << "starting cluster setup: " << cluster_find_time / 1000 << " s" << std::endl;
-    std::cout << "RTree query: " << rtree_query_time / 1000 << " s" << std::endl;
-    std::cout << "Transform: " << transform_time / 1000 << " s" << std::endl;
-    std::cout << "Compute best triplet: " << compute_best_angle_time / 1000 << " s" << std::endl;
-    std::cout << "Set insert: " << set_insert_time / 1000 << " s" << std::endl;
+    std::cout << "triplet forming time: " << t_links.elapsed() / 1000 << " s" << std::endl;
+    std::cout << "RTree fill: " << stats.fill_time / 1000 << " s" << std::endl;
+    std::cout << "starting cluster setup: " << stats.cluster_find_time / 1000 << " s" << std::endl;
+    std::cout << "RTree query: " << stats.rtree_query_time / 1000 << " s" << std::endl;
+    std::cout << "Transform: " << stats.transform_time / 1000 << " s" << std::endl;
+    std::cout << "Compute best triplet: " << stats.compute_best_angle_time / 1000 << " s" << std::endl;
+    std::cout << "Set insert: " << stats.set_insert_time / 1000 << " s" << std::endl;
   }
-  t_seed->restart();
 
   // sort the body links per layer so that links can be binary-searched per layer
   /* for (auto& layer : bodyLinks) { std::sort(layer.begin(), layer.end()); } */
@@ -636,10 +768,54 @@ double PHCASeeding::getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b,
 }
 
 PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& trackSeedPairs, const PHCASeeding::keyLinkPerLayer& bilinks, const PHCASeeding::PositionMap& globalPositions) const
+{
+  // The chains of every start link are followed independently. Seeds split
+  // off a chain are grown in the next round, so the chains are collected per
+  // start link and per round, then merged round by round in start link order.
+  // This gives the same seeds, in the same order, as growing all of them at once
+  auto& pool = TrkrThreadPool::instance();
+  pool.reserve_threads(m_num_threads);
+
+  int nsplit_chains = -1;
+  std::vector<std::vector<keyLists>> grown_per_link(trackSeedPairs.size());
+  pool.parallel_for(
+      trackSeedPairs.size(), [&](std::size_t index, unsigned int /*worker*/)
+      { grown_per_link[index] = GrowSeeds(trackSeedPairs[index], bilinks, globalPositions, nsplit_chains); },
+      ntuple_output || m_num_threads == 0);
+
+  std::size_t nrounds = 0;
+  for (const auto& rounds : grown_per_link)
+  {
+    nrounds = std::max(nrounds, rounds.size());
+  }
+  keyLists grown_seeds;
+  for (std::size_t round = 0; round < nrounds; ++round)
+  {
+    for (auto& rounds : grown_per_link)
+    {
+      if (round < rounds.size())
+      {
+        std::move(rounds[round].begin(), rounds[round].end(), std::back_inserter(grown_seeds));
+      }
+    }
+  }
+
+  // old code block move to end of code under the title: "---OLD CODE 1: SKIP_LAYERS---"
+  t_seed->stop();
+  if (Verbosity() > 1)
+  {
+    std::cout << "keychain assembly time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
+  }
+  t_seed->restart();
+  LogDebug(" track key chains assembled: " << grown_seeds.size() << std::endl);
+  LogDebug(" track key chain lengths: " << std::endl);
+  return grown_seeds;
+}
+
+std::vector<PHCASeeding::keyLists> PHCASeeding::GrowSeeds(const PHCASeeding::keyLink& startLink, const PHCASeeding::keyLinkPerLayer& bilinks, const PHCASeeding::PositionMap& globalPositions, int& nsplit_chains) const
 {
   // form all possible starting 3-cluster tracks (we need that to calculate curvature)
   keyLists seeds;
-  for (auto& startLink : trackSeedPairs)
   {
     TrkrDefs::cluskey trackHead = startLink.second;
     unsigned int trackHead_layer = TrkrDefs::getLayer(trackHead) - _FIRST_LAYER_TPC;
@@ -668,12 +844,6 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
   // - grow every seed in the seedlist, up to the maximum number of clusters per seed
   // - the algorithm is that every cluster is allowed to be used by any number of chains, so there is no penalty in which order they are added
 
-  t_seed->stop();
-  if (Verbosity() > 0)
-  {
-    std::cout << "starting cluster finding time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
-  }
-  t_seed->restart();
   // assemble track cluster chains from starting cluster keys (ordered from outside in)
 
   // std::cout << "STARTING SEED ASSEMBLY" << std::endl;
@@ -684,23 +854,20 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
   // If there are possible multiple links to add to a single chain, optionally split the chain to
   // follow all possibile links (depending on the input parameter _split_seeds)
 
-  //  std::vector<keyList> seeds;
-  // std::vector<keyList> tempSeedKeyLists = seeds;
-  // seeds.clear();
+  // grown seeds, per round
+  std::vector<keyLists> grown_seeds;
   if (seeds.size() == 0)
   {
-    return seeds;
+    return grown_seeds;
   }
 
-  int nsplit_chains = -1;
-
   // positions of the seed being following
   std::array<float, 4> phi{}, R{}, Z{};
-  keyLists grown_seeds;
 
   while (seeds.size() > 0)
   {
     keyLists split_seeds{};  // to collect when using split tracks
+    auto& round_seeds = grown_seeds.emplace_back();
     for (auto& seed : seeds)
     {
       // grow the seed to the maximum length allowed
@@ -857,7 +1024,7 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
       }    // end of seed growing loop: if (!done_growing)
       if (seed.size() >= _min_clusters_per_seed)
       {
-        grown_seeds.push_back(seed);
+        round_seeds.push_back(seed);
         fill_tuple_with_seed(_tupclus_grown_seeds, seed, globalPositions);
       }
     }  // end of loop over seeds
@@ -869,15 +1036,6 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
     /* seeds = split_seeds; */
   }  // end of looping over all seeds
 
-  // old code block move to end of code under the title: "---OLD CODE 1: SKIP_LAYERS---"
-  t_seed->stop();
-  if (Verbosity() > 1)
-  {
-    std::cout << "keychain assembly time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
-  }
-  t_seed->restart();
-  LogDebug(" track key chains assembled: " << trackSeedKeyLists.size() << std::endl);
-  LogDebug(" track key chain lengths: " << std::endl);
   return grown_seeds;
 }
 
@@ -887,38 +1045,60 @@ std::vector<TrackSeed_v2> PHCASeeding::RemoveBadClusters(const std::vector<PHCAS
   {
     std::cout << "removing bad clusters" << std::endl;
   }
-  std::vector<TrackSeed_v2> clean_chains;
 
-  for (const auto& chain : chains)
+  // the circle fits are independent, run them in blocks of chains
+  // and keep the chains in their original order
+  static constexpr std::size_t chains_per_task = 64;
+  std::vector<char> good_chains(chains.size(), 0);
+  auto& pool = TrkrThreadPool::instance();
+  pool.reserve_threads(m_num_threads);
+  pool.parallel_for(
+      (chains.size() + chains_per_task - 1) / chains_per_task, [&](std::size_t task, unsigned int /*worker*/)
+      {
+    const std::size_t last = std::min(chains.size(), (task + 1) * chains_per_task);
+    for (std::size_t index = task * chains_per_task; index < last; ++index)
+    {
+      const auto& chain = chains[index];
+      if (chain.size() < 3)
+      {
+        continue;
+      }
+
+      TrackFitUtils::position_vector_t xy_pts;
+      for (const auto& cluskey : chain)
+      {
+        const auto& global = globalPositions.at(cluskey);
+        xy_pts.emplace_back(global.x(), global.y());
+      }
+
+      // fit a circle through x,y coordinates
+      const auto [R, X0, Y0] = TrackFitUtils::circle_fit_by_taubin(xy_pts);
+
+      // skip chain entirely if fit fails
+      if (std::isnan(R))
+      {
+        continue;
+      }
+
+      // calculate residuals
+      const std::vector<double> xy_resid = TrackFitUtils::getCircleClusterResiduals(xy_pts, R, X0, Y0);
+      good_chains[index] = 1;
+    } },
+      m_num_threads == 0);
+
+  std::vector<TrackSeed_v2> clean_chains;
+  for (std::size_t index = 0; index < chains.size(); ++index)
   {
-    if (chain.size() < 3)
+    if (!good_chains[index])
     {
       continue;
     }
+    const auto& chain = chains[index];
     if (Verbosity() > 3)
     {
       std::cout << "chain size: " << chain.size() << std::endl;
     }
 
-    TrackFitUtils::position_vector_t xy_pts;
-    for (const auto& cluskey : chain)
-    {
-      const auto& global = globalPositions.at(cluskey);
-      xy_pts.emplace_back(global.x(), global.y());
-    }
-
-    // fit a circle through x,y coordinates
-    const auto [R, X0, Y0] = TrackFitUtils::circle_fit_by_taubin(xy_pts);
-
-    // skip chain entirely if fit fails
-    if (std::isnan(R))
-    {
-      continue;
-    }
-
-    // calculate residuals
-    const std::vector<double> xy_resid = TrackFitUtils::getCircleClusterResiduals(xy_pts, R, X0, Y0);
-
     // assign clusters to seed
     TrackSeed_v2 trackseed;
     for (const auto& key : chain)
@@ -966,9 +1146,6 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
   }
 
   // timing
-  t_fill = std::make_unique<PHTimer>("t_fill");
-  t_fill->stop();
-
   t_seed = std::make_unique<PHTimer>("t_seed");
   t_seed->stop();
 
@@ -1028,6 +1205,29 @@ int PHCASeeding::End()
   {
     std::cout << "Called End " << std::endl;
   }
+
+  if (Verbosity() > 0)
+  {
+    // average time per event, link finding task times are summed over the threads
+    const auto& stats = m_statistics;
+    const double nevents = std::max(1U, stats.nevents);
+    std::cout << "PHCASeeding::End - " << stats.nevents << " events, "
+              << stats.nseeds / nevents << " seeds/event, " << m_num_threads << " threads, ms/event:"
+              << " make bilinks " << stats.create_bilinks_time / nevents
+              << " follow bilinks " << stats.follow_bilinks_time / nevents
+              << " remove bad clusters " << stats.remove_bad_clusters_time / nevents << std::endl;
+    if (Verbosity() > 1)
+    {
+      std::cout << "PHCASeeding::End - " << stats.nbilinks / nevents << " bilinks/event, ms/event:"
+                << " RTree fill " << stats.fill_time / nevents
+                << " starting clusters " << stats.cluster_find_time / nevents
+                << " RTree query " << stats.rtree_query_time / nevents
+                << " transform " << stats.transform_time / nevents
+                << " best triplet " << stats.compute_best_angle_time / nevents
+                << " set insert " << stats.set_insert_time / nevents << std::endl;
+    }
+  }
+
   write_tuples();  // if defined _PHCASEEDING_CLUSTERLOG_TUPOUT_
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -1166,19 +1366,19 @@ void PHCASeeding::process_tupout_count()
   _search_windows->Fill(_neighbor_z_width, _neighbor_phi_width, _start_layer, _end_layer, _clusadd_delta_dzdr_window, _clusadd_delta_dphidr2_window);
 }
 
-void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
+void PHCASeeding::FillTupWinLink(int layer_index_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
 {
   double StartPhi = StartCluster.first[0];
   const auto& P0 = globalPositions.at(StartCluster.second);
   double StartZ = P0(2);
   // Fill TNTuple _tupwin_link
   std::vector<pointKey> ClustersBelow;
-  QueryTree(_rtree_below,
-            StartPhi - 1.,
-            StartZ - 20.,
-            StartPhi + 1.,
-            StartZ + 20.,
-            ClustersBelow);
+  QueryLayer(layer_index_below,
+             StartPhi - 1.,
+             StartZ - 20.,
+             StartPhi + 1.,
+             StartZ + 20.,
+             ClustersBelow);
 
   for (const auto& pkey : ClustersBelow)
   {
@@ -1254,7 +1454,7 @@ void PHCASeeding::write_tuples(){};
 void PHCASeeding::fill_tuple(TNtuple* /**/, float /**/, TrkrDefs::cluskey /**/, const Acts::Vector3& /**/) const {};
 void PHCASeeding::fill_tuple_with_seed(TNtuple* /**/, const PHCASeeding::keyList& /**/, const PHCASeeding::PositionMap& /**/) const {};
 void PHCASeeding::process_tupout_count(){};
-void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& /**/, const PHCASeeding::coordKey& /**/, const PHCASeeding::PositionMap& /**/) const {};
+void PHCASeeding::FillTupWinLink(int /**/, const PHCASeeding::coordKey& /**/, const PHCASeeding::PositionMap& /**/) const {};
 void PHCASeeding::FillTupWinCosAngle(const TrkrDefs::cluskey /**/, const TrkrDefs::cluskey /**/, const TrkrDefs::cluskey /**/, const PHCASeeding::PositionMap& /**/, double /**/, bool /**/) const {};
 void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList& /**/, const PHCASeeding::keyLink& /**/, const PHCASeeding::PositionMap& /**/) const {};
 #endif  // defined _PHCASEEDING_CLUSTERLOG_TUPOUT_
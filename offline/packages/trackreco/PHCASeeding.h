@@ -18,6 +18,7 @@
 #include <tpc/TpcGlobalPositionWrapper.h>
 
 #include <trackbase/TrkrDefs.h>  // for cluskey
+#include <trackbase/TrkrPhiZGrid.h>
 #include <trackbase_historic/TrackSeed_v2.h>
 
 #include <phool/PHTimer.h>  // for PHTimer
@@ -101,6 +102,8 @@ class PHCASeeding : public PHTrackSeeding
   ~PHCASeeding() override = default;
 
   void SetSplitSeeds(bool opt = true) { _split_seeds = opt; }
+  /// search neighbor clusters in binned (phi, z) grids instead of boost rtrees
+  void SetUseGridIndex(bool opt = true) { _use_grid_index = opt; }
   void SetLayerRange(unsigned int layer_low, unsigned int layer_up)
   {
     _start_layer = layer_low;
@@ -156,6 +159,32 @@ class PHCASeeding : public PHTrackSeeding
   void setNitrogenFraction(double frac) { N2_frac = frac; };
   void setIsobutaneFraction(double frac) { isobutane_frac = frac; };
 
+  /// number of threads used for link finding and chain following. Zero (default) runs everything on the calling thread
+  void set_num_threads(unsigned int nthreads) { m_num_threads = nthreads; }
+
+  /// per phase timing (ms), accumulated over all events and printed in End with verbosity
+  struct SeedingStatistics
+  {
+    unsigned int nevents = 0;
+    // summed over the per layer tasks
+    double fill_time = 0;
+    double cluster_find_time = 0;
+    double rtree_query_time = 0;
+    double transform_time = 0;
+    double compute_best_angle_time = 0;
+    // bilink merge, on the calling thread
+    double set_insert_time = 0;
+    // wall time of the phases
+    double create_bilinks_time = 0;
+    double follow_bilinks_time = 0;
+    double remove_bad_clusters_time = 0;
+    uint64_t nbilinks = 0;
+    uint64_t nseeds = 0;
+  };
+
+  /// timing and counts accumulated since the start of the job
+  const SeedingStatistics& statistics() const { return m_statistics; }
+
  protected:
   int Setup(PHCompositeNode* topNode) override;
   int Process(PHCompositeNode* topNode) override;
@@ -190,7 +219,7 @@ class PHCASeeding : public PHTrackSeeding
   void fill_tuple(TNtuple*, float, TrkrDefs::cluskey, const Acts::Vector3&) const;
   void fill_tuple_with_seed(TNtuple*, const keyList&, const PositionMap&) const;
   void process_tupout_count();
-  void FillTupWinLink(bgi::rtree<pointKey, bgi::quadratic<16>>&, const coordKey&, const PositionMap&) const;
+  void FillTupWinLink(int layer_index, const coordKey&, const PositionMap&) const;
   void FillTupWinCosAngle(const TrkrDefs::cluskey, const TrkrDefs::cluskey, const TrkrDefs::cluskey, const PositionMap&, double cos_angle, bool isneg) const;
   void FillTupWinGrowSeed(const keyList& seed, const keyLink& link, const PositionMap& globalPositions) const;
   void fill_split_chains(const keyList& chain, const keyList& keylinks, const PositionMap& globalPositions, int& nchains) const;
@@ -224,10 +253,15 @@ class PHCASeeding : public PHTrackSeeding
   std::pair<PositionMap, keyListPerLayer> FillGlobalPositions();
   std::pair<keyLinks, keyLinkPerLayer> CreateBiLinks(const PositionMap& globalPositions, const keyListPerLayer& ckeys);
   PHCASeeding::keyLists FollowBiLinks(const keyLinks& trackSeedPairs, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions) const;
-  std::vector<coordKey> FillTree(bgi::rtree<pointKey, bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer);
+  /// chains grown from one start link, per round of seed splitting
+  std::vector<keyLists> GrowSeeds(const keyLink& startLink, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions, int& nsplit_chains) const;
+  std::vector<coordKey> FillTree(bgi::rtree<pointKey, bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer) const;
+  std::vector<coordKey> FillGrid(TrkrPhiZGrid&, const keyList&, const PositionMap&, int layer) const;
   int FindSeedsWithMerger(const PositionMap&, const keyListPerLayer&);
 
   void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>>& rtree, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
+  /// query the rtree or the grid of a layer, depending on _use_grid_index
+  void QueryLayer(int layer_index, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
   std::vector<TrackSeed_v2> RemoveBadClusters(const std::vector<keyList>& seeds, const PositionMap& globalPositions) const;
   double getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b, TrkrDefs::cluskey c, const PositionMap& globalPositions) const;
 
@@ -257,6 +291,7 @@ class PHCASeeding : public PHTrackSeeding
   double _rz_outlier_threshold = 0.1;
   double _xy_outlier_threshold = 0.1;
   bool _split_seeds = true;
+  bool _use_grid_index = false;
   bool _reject_zsize1 = false;
   bool _use_fixed_clus_err = false;
   bool _pp_mode = false;
@@ -269,11 +304,15 @@ class PHCASeeding : public PHTrackSeeding
   TpcGlobalPositionWrapper m_globalPositionWrapper;
 
   std::unique_ptr<PHTimer> t_seed;
-  std::unique_ptr<PHTimer> t_fill;
   std::unique_ptr<PHTimer> t_makebilinks;
   std::unique_ptr<PHTimer> t_makeseeds;
-  /* std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees; */
-  std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, 3> _rtrees;  // need three layers at a time
+  // one tree per layer, so that the layers can be linked independently
+  std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees;
+  std::array<TrkrPhiZGrid, _NLAYERS_TPC> _grids;
+
+  unsigned int m_num_threads = 0;
+
+  SeedingStatistics m_statistics;
 
   double Ne_frac = 0.00;
   double Ar_frac = 0.75;
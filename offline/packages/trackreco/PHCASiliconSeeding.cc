@@ -282,6 +282,39 @@ std::vector<PHCASiliconSeeding::coordKey> PHCASiliconSeeding::FillTree(bgi::rtre
   return coords;
 }
 
+std::vector<PHCASiliconSeeding::coordKey> PHCASiliconSeeding::FillGrid(TrkrPhiZGrid& grid, const PHCASiliconSeeding::keyList& ckeys, const PHCASiliconSeeding::PositionMap& globalPositions, const int layer)
+{
+  // Add the clusters in ckeys to grid and return a vector of the coordKeys, as FillTree.
+  // The grid is binned by the caller once all its clusters are added
+  std::vector<coordKey> coords;
+  for (const auto& ckey : ckeys)
+  {
+    const auto& globalpos_d = globalPositions.at(ckey);
+    const double clus_phi = get_phi(globalpos_d);
+    const double clus_z = globalpos_d.z();
+    coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
+    grid.add(clus_phi, clus_z, ckey);
+  }
+  if (Verbosity() > 5)
+  {
+    std::cout << "nhits in layer(" << layer << "): " << coords.size() << std::endl;
+  }
+  return coords;
+}
+
+void PHCASiliconSeeding::QueryLayer(size_t l_index, double phimin, double z_min, double phimax, double z_max, std::vector<pointKey>& returned_values) const
+{
+  if (_use_grid_index)
+  {
+    _grids[l_index].query(phimin, z_min, phimax, z_max, [&returned_values](const TrkrPhiZGrid::Entry& entry)
+                          { returned_values.emplace_back(point(entry.phi, entry.z), entry.key); });
+  }
+  else
+  {
+    QueryTree(_rtrees[l_index], phimin, z_min, phimax, z_max, returned_values);
+  }
+}
+
 int PHCASiliconSeeding::Process(PHCompositeNode* /*topNode*/)
 {
   if (Verbosity() > 3)
@@ -316,6 +349,10 @@ int PHCASiliconSeeding::Process(PHCompositeNode* /*topNode*/)
   {
     rtree.clear();
   }
+  for (auto& grid : _grids)
+  {
+    grid.clear();
+  }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -448,6 +485,20 @@ std::vector<std::vector<PHCASiliconSeeding::Triplet>> PHCASiliconSeeding::Create
 
   std::vector<std::vector<coordKey>> clusterdata;
 
+  // fill the rtree or the grid of a layer index
+  if (_use_grid_index)
+  {
+    _grids.resize(_end_layer - _start_layer + 1);
+    for (auto& grid : _grids)
+    {
+      grid.clear();
+    }
+  }
+  auto fill_layer = [&](size_t index, const keyList& keys, int layer)
+  {
+    return _use_grid_index ? FillGrid(_grids[index], keys, globalPositions, layer) : FillTree(_rtrees[index], keys, globalPositions, layer);
+  };
+
   for (size_t l = _start_layer; l <= _end_layer; l++)
   {
     const size_t l_index = l - _start_layer;
@@ -456,21 +507,34 @@ std::vector<std::vector<PHCASiliconSeeding::Triplet>> PHCASiliconSeeding::Create
     if (l == 4)
 
     {
-      const std::vector<coordKey> l4clusters = FillTree(_rtrees[3 - _start_layer], ckeys[4], globalPositions, 3);
+      const std::vector<coordKey> l4clusters = fill_layer(3 - _start_layer, ckeys[4], 3);
       clusterdata[3 - _start_layer].insert(clusterdata[3 - _start_layer].end(), l4clusters.begin(), l4clusters.end());
     }
     else if (l == 5)
     {
-      clusterdata.push_back(FillTree(_rtrees[4 - _start_layer], ckeys[5], globalPositions, 4));
+      clusterdata.push_back(fill_layer(4 - _start_layer, ckeys[5], 4));
     }
     else if (l == 6)
     {
-      const std::vector<coordKey> l6clusters = FillTree(_rtrees[4 - _start_layer], ckeys[6], globalPositions, 4);
+      const std::vector<coordKey> l6clusters = fill_layer(4 - _start_layer, ckeys[6], 4);
       clusterdata[4 - _start_layer].insert(clusterdata[4 - _start_layer].end(), l6clusters.begin(), l6clusters.end());
     }
     else
     {
-      clusterdata.push_back(FillTree(_rtrees[l_index], ckeys[l], globalPositions, l));
+      clusterdata.push_back(fill_layer(l_index, ckeys[l], l));
+    }
+  }
+
+  if (_use_grid_index)
+  {
+    // the INTT layers are filled twice, bin the grids once all clusters are in
+    for (size_t l_index = 0; l_index < _grids.size(); ++l_index)
+    {
+      // bins of about the size of the search windows
+      const size_t l = std::min<size_t>(l_index + _start_layer, radius_per_layer.size() - 1);
+      const float dr = (l + 1 < radius_per_layer.size()) ? radius_per_layer[l + 1] - radius_per_layer[l] : radius_per_layer[l] - radius_per_layer[l - 1];
+      _grids[l_index].set_bin_size(2 * dphi_per_layer[l], 2 * std::abs(dr) / _drdz_allowance);
+      _grids[l_index].build();
     }
   }
 
@@ -504,12 +568,12 @@ std::vector<std::vector<PHCASiliconSeeding::Triplet>> PHCASiliconSeeding::Create
       float center_radius_below = (l - 1 < 3) ? GetMvtxRadiusByPhi(centerPhi, l - 1) : radius_per_layer.at(l - 1);
       const float dZwindow_below = (center_radius - center_radius_below) * (1. / _drdz_allowance);
 
-      QueryTree(_rtrees[l_index - 1],
-                centerPhi - dphiwindow_below,
-                centerZ - dZwindow_below,
-                centerPhi + dphiwindow_below,
-                centerZ + dZwindow_below,
-                clustersBelow);
+      QueryLayer(l_index - 1,
+                 centerPhi - dphiwindow_below,
+                 centerZ - dZwindow_below,
+                 centerPhi + dphiwindow_below,
+                 centerZ + dZwindow_below,
+                 clustersBelow);
 
       if (l_index > 1)
       {
@@ -517,22 +581,22 @@ std::vector<std::vector<PHCASiliconSeeding::Triplet>> PHCASiliconSeeding::Create
         const float center_radius_2below = (l - 2 < 3) ? GetMvtxRadiusByPhi(centerPhi, l - 2) : radius_per_layer.at(l - 2);
         const float dZwindow_2below = (center_radius - center_radius_2below) * (1. / _drdz_allowance);
 
-        QueryTree(_rtrees[l_index - 2],
-                  centerPhi - dphiwindow_below - dphiwindow_2below,
-                  centerZ - dZwindow_below - dZwindow_2below,
-                  centerPhi + dphiwindow_below + dphiwindow_2below,
-                  centerZ + dZwindow_below + dZwindow_2below,
-                  clustersBelow);
+        QueryLayer(l_index - 2,
+                   centerPhi - dphiwindow_below - dphiwindow_2below,
+                   centerZ - dZwindow_below - dZwindow_2below,
+                   centerPhi + dphiwindow_below + dphiwindow_2below,
+                   centerZ + dZwindow_below + dZwindow_2below,
+                   clustersBelow);
       }
 
       const float center_radius_above = (l + 1 < 3) ? GetMvtxRadiusByPhi(centerPhi, l + 1) : radius_per_layer.at(l + 1);
       const float dZwindow_above = (center_radius_above - center_radius) * (1. / _drdz_allowance);
-      QueryTree(_rtrees[l_index + 1],
-                centerPhi - dphiwindow_above,
-                centerZ - dZwindow_above,
-                centerPhi + dphiwindow_above,
-                centerZ + dZwindow_above,
-                clustersAbove);
+      QueryLayer(l_index + 1,
+                 centerPhi - dphiwindow_above,
+                 centerZ - dZwindow_above,
+                 centerPhi + dphiwindow_above,
+                 centerZ + dZwindow_above,
+                 clustersAbove);
 
       if (l_index < 3)
       {
@@ -540,12 +604,12 @@ std::vector<std::vector<PHCASiliconSeeding::Triplet>> PHCASiliconSeeding::Create
         const float center_radius_2above = (l + 2 < 3) ? GetMvtxRadiusByPhi(centerPhi, l + 2) : radius_per_layer.at(l + 2);
         const float dZwindow_2above = (center_radius_2above - center_radius) * (1. / _drdz_allowance);
 
-        QueryTree(_rtrees[l_index + 2],
-                  centerPhi - dphiwindow_above - dphiwindow_2above,
-                  centerZ - dZwindow_above - dZwindow_2above,
-                  centerPhi + dphiwindow_above + dphiwindow_2above,
-                  centerZ + dZwindow_above + dZwindow_2above,
-                  clustersAbove);
+        QueryLayer(l_index + 2,
+                   centerPhi - dphiwindow_above - dphiwindow_2above,
+                   centerZ - dZwindow_above - dZwindow_2above,
+                   centerPhi + dphiwindow_above + dphiwindow_2above,
+                   centerZ + dZwindow_above + dZwindow_2above,
+                   clustersAbove);
       }
 
       if (Verbosity() > 3)
@@ -1033,12 +1097,12 @@ void PHCASiliconSeeding::HelixPropagate(std::vector<TrackSeed_v2>& seeds, const
         std::cout << "HelixPropagate to layer " << layer << " with z_window " << z_window << std::endl;
       }
 
-      QueryTree(_rtrees[l_index],
-                phi_min - dphi_per_layer[layer],
-                z_min - z_window,
-                phi_max + dphi_per_layer[layer],
-                z_max + z_window,
-                closeClusters);
+      QueryLayer(l_index,
+                 phi_min - dphi_per_layer[layer],
+                 z_min - z_window,
+                 phi_max + dphi_per_layer[layer],
+                 z_max + z_window,
+                 closeClusters);
 
       if (Verbosity() > 3)
       {
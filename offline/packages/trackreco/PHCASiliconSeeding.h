@@ -13,6 +13,7 @@
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/TrkrClusterCrossingAssoc.h>
 #include <trackbase/TrkrDefs.h>  // for cluskey
+#include <trackbase/TrkrPhiZGrid.h>
 
 #include <g4detectors/PHG4CylinderGeom.h>
 #include <g4detectors/PHG4CylinderGeomContainer.h>
@@ -120,6 +121,11 @@ class PHCASiliconSeeding : public PHTrackSeeding
   {
     _module_trackmap_name = trackmap_name;
   }
+  /// search neighbor clusters in binned (phi, z) grids instead of boost rtrees
+  void SetUseGridIndex(bool opt = true)
+  {
+    _use_grid_index = opt;
+  }
   void Identify() const
   {
     std::cout << "----- Configuration parameters -----" << std::endl;
@@ -137,6 +143,7 @@ class PHCASiliconSeeding : public PHTrackSeeding
     std::cout << " - Minimum MVTX clusters: " << _min_mvtx_clusters << std::endl;
     std::cout << " - Minimum INTT clusters: " << _min_intt_clusters << std::endl;
     std::cout << " - Track Map Name: " << _module_trackmap_name << std::endl;
+    std::cout << " - Use grid index: " << (_use_grid_index ? "true" : "false") << std::endl;
     std::cout << "------------------------------------" << std::endl;
   }
 
@@ -167,6 +174,7 @@ class PHCASiliconSeeding : public PHTrackSeeding
   float _max_cos_angle = -0.95;
   bool _use_best = true;
   bool _require_INTT_consistency = true;
+  bool _use_grid_index = false;
 
   std::array<float, 55> dphi_per_layer{};
   std::array<float, 55> max_dcaxy_perlayer{};
@@ -192,9 +200,12 @@ class PHCASiliconSeeding : public PHTrackSeeding
   std::vector<std::vector<Triplet>> CreateLinks(const PHCASiliconSeeding::PositionMap& globalPositions, const PHCASiliconSeeding::keyListPerLayer& ckeys);
   std::vector<keyList> FollowLinks(const std::vector<std::vector<Triplet>>& triplets);
   std::vector<coordKey> FillTree(bgi::rtree<pointKey, bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer);
+  std::vector<coordKey> FillGrid(TrkrPhiZGrid&, const keyList&, const PositionMap&, int layer);
   int FindSeeds(const PositionMap&, const keyListPerLayer&);
 
   void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>>& rtree, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
+  /// query the rtree or the grid of a layer, depending on _use_grid_index
+  void QueryLayer(size_t l_index, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
   float getSeedQuality(const TrackSeed_v2& seed, const PositionMap& globalPositions) const;
   void HelixPropagate(std::vector<TrackSeed_v2>& seeds, const PositionMap& globalPositions) const;
   void FitSeed(TrackSeed_v2& seed, const PositionMap& globalPositions) const;
@@ -228,6 +239,7 @@ class PHCASiliconSeeding : public PHTrackSeeding
   std::string _module_trackmap_name = "SiliconTrackSeedContainer";
 
   std::vector<bgi::rtree<pointKey, bgi::quadratic<16>>> _rtrees;  // need three layers at a time
+  std::vector<TrkrPhiZGrid> _grids;
 };
 
 #endif
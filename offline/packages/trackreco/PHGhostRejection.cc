@@ -13,11 +13,139 @@
 #include <trackbase_historic/TrackSeedContainer.h>
 #include <trackbase_historic/TrackSeedHelper.h>
 
-#include <cmath>     // for sqrt, fabs, atan2, cos
-#include <iostream>  // for operator<<, basic_ostream
-#include <map>       // for map
-#include <set>       // for _Rb_tree_const_iterator
-#include <utility>   // for pair, make_pair
+#include <algorithm>  // for sort, unique, is_sorted
+#include <cmath>      // for sqrt, fabs, atan2, cos
+#include <iostream>   // for operator<<, basic_ostream
+#include <map>        // for map
+#include <set>        // for _Rb_tree_const_iterator
+#include <utility>    // for pair, make_pair
+
+namespace
+{
+  // seeds binned in (phi, eta), with bins larger than the phi and eta cuts,
+  // so that the seeds passing the cuts are in the same or in neighbouring bins
+  class SeedBins
+  {
+   public:
+    SeedBins(const std::vector<float>& phi, const std::vector<float>& eta, const std::vector<unsigned int>& ids, double phi_cut, double eta_cut)
+    {
+      // ranges of the binned seeds
+      for (const auto id : ids)
+      {
+        m_phi.extend(phi[id]);
+        m_eta.extend(eta[id]);
+      }
+
+      // bins at least as large as the cuts, plus a margin for rounding,
+      // and not many more bins than seeds
+      unsigned int nphi = m_phi.nbins(phi_cut);
+      unsigned int neta = m_eta.nbins(eta_cut);
+      const size_t max_bins = 4 * ids.size() + 16;
+      if (static_cast<size_t>(nphi) * neta > max_bins)
+      {
+        const double scale = std::sqrt(static_cast<double>(nphi) * neta / max_bins);
+        nphi = std::max(1U, static_cast<unsigned int>(nphi / scale));
+        neta = std::max(1U, static_cast<unsigned int>(neta / scale));
+      }
+      m_phi.set_nbins(nphi);
+      m_eta.set_nbins(neta);
+
+      // counting sort, seeds stay ordered by id within a bin
+      m_offsets.assign(static_cast<size_t>(nphi) * neta + 1, 0);
+      for (const auto id : ids)
+      {
+        ++m_offsets[bin(phi[id], eta[id]) + 1];
+      }
+      for (size_t ibin = 1; ibin < m_offsets.size(); ++ibin)
+      {
+        m_offsets[ibin] += m_offsets[ibin - 1];
+      }
+      m_ids.resize(ids.size());
+      std::vector<unsigned int> next(m_offsets.begin(), m_offsets.end() - 1);
+      for (const auto id : ids)
+      {
+        m_ids[next[bin(phi[id], eta[id])]++] = id;
+      }
+    }
+
+    bool empty() const { return m_ids.empty(); }
+
+    // phi range of the binned seeds
+    double phi_range() const { return m_phi.max - m_phi.min; }
+
+    // append the seeds in the bin of (phi, eta) and in the neighbouring bins
+    void append_neighbours(double phi, double eta, std::vector<unsigned int>& ids) const
+    {
+      const unsigned int iphi = m_phi.bin(phi);
+      const unsigned int ieta = m_eta.bin(eta);
+      const unsigned int eta_first = ieta > 0 ? ieta - 1 : 0;
+      const unsigned int eta_last = std::min(ieta + 1, m_eta.n - 1);
+      for (unsigned int jphi = (iphi > 0 ? iphi - 1 : 0); jphi <= std::min(iphi + 1, m_phi.n - 1); ++jphi)
+      {
+        // the eta bins of one phi bin are contiguous
+        const size_t row = static_cast<size_t>(jphi) * m_eta.n;
+        ids.insert(ids.end(), m_ids.begin() + m_offsets[row + eta_first], m_ids.begin() + m_offsets[row + eta_last + 1]);
+      }
+    }
+
+   private:
+    struct Axis
+    {
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::lowest();
+      double size = 1;
+      unsigned int n = 1;
+
+      void extend(double value)
+      {
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+
+      // number of bins of size larger than cut, at most 1024
+      unsigned int nbins(double cut) const
+      {
+        const double bins = (max - min) / (cut * 1.001);
+        if (!(bins >= 1))
+        {
+          return 1;
+        }
+        return bins >= 1024 ? 1024 : static_cast<unsigned int>(bins);
+      }
+
+      void set_nbins(unsigned int nbins)
+      {
+        n = nbins;
+        size = max > min ? (max - min) / n : 1;
+      }
+
+      // values outside of the range go to the first or last bin
+      unsigned int bin(double value) const
+      {
+        const double ibin = std::floor((value - min) / size);
+        if (ibin <= 0)
+        {
+          return 0;
+        }
+        return ibin >= n - 1 ? n - 1 : static_cast<unsigned int>(ibin);
+      }
+    };
+
+    size_t bin(double phi, double eta) const
+    {
+      return static_cast<size_t>(m_phi.bin(phi)) * m_eta.n + m_eta.bin(eta);
+    }
+
+    Axis m_phi;
+    Axis m_eta;
+
+    // first seed of each bin, plus the end of the last bin
+    std::vector<unsigned int> m_offsets;
+
+    // seed ids sorted by bin
+    std::vector<unsigned int> m_ids;
+  };
+}  // namespace
 
 //____________________________________________________________________________..
 bool PHGhostRejection::cut_from_clusters(int itrack) {
@@ -101,28 +229,65 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
     }
   }
 
+  // seed parameters used in the pair search, computed once per seed.
+  // Seeds with non finite phi or eta fail the cuts and are not binned
+  std::vector<float> seed_phi(seeds.size());
+  std::vector<float> seed_eta(seeds.size());
+  std::vector<Acts::Vector3> seed_pos(seeds.size());
+  std::vector<unsigned int> binned_ids;
+  for (unsigned int trid = 0; trid < seeds.size(); ++trid)
+  {
+    if (m_rejected[trid]) { continue; }
+    const auto& track = seeds[trid];
+    seed_phi[trid] = track.get_phi();
+    seed_eta[trid] = track.get_eta();
+    seed_pos[trid] = TrackSeedHelper::get_xyz(&track);
+    if (std::isfinite(seed_phi[trid]) && std::isfinite(seed_eta[trid]))
+    {
+      binned_ids.push_back(trid);
+    }
+  }
+
+  // only seeds in neighbouring (phi, eta) bins are compared
+  const SeedBins bins(seed_phi, seed_eta, binned_ids, _phi_cut, _eta_cut);
+
+  // the phi cut subtracts 2 pi from differences larger than 2 pi,
+  // such pairs are only possible if the seeds span more than 2 pi in phi
+  const bool wrap_phi = !bins.empty() && bins.phi_range() > 2 * M_PI;
+
   // Elimate low-interest track, and try to eliminate repeated tracks
   std::set<unsigned int> matches_set;
   std::multimap<unsigned int, unsigned int> matches;
-  for (size_t trid1 = 0; trid1 < seeds.size(); ++trid1)
+  std::vector<unsigned int> candidates;
+  for (const auto trid1 : binned_ids)
   {
-    if (m_rejected[trid1]) { continue; }
-    const auto& track1 = seeds[trid1];
-    const float track1phi = track1.get_phi();
+    const float track1phi = seed_phi[trid1];
+    const auto& track1_pos = seed_pos[trid1];
+    const float track1eta = seed_eta[trid1];
 
-    const auto track1_pos = TrackSeedHelper::get_xyz(&track1);
-    const float track1eta = track1.get_eta();
-    for (size_t trid2 = trid1+1; trid2 < seeds.size(); ++trid2)
+    candidates.clear();
+    bins.append_neighbours(track1phi, track1eta, candidates);
+    if (wrap_phi)
     {
-      if (m_rejected[trid2])
-      {
-        continue;
-      }
+      bins.append_neighbours(track1phi + 2 * M_PI, track1eta, candidates);
+      bins.append_neighbours(track1phi - 2 * M_PI, track1eta, candidates);
+    }
 
-      const auto& track2 = seeds[trid2];
-      const auto track2_pos = TrackSeedHelper::get_xyz(&track2);
-      const float track2eta = track2.get_eta();
-      auto delta_phi = std::abs(track1phi - track2.get_phi());
+    // keep the pairs in the same order as a loop over all seeds
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [trid1](unsigned int trid)
+                                    { return trid <= trid1; }),
+                     candidates.end());
+    if (!std::is_sorted(candidates.begin(), candidates.end()))
+    {
+      std::sort(candidates.begin(), candidates.end());
+    }
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (const auto trid2 : candidates)
+    {
+      const auto& track2_pos = seed_pos[trid2];
+      const float track2eta = seed_eta[trid2];
+      auto delta_phi = std::abs(track1phi - seed_phi[trid2]);
 
       if (delta_phi > 2 * M_PI) {
         delta_phi = delta_phi - 2*M_PI;
@@ -149,7 +314,7 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
     if (m_rejected[set_it]) { continue; } // already rejected
     auto match_list = matches.equal_range(set_it);
 
-    auto tr1 = seeds[set_it];
+    const auto& tr1 = seeds[set_it];
     double best_qual = trackChi2.at(set_it);
     unsigned int best_track = set_it;
 
@@ -158,6 +323,9 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
       std::cout << " ****** start checking track " << set_it << " with best quality " << best_qual << " best_track " << best_track << std::endl;
     }
 
+    // cluster keys of tr1, for the shared cluster count with all its matches
+    const std::unordered_set<TrkrDefs::cluskey> tr1_keys(tr1.begin_cluster_keys(), tr1.end_cluster_keys());
+
     for (auto it = match_list.first; it != match_list.second; ++it)
     {
       if (m_verbosity > 1)
@@ -165,10 +333,10 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
         std::cout << "    match of track " << it->first << " to track " << it->second << std::endl;
       }
 
-      auto tr2 = seeds[it->second];
+      const auto& tr2 = seeds[it->second];
 
       // Check that these two tracks actually share the same clusters, if not skip this pair
-      bool is_same_track = checkClusterSharing(tr1, tr2);
+      bool is_same_track = checkClusterSharing(tr1.size_cluster_keys(), tr1_keys, tr2);
       if (!is_same_track)
       {
         continue;
@@ -236,17 +404,22 @@ void PHGhostRejection::find_ghosts(const std::vector<float>& trackChi2)
 
 // there is no check, at this point, about which is the best chi2 track
 bool PHGhostRejection::checkClusterSharing(const TrackSeed& tr1, const TrackSeed& tr2) const
+{
+  const std::unordered_set<TrkrDefs::cluskey> keys_tr1(tr1.begin_cluster_keys(), tr1.end_cluster_keys());
+  return checkClusterSharing(tr1.size_cluster_keys(), keys_tr1, tr2);
+}
+
+bool PHGhostRejection::checkClusterSharing(size_t nclus_tr1, const std::unordered_set<TrkrDefs::cluskey>& keys_tr1, const TrackSeed& tr2) const
 {
   // count shared clusters that tr1 and tr2 share many clusters
-  size_t nclus_tr1 = tr1.size_cluster_keys();
   size_t nclus_tr2 = tr2.size_cluster_keys();
   size_t n_shared_clus = 0;
 
-  for (auto key_tr1 = tr1.begin_cluster_keys();
-       key_tr1 != tr1.end_cluster_keys();
-       ++key_tr1)
+  for (auto key_tr2 = tr2.begin_cluster_keys();
+       key_tr2 != tr2.end_cluster_keys();
+       ++key_tr2)
   {
-    if (tr2.find_cluster_key(*key_tr1) != tr2.end_cluster_keys())
+    if (keys_tr1.count(*key_tr2))
     {
       ++n_shared_clus;
     }
@@ -16,8 +16,10 @@
 #include <trackbase_historic/TrackSeed_v2.h>
 
 
+#include <limits>
 #include <map>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 class PHCompositeNode;
@@ -59,6 +61,9 @@ class PHGhostRejection
   void set_z_cut(double d) { _z_cut = d; }
 
  private:
+  // same as above, with the cluster keys of tr1 in a hash set, to check one track against several others
+  bool checkClusterSharing(size_t nclus_tr1, const std::unordered_set<TrkrDefs::cluskey>& keys_tr1, const TrackSeed& tr2) const;
+
   unsigned int m_verbosity;
   const std::vector<TrackSeed_v2>& seeds;
   std::vector<bool> m_rejected {}; // id
@@ -8,6 +8,7 @@
 #include <trackbase/TrkrClusterCrossingAssoc.h>
 #include <trackbase/TrkrClusterv3.h>
 #include <trackbase/TrkrDefs.h>  // for cluskey, getTrkrId, tpcId
+#include <trackbase/TrkrThreadPool.h>
 
 #include <trackbase_historic/SvtxTrackSeed_v2.h>
 #include <trackbase_historic/TrackSeedContainer_v1.h>
@@ -32,15 +33,25 @@
 #include <TFile.h>
 #include <TNtuple.h>
 
-#include <climits>   // for UINT_MAX
-#include <cmath>     // for fabs, sqrt
-#include <iostream>  // for operator<<, basic_ostream
+#include <algorithm>  // for sort
+#include <climits>    // for UINT_MAX
+#include <cmath>      // for fabs, sqrt
+#include <iostream>   // for operator<<, basic_ostream
 #include <memory>
 #include <set>      // for _Rb_tree_const_iterator
 #include <utility>  // for pair
 
 using namespace std;
 
+namespace
+{
+  // phi in [0, 2pi), for the silicon seed index
+  double wrap_phi(double phi)
+  {
+    return phi - 2 * M_PI * std::floor(phi / (2 * M_PI));
+  }
+}  // namespace
+
 //____________________________________________________________________________..
 PHSiliconTpcTrackMatching::PHSiliconTpcTrackMatching(const std::string &name)
   : SubsysReco(name)
@@ -174,6 +185,28 @@ bool PHSiliconTpcTrackMatching::WindowMatcher::in_window
   }
 }
 
+std::pair<double, double> PHSiliconTpcTrackMatching::WindowMatcher::delta_range
+(const bool posQ, const double tpc_pt)
+{
+  if (posQ) {
+    double pt = (tpc_pt<min_pt_posQ) ? min_pt_posQ : tpc_pt;
+    const double hi = fn_exp(posHi, posHi_b0, pt);
+    if (fabs_max_posQ) {
+      return {-hi, hi};
+    } else {
+      return {fn_exp(posLo, posLo_b0, pt), hi};
+    }
+  } else {
+    double pt = (tpc_pt<min_pt_negQ) ? min_pt_negQ : tpc_pt;
+    const double hi = fn_exp(negHi, negHi_b0, pt);
+    if (fabs_max_negQ) {
+      return {-hi, hi};
+    } else {
+      return {fn_exp(negLo, negLo_b0, pt), hi};
+    }
+  }
+}
+
 //____________________________________________________________________________..
 int PHSiliconTpcTrackMatching::process_event(PHCompositeNode * /*unused*/)
 {
@@ -467,220 +500,300 @@ void PHSiliconTpcTrackMatching::findEtaPhiMatches(
     std::set<unsigned int> &tpc_unmatched_set,
     std::multimap<unsigned int, unsigned int> &tpc_matches)
 {
-  // loop over the TPC track seeds
-  for (unsigned int phtrk_iter = 0;
-       phtrk_iter < _track_map->size();
-       ++phtrk_iter)
+  // project the silicon seeds once, and index them in (phi, eta)
+  // seeds with non finite phi or eta never pass the windows and are not indexed
+  _silicon_seed_params.assign(_track_map_silicon->size(), SeedParameters());
+  _silicon_grid.clear();
+  for (unsigned int siid = 0; siid < _track_map_silicon->size(); ++siid)
   {
-    _tracklet_tpc = _track_map->get(phtrk_iter);
-    if (!_tracklet_tpc)
+    TrackSeed *si_seed = _track_map_silicon->get(siid);
+    if (!si_seed)
     {
       continue;
     }
-
-    unsigned int tpcid = phtrk_iter;
-    if (Verbosity() > 1)
+    auto &si = _silicon_seed_params[siid];
+    si = getSeedParameters(si_seed);
+    if (si.valid && std::isfinite(si.phi) && std::isfinite(si.eta))
     {
-      std::cout
-          << __LINE__
-          << ": Processing seed itrack: " << tpcid
-          << ": nhits: " << _tracklet_tpc->size_cluster_keys()
-          << ": Total tracks: " << _track_map->size()
-          << ": phi: " << _tracklet_tpc->get_phi()
-          << endl;
+      _silicon_grid.add(wrap_phi(si.phi), si.eta, siid);
     }
+  }
 
-    double tpc_phi, tpc_eta, tpc_pt;
-    float tpc_px, tpc_py, tpc_pz;
-    int tpc_q;
-    Acts::Vector3 tpc_pos;
-    if (_zero_field) {
-      auto cluster_list = getTrackletClusterList(_tracklet_tpc);
+  // bins of about the window sizes at 1 GeV
+  const auto [dphi_lo_ref, dphi_hi_ref] = window_dphi.delta_range(true, 1.);
+  const auto [deta_lo_ref, deta_hi_ref] = window_deta.delta_range(true, 1.);
+  _silicon_grid.set_bin_size(dphi_hi_ref - dphi_lo_ref, deta_hi_ref - deta_lo_ref);
+  _silicon_grid.build();
 
-      Acts::Vector3  mom;
-      bool ok_track;
+  // per thread match lists, merged in TPC seed order below
+  auto &pool = TrkrThreadPool::instance();
+  pool.reserve_threads(m_num_threads);
+  const unsigned int nbuffers = pool.nbuffers();
+  std::vector<std::vector<std::pair<unsigned int, unsigned int>>> thread_matches(nbuffers);
+  std::vector<std::vector<unsigned int>> thread_unmatched(nbuffers);
+  std::vector<std::vector<unsigned int>> thread_candidates(nbuffers);
 
-      std::tie(ok_track, tpc_phi, tpc_eta, tpc_pt, tpc_pos, mom) =
-        TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
-      if (!ok_track) { continue; }
-      tpc_px = mom.x();
-      tpc_py = mom.y();
-      tpc_pz = mom.z();
-      tpc_q = -100;
-    } else {
-      tpc_phi = _tracklet_tpc->get_phi();
-      tpc_eta = _tracklet_tpc->get_eta();
-      tpc_pt = fabs(1. / _tracklet_tpc->get_qOverR()) * (0.3 / 100.) * fieldstrength;
+  // loop over the TPC track seeds
+  pool.parallel_for(
+      _track_map->size(),
+      [&](std::size_t phtrk_iter, unsigned int worker)
+      {
+        TrackSeed *tpc_seed = _track_map->get(phtrk_iter);
+        if (!tpc_seed)
+        {
+          return;
+        }
 
-      tpc_pos = TrackSeedHelper::get_xyz(_tracklet_tpc);
+        unsigned int tpcid = phtrk_iter;
+        if (Verbosity() > 1)
+        {
+          std::cout
+              << __LINE__
+              << ": Processing seed itrack: " << tpcid
+              << ": nhits: " << tpc_seed->size_cluster_keys()
+              << ": Total tracks: " << _track_map->size()
+              << ": phi: " << tpc_seed->get_phi()
+              << endl;
+        }
 
-      tpc_px = _tracklet_tpc->get_px();
-      tpc_py = _tracklet_tpc->get_py();
-      tpc_pz = _tracklet_tpc->get_pz();
+        const SeedParameters tpc = getSeedParameters(tpc_seed);
+        if (!tpc.valid)
+        {
+          return;
+        }
 
-      tpc_q = _tracklet_tpc->get_charge();
-    }
+        bool is_posQ = (tpc.q > 0.);
 
-    bool is_posQ = (tpc_q>0.);
+        if (Verbosity() > 8)
+        {
+          std::cout << " tpc stub: " << tpcid << " eta " << tpc.eta << " phi " << tpc.phi << " pt " << tpc.pt << " tpc z " << TrackSeedHelper::get_z(tpc_seed) << std::endl;
+        }
 
-    if (Verbosity() > 8)
-    {
-      std::cout << " tpc stub: " << tpcid << " eta " << tpc_eta << " phi " << tpc_phi << " pt " << tpc_pt << " tpc z " << TrackSeedHelper::get_z(_tracklet_tpc) << std::endl;
-    }
+        if (Verbosity() > 3)
+        {
+          cout << "TPC tracklet:" << endl;
+          tpc_seed->identify();
+        }
 
-    if (Verbosity() > 3)
-    {
-      cout << "TPC tracklet:" << endl;
-      _tracklet_tpc->identify();
-    }
+        // silicon seeds within the eta and phi windows, si_X in [tpc_X - delta_hi, tpc_X - delta_lo]
+        auto [dphi_lo, dphi_hi] = window_dphi.delta_range(is_posQ, tpc.pt);
+        auto [deta_lo, deta_hi] = window_deta.delta_range(is_posQ, tpc.pt);
+        deta_lo = std::min<double>(deta_lo, -_deltaeta_min);
+        deta_hi = std::max<double>(deta_hi, _deltaeta_min);
+
+        auto &candidates = thread_candidates[worker];
+        candidates.clear();
+        if (_test_windows || !std::isfinite(tpc.phi) || !std::isfinite(tpc.eta) ||
+            !std::isfinite(dphi_lo) || !std::isfinite(dphi_hi) || !std::isfinite(deta_lo) || !std::isfinite(deta_hi))
+        {
+          // the test ntuple has all pairs, windows which cannot be binned test all seeds
+          for (unsigned int siid = 0; siid < _track_map_silicon->size(); ++siid)
+          {
+            candidates.push_back(siid);
+          }
+        }
+        else
+        {
+          // widen the search for the rounding of the indexed values
+          const double phi_margin = 1e-5 * (1 + std::abs(tpc.phi) + dphi_hi - dphi_lo);
+          const double eta_margin = 1e-5 * (1 + std::abs(tpc.eta) + deta_hi - deta_lo);
+          double phimin = wrap_phi(tpc.phi) - dphi_hi - phi_margin;
+          double phimax = wrap_phi(tpc.phi) - dphi_lo + phi_margin;
+          if (phimax - phimin >= 2 * M_PI)
+          {
+            phimin = 0;
+            phimax = 2 * M_PI;
+          }
+          _silicon_grid.query(phimin, tpc.eta - deta_hi - eta_margin, phimax, tpc.eta - deta_lo + eta_margin,
+                              [&candidates](const TrkrPhiZGrid::Entry &entry)
+                              { candidates.push_back(static_cast<unsigned int>(entry.key)); });
+
+          // test the candidates in the same order as a loop over all seeds
+          std::sort(candidates.begin(), candidates.end());
+        }
 
+        bool matched = false;
 
-    bool matched = false;
+        // Now search the silicon track list for a match in eta and phi
+        for (const auto siid : candidates)
+        {
+          const auto &si = _silicon_seed_params[siid];
+          if (!si.valid)
+          {
+            continue;
+          }
+          if (matchSeeds(tpcid, tpc_seed, tpc, siid, _track_map_silicon->get(siid), si))
+          {
+            matched = true;
+            thread_matches[worker].emplace_back(tpcid, siid);
+          }
+        }
 
-    // Now search the silicon track list for a match in eta and phi
-    for (unsigned int phtrk_iter_si = 0;
-         phtrk_iter_si < _track_map_silicon->size();
-         ++phtrk_iter_si)
+        // if no match found, keep tpc seed for fitting
+        if (!matched)
+        {
+          if (Verbosity() > 1)
+          {
+            cout << "inserted unmatched tpc seed " << tpcid << endl;
+          }
+          thread_unmatched[worker].push_back(tpcid);
+        }
+      },
+      m_num_threads == 0 || _test_windows || Verbosity() > 1);
+
+  // all matches of a TPC seed are in one list, in silicon seed order
+  for (unsigned int worker = 0; worker < nbuffers; ++worker)
+  {
+    for (const auto &[tpcid, siid] : thread_matches[worker])
     {
-      _tracklet_si = _track_map_silicon->get(phtrk_iter_si);
-      if (!_tracklet_si)
-      {
+      tpc_matches.insert(std::make_pair(tpcid, siid));
+      tpc_matched_set.insert(tpcid);
+    }
+    tpc_unmatched_set.insert(thread_unmatched[worker].begin(), thread_unmatched[worker].end());
+  }
 
-        continue;
-      }
+  // checkZMatches uses the charge and qOverR of the last TPC seed, as left by the serial loop
+  _tracklet_tpc = _track_map->get(_track_map->size() - 1);
 
-      double si_phi, si_eta, si_pt;
-      float si_px, si_py, si_pz;
-      int si_q;
-      Acts::Vector3 si_pos;
-      if (_zero_field) {
-      auto cluster_list = getTrackletClusterList(_tracklet_si);
-
-      Acts::Vector3  mom;
-      bool ok_track;
-
-      std::tie(ok_track, si_phi, si_eta, si_pt, si_pos, mom) =
-        TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
-      if (!ok_track) { continue; }
-        si_px = mom.x();
-        si_py = mom.y();
-        si_pz = mom.z();
-        si_q = -100;
-      } else {
-        si_eta = _tracklet_si->get_eta();
-        si_phi = _tracklet_si->get_phi();
-
-        si_pos = TrackSeedHelper::get_xyz(_tracklet_si);
-        si_px = _tracklet_si->get_px();
-        si_py = _tracklet_si->get_py();
-        si_pz = _tracklet_si->get_pz();
-        si_q = _tracklet_si->get_charge();
-      }
-      int si_crossing = _tracklet_si->get_crossing();
-      unsigned int siid = phtrk_iter_si;
+  return;
+}
 
-      if(_test_windows)
-      {
-        float data[] = {
-          (float) m_event, (float) si_crossing,
-          (float) si_q, (float) si_phi, (float) si_eta, (float) si_pos.x(), (float) si_pos.y(), (float) si_pos.z(), (float) si_px, (float) si_py, (float) si_pz,
-          (float) tpc_q, (float) tpc_phi, (float) tpc_eta, (float) tpc_pos.x(), (float) tpc_pos.y(), (float) tpc_pos.z(), (float) tpc_px, (float) tpc_py, (float) tpc_pz,
-          (float) tpcid, (float) siid
-	};
-        _tree->Fill(data);
-      }
+PHSiliconTpcTrackMatching::SeedParameters PHSiliconTpcTrackMatching::getSeedParameters(TrackSeed *seed)
+{
+  SeedParameters params;
+  if (_zero_field) {
+    auto cluster_list = getTrackletClusterList(seed);
+
+    Acts::Vector3  mom;
+    bool ok_track;
+
+    std::tie(ok_track, params.phi, params.eta, params.pt, params.pos, mom) =
+      TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
+    if (!ok_track) { return params; }
+    params.px = mom.x();
+    params.py = mom.y();
+    params.pz = mom.z();
+    params.q = -100;
+  } else {
+    params.phi = seed->get_phi();
+    params.eta = seed->get_eta();
+    params.pt = fabs(1. / seed->get_qOverR()) * (0.3 / 100.) * fieldstrength;
 
-      bool eta_match = false;
-      if (window_deta.in_window(is_posQ, tpc_pt, tpc_eta, si_eta))
-      {
-        eta_match = true;
-      }
-      else if (fabs(tpc_eta-si_eta) < _deltaeta_min)
-      {
-	eta_match = true;
-      }
-      if (!eta_match)
-      {
-        continue;
-      }
+    params.pos = TrackSeedHelper::get_xyz(seed);
 
-      bool position_match = false;
-      if (window_dx.in_window(is_posQ, tpc_pt, tpc_pos.x(), si_pos.x())
-       && window_dy.in_window(is_posQ, tpc_pt, tpc_pos.y(), si_pos.y()))
-      {
-        position_match = true;
-      }
-      if (!position_match)
-      {
-        continue;
-      }
+    params.px = seed->get_px();
+    params.py = seed->get_py();
+    params.pz = seed->get_pz();
 
-      bool phi_match = false;
-      if (window_dphi.in_window(is_posQ, tpc_pt, tpc_phi, si_phi))
-      {
-        phi_match = true;
-        // if phi fails, account for case where |tpc_phi-si_phi|>PI
-      } else if (fabs(tpc_phi-si_phi)>M_PI) {
-        auto tpc_phi_wrap = tpc_phi;
-        if ((tpc_phi_wrap - si_phi) > M_PI) {
-          tpc_phi_wrap -= 2*M_PI;
-        } else {
-          tpc_phi_wrap += 2*M_PI;
-        }
-        phi_match = window_dphi.in_window(is_posQ, tpc_pt, tpc_phi_wrap, si_phi);
-      }
-      if (!phi_match)
-      {
-        continue;
-      }
+    params.q = seed->get_charge();
+  }
+  params.valid = true;
+  return params;
+}
 
-      if (Verbosity() > 3)
-      {
-        cout << " testing for a match for TPC track " << tpcid << " with pT " << _tracklet_tpc->get_pt()
-             << " and eta " << _tracklet_tpc->get_eta() << " with Si track " << siid << " with crossing " << _tracklet_si->get_crossing() << endl;
-        cout << " tpc_phi " << tpc_phi << " si_phi " << si_phi << " dphi " << tpc_phi - si_phi << " phi search " << _phi_search_win << " tpc_eta " << tpc_eta
-             << " si_eta " << si_eta << " deta " << tpc_eta - si_eta << " eta search " << _eta_search_win  << endl;
-        std::cout << "      tpc x " << tpc_pos.x() << " si x " << si_pos.x() << " tpc y " << tpc_pos.y() << " si y " << si_pos.y() << " tpc_z " << tpc_pos.z() << " si z " << si_pos.z() << std::endl;
-        std::cout << "      x search " << _x_search_win  << " y search " << _y_search_win << " z search " << _z_search_win << std::endl;
-      }
+bool PHSiliconTpcTrackMatching::matchSeeds(unsigned int tpcid, TrackSeed *tpc_seed, const SeedParameters &tpc,
+                                           unsigned int siid, TrackSeed *si_seed, const SeedParameters &si)
+{
+  const double tpc_phi = tpc.phi;
+  const double tpc_eta = tpc.eta;
+  const double tpc_pt = tpc.pt;
+  const auto &tpc_pos = tpc.pos;
+  const int tpc_q = tpc.q;
+  const double si_phi = si.phi;
+  const double si_eta = si.eta;
+  const auto &si_pos = si.pos;
+  const int si_q = si.q;
+  int si_crossing = si_seed->get_crossing();
+
+  bool is_posQ = (tpc_q>0.);
 
-      // got a match, add to the list
-      // These stubs are matched in eta, phi, x and y already
-      matched = true;
-      tpc_matches.insert(std::make_pair(tpcid, siid));
-      tpc_matched_set.insert(tpcid);
+  if(_test_windows)
+  {
+    float data[] = {
+      (float) m_event, (float) si_crossing,
+      (float) si_q, (float) si_phi, (float) si_eta, (float) si_pos.x(), (float) si_pos.y(), (float) si_pos.z(), (float) si.px, (float) si.py, (float) si.pz,
+      (float) tpc_q, (float) tpc_phi, (float) tpc_eta, (float) tpc_pos.x(), (float) tpc_pos.y(), (float) tpc_pos.z(), (float) tpc.px, (float) tpc.py, (float) tpc.pz,
+      (float) tpcid, (float) siid
+    };
+    _tree->Fill(data);
+  }
 
-      if (Verbosity() > 1)
-      {
-        cout << " found a match for TPC track " << tpcid << " with Si track " << siid << endl;
-        cout << "          tpc_phi " << tpc_phi << " si_phi " << si_phi << " phi_match " << phi_match
-             << " tpc_eta " << tpc_eta << " si_eta " << si_eta << " eta_match " << eta_match << endl;
-        std::cout << "      tpc x " << tpc_pos.x() << " si x " << si_pos.x() << " tpc y " << tpc_pos.y() << " si y " << si_pos.y() << " tpc_z " << tpc_pos.z() << " si z " << si_pos.z() << std::endl;
-      }
+  bool eta_match = false;
+  if (window_deta.in_window(is_posQ, tpc_pt, tpc_eta, si_eta))
+  {
+    eta_match = true;
+  }
+  else if (fabs(tpc_eta-si_eta) < _deltaeta_min)
+  {
+    eta_match = true;
+  }
+  if (!eta_match)
+  {
+    return false;
+  }
 
-      // temporary!
-      if (_test_windows && Verbosity() > 1)
-      {
-        cout << " Try_silicon: crossing" << si_crossing <<  "  pt " << tpc_pt << " tpc_phi " << tpc_phi << " si_phi " << si_phi << " dphi " << tpc_phi - si_phi <<  "   si_q" << si_q << "   tpc_q" << tpc_q
-             << " tpc_eta " << tpc_eta << " si_eta " << si_eta << " deta " << tpc_eta - si_eta << " tpc_x " << tpc_pos.x() << " tpc_y " << tpc_pos.y() << " tpc_z " << tpc_pos.z()
-             << " dx " << tpc_pos.x() - si_pos.x() << " dy " << tpc_pos.y() - si_pos.y() << " dz " << tpc_pos.z() - si_pos.z()
-			 << endl;
-      }
+  bool position_match = false;
+  if (window_dx.in_window(is_posQ, tpc_pt, tpc_pos.x(), si_pos.x())
+   && window_dy.in_window(is_posQ, tpc_pt, tpc_pos.y(), si_pos.y()))
+  {
+    position_match = true;
+  }
+  if (!position_match)
+  {
+    return false;
+  }
 
+  bool phi_match = false;
+  if (window_dphi.in_window(is_posQ, tpc_pt, tpc_phi, si_phi))
+  {
+    phi_match = true;
+    // if phi fails, account for case where |tpc_phi-si_phi|>PI
+  } else if (fabs(tpc_phi-si_phi)>M_PI) {
+    auto tpc_phi_wrap = tpc_phi;
+    if ((tpc_phi_wrap - si_phi) > M_PI) {
+      tpc_phi_wrap -= 2*M_PI;
+    } else {
+      tpc_phi_wrap += 2*M_PI;
     }
-    // if no match found, keep tpc seed for fitting
-    if (!matched)
-    {
-      if (Verbosity() > 1)
-      {
-        cout << "inserted unmatched tpc seed " << tpcid << endl;
-      }
-      tpc_unmatched_set.insert(tpcid);
-    }
+    phi_match = window_dphi.in_window(is_posQ, tpc_pt, tpc_phi_wrap, si_phi);
+  }
+  if (!phi_match)
+  {
+    return false;
   }
 
-  return;
+  if (Verbosity() > 3)
+  {
+    cout << " testing for a match for TPC track " << tpcid << " with pT " << tpc_seed->get_pt()
+         << " and eta " << tpc_seed->get_eta() << " with Si track " << siid << " with crossing " << si_seed->get_crossing() << endl;
+    cout << " tpc_phi " << tpc_phi << " si_phi " << si_phi << " dphi " << tpc_phi - si_phi << " phi search " << _phi_search_win << " tpc_eta " << tpc_eta
+         << " si_eta " << si_eta << " deta " << tpc_eta - si_eta << " eta search " << _eta_search_win  << endl;
+    std::cout << "      tpc x " << tpc_pos.x() << " si x " << si_pos.x() << " tpc y " << tpc_pos.y() << " si y " << si_pos.y() << " tpc_z " << tpc_pos.z() << " si z " << si_pos.z() << std::endl;
+    std::cout << "      x search " << _x_search_win  << " y search " << _y_search_win << " z search " << _z_search_win << std::endl;
+  }
+
+  // got a match
+  // These stubs are matched in eta, phi, x and y already
+  if (Verbosity() > 1)
+  {
+    cout << " found a match for TPC track " << tpcid << " with Si track " << siid << endl;
+    cout << "          tpc_phi " << tpc_phi << " si_phi " << si_phi << " phi_match " << phi_match
+         << " tpc_eta " << tpc_eta << " si_eta " << si_eta << " eta_match " << eta_match << endl;
+    std::cout << "      tpc x " << tpc_pos.x() << " si x " << si_pos.x() << " tpc y " << tpc_pos.y() << " si y " << si_pos.y() << " tpc_z " << tpc_pos.z() << " si z " << si_pos.z() << std::endl;
+  }
+
+  // temporary!
+  if (_test_windows && Verbosity() > 1)
+  {
+    cout << " Try_silicon: crossing" << si_crossing <<  "  pt " << tpc_pt << " tpc_phi " << tpc_phi << " si_phi " << si_phi << " dphi " << tpc_phi - si_phi <<  "   si_q" << si_q << "   tpc_q" << tpc_q
+         << " tpc_eta " << tpc_eta << " si_eta " << si_eta << " deta " << tpc_eta - si_eta << " tpc_x " << tpc_pos.x() << " tpc_y " << tpc_pos.y() << " tpc_z " << tpc_pos.z()
+         << " dx " << tpc_pos.x() - si_pos.x() << " dy " << tpc_pos.y() - si_pos.y() << " dz " << tpc_pos.z() - si_pos.z()
+         << endl;
+  }
+
+  return true;
 }
+
 void PHSiliconTpcTrackMatching::checkZMatches(
     std::multimap<unsigned int, unsigned int> &tpc_matches,
     std::multimap<unsigned int, unsigned int> &bad_map)
@@ -7,9 +7,12 @@
 #include <phparameter/PHParameterInterface.h>
 #include <tpc/TpcClusterZCrossingCorrection.h>
 #include <trackbase/ActsGeometry.h>
+#include <trackbase/TrkrPhiZGrid.h>
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 class PHCompositeNode;
 class TrackSeedContainer;
@@ -86,6 +89,9 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
 
     bool in_window(bool posQ, const double tpc_pt, const double tpc_X, const double si_X);
 
+    // range of tpc_X-si_X accepted by in_window, for candidate searches
+    std::pair<double, double> delta_range(bool posQ, const double tpc_pt);
+
     // initialize to fn_lo < deltaX < fn_hi for +Q, and fn_lo < deltaX < fn_hi for -Q
 
     void reset_fns() {
@@ -139,6 +145,8 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   void set_file_name(const std::string &name) { _file_name = name; }
   void set_pp_mode(const bool flag) { _pp_mode = flag; }
   void set_use_intt_crossing(const bool flag) { _use_intt_crossing = flag; }
+  // number of threads for the loop over TPC seeds, 0 to run it on the calling thread
+  void set_num_threads(unsigned int nthreads) { m_num_threads = nthreads; }
   void set_cluster_map_name(const std::string &name)
   {
     _cluster_map_name = name;
@@ -156,8 +164,26 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   void SetIteration(int iter) { _n_iteration = iter; }
 
  private:
+  // seed parameters used in the matching
+  struct SeedParameters
+  {
+    bool valid = false;
+    double phi = 0;
+    double eta = 0;
+    double pt = 0;
+    float px = 0;
+    float py = 0;
+    float pz = 0;
+    int q = 0;
+    Acts::Vector3 pos = Acts::Vector3::Zero();
+  };
+
   int GetNodes(PHCompositeNode *topNode);
 
+  SeedParameters getSeedParameters(TrackSeed *seed);
+  bool matchSeeds(unsigned int tpcid, TrackSeed *tpc_seed, const SeedParameters &tpc,
+                  unsigned int siid, TrackSeed *si_seed, const SeedParameters &si);
+
   void findEtaPhiMatches(std::set<unsigned int> &tpc_matched_set,
                          std::set<unsigned int> &tpc_unmatched_set,
                          std::multimap<unsigned int, unsigned int> &tpc_matches);
@@ -210,6 +236,12 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   bool _pp_mode = false;
   bool _use_intt_crossing = true;  // should always be true except for testing
 
+  unsigned int m_num_threads = 0;
+
+  // silicon seed parameters, and their (phi, eta) index
+  std::vector<SeedParameters> _silicon_seed_params;
+  TrkrPhiZGrid _silicon_grid;
+
   int _n_iteration = 0;
   std::string _track_map_name = "TpcTrackSeedContainer";
   std::string _silicon_track_map_name = "SiliconTrackSeedContainer";
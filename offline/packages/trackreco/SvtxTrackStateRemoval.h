@@ -21,6 +21,9 @@ class SvtxTrackStateRemoval : public SubsysReco
   int process_event(PHCompositeNode *topNode) override;
   int End(PHCompositeNode *topNode) override;
 
+  //! only works on the track map of the event and reads the micromegas geometry
+  bool ThreadSafe() const override { return true; }
+
  private:
 };
 